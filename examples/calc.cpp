@@ -177,6 +177,8 @@ void ButtonsContent(GridLayout& it) {
     // 基本属性
     it.setGridSize(5, 4);
     it.setSpace(0.5_em);
+    // 按键只在悬停或按下时改变，缓存整个键盘
+    it.setCacheMode(Block::CacheMode::Cached);
     // + 键
 #pragma region +
     XButton{
@@ -2,11 +2,17 @@
 
 #include <chrono>
 #include <functional>
-#include <list>
+#include <vector>
 #include <cmath>
-#include <mutex>
+#include <limits>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <utility>
 #include <variant>
+#include <memory>
 #include <GraceFt/Signal.hpp>
+#include <GraceFt/ThreadPool.h>
 
 namespace GFt {
     /// @defgroup 动画支持库
@@ -37,44 +43,78 @@ namespace GFt {
         Pause   ///< 暂停状态
     };
 
-    class AnimationAbstract;
-
-    /// @brief 动画状态基类
-    /// @ingroup 动画支持库
-    class AnimationState {
-    protected:
-        AnimationAbstract* owner_;
-
-    public:
-        AnimationState(AnimationAbstract* owner);
-        virtual ~AnimationState() = default;
-        virtual void update(const TimePoint& now) = 0;
-    };
+    template<typename Type>
+        requires Animatable<Type>
+    class Animation;
+    template<typename Type>
+    class AnimationPool;
+    template<typename Derived, typename Owner, typename Record>
+    class RecordPool;
+    template<typename Type>
+    class KeyframePool;
+    template<typename Type>
+    class SpringPool;
+    class AnimationGroup;
 
     /// @brief 动画抽象基类
+    /// @details 动画的状态以枚举保存，处于播放状态且已注册的动画由 AnimationManager
+    ///          按值类型集中存放在连续数组中统一更新
+    /// @details 状态切换与参数设置可以在任意线程上调用：在 UI 线程上立即生效，
+    ///          在其它线程上则将新的状态或参数随请求放入无锁队列，在下一帧开始时由 UI 线程写入动画对象，
+    ///          因此工作线程不会与正在更新动画的 UI 线程同时读写动画的成员；
+    ///          但同一动画对象不应同时在多个线程上被修改，除状态查询外的查询函数应在 UI 线程上调用，
+    ///          且动画对象应在 UI 线程上销毁
     /// @ingroup 动画支持库
     class AnimationAbstract {
         friend class AnimationManager;
-        friend class AnimationState;
-        friend class AnimationStop;
-        friend class AnimationPlay;
-        friend class AnimationPause;
         template<typename Type> requires Animatable<Type> friend class Animation;
+        template<typename Type> friend class AnimationPool;
+        template<typename Derived, typename Owner, typename Record> friend class RecordPool;
+        template<typename Type> friend class KeyframePool;
+        template<typename Type> friend class SpringPool;
+        friend class AnimationGroup;
+
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
 
         TimePoint start_time_;
-        std::chrono::milliseconds finished_;
+        std::chrono::steady_clock::duration finished_{};
         float duration_ms_;
         TransFunc trans_func_;
-        AnimationState* state_ = nullptr;
+        std::atomic<AnimationStateType> state_ = AnimationStateType::Stop;
+        std::atomic<bool> registered_ = false;
+        bool restart_ = false;      // 从停止状态开始播放，需要在 UI 线程上读取初始值
+        std::size_t slot_ = npos;   // 在所属动画池中的下标，未在池中时为 npos，仅在 UI 线程上访问
+        AnimationAbstract* parent_ = nullptr;   // 所属的动画组，由动画组统一调度
+
+        void changeState(AnimationStateType state);
+        void finish();
+        void refresh();
 
     protected:
         virtual void hadSetPlay() = 0;
-        virtual void playingUpdate(const TimePoint& now) = 0;
+        /// @brief 将动画加入所属的动画池
+        virtual void attach() = 0;
+        /// @brief 将动画移出所属的动画池
+        virtual void detach() = 0;
+        /// @brief 将动画参数的修改同步到所属的动画池
+        virtual void sync() = 0;
+        /// @brief 请求将动画的状态与参数同步到动画池
+        void requestRefresh();
+        /// @brief 请求在 UI 线程上修改动画，随后将动画的状态与参数同步到动画池
+        /// @param change 修改动画成员的函数，应以值捕获新的状态或参数
+        /// @details 在 UI 线程上调用时立即执行，否则随请求放入队列，在下一帧开始时执行
+        void requestChange(std::function<void()> change);
+        /// @brief 在 UI 线程上直接修改持续时间，供派生类的 requestChange() 使用
+        void assignDuration(float ms) { duration_ms_ = ms; }
+        /// @brief 子动画播放完毕时调用
+        /// @param child 播放完毕的子动画
+        virtual void childFinished([[maybe_unused]] AnimationAbstract* child) {}
+        /// @brief 从动画管理器中释放此动画，派生类须在析构函数中调用
+        void releaseSelf();
 
     public:
         AnimationAbstract(const TimePoint& start_time, float ms, const TransFunc& trans_func);
-        ~AnimationAbstract();
-        void update(const TimePoint& now);
+        virtual ~AnimationAbstract() = default;
 
         /// @brief 设置动画状态为停止
         void setStop();
@@ -82,6 +122,8 @@ namespace GFt {
         void setPlay();
         /// @brief 设置动画状态为暂停
         void setPause();
+        /// @brief 获取动画当前状态
+        AnimationStateType state() const;
         /// @brief 判断动画是否处于播放状态
         bool isPlaying() const;
         /// @brief 判断动画是否处于暂停状态
@@ -92,7 +134,7 @@ namespace GFt {
         /// @param trans_func 过渡变换函数
         void setTransFunc(const TransFunc& trans_func);
         /// @brief 设置动画持续时间
-        /// @param ms 持续时间（毫秒）
+        /// @param ms 持续时间（毫秒），不大于 0 时动画在开始后的首帧直接到达目标值
         void setDuration(float ms);
         /// @brief 获取动画的过渡变换函数
         /// @return 动画的过渡变换函数
@@ -107,28 +149,105 @@ namespace GFt {
         Signal<void> onUpdated;                 ///< 动画值更新信号
     };
 
-    /// @brief 停止状态
-    /// @ingroup 动画支持库
-    class AnimationStop : public AnimationState {
-    public:
-        AnimationStop(AnimationAbstract* owner);
-        void update(const TimePoint& now) override;
-    };
+    /// @cond IGNORE
+    /// @brief 过渡函数的批量计算描述，由 TransFunc 的实际类型识别得到
+    /// @details 不引用原函数对象，因此可以在工作线程上使用
+    struct EaseKernel {
+        enum class Kind { Linear, Bezier, SmoothInOut, Power, OverDamped, UnderDamped, Table, Custom };
+        Kind kind = Kind::Custom;
+        float param = 0.f;
+        std::shared_ptr<const std::vector<float>> table;
+        bool operator==(const EaseKernel&) const = default;
 
-    /// @brief 播放状态
-    /// @ingroup 动画支持库
-    class AnimationPlay : public AnimationState {
+        static EaseKernel of(const TransFunc& func);
+        /// @brief 批量计算，kind 为 Custom 时不做任何事
+        void evaluate(const float* x, float* y, std::size_t count) const;
+    };
+    /// @brief 动画池中每个动画在本帧的计算结果
+    namespace AnimationStatus {
+        enum : unsigned char {
+            Running,    ///< 正在播放
+            Done,       ///< 本帧播放完毕
+            Waiting,    ///< 尚未到开始时刻(动画组中延后开始的子动画)，不调用 setter
+            Empty,      ///< 没有可用的值，不调用 setter 而直接结束
+        };
+    }
+    /// @details 构造时向动画管理器登记，每帧按登记的先后顺序更新
+    class AnimationPoolBase {
     public:
-        AnimationPlay(AnimationAbstract* owner);
-        void update(const TimePoint& now) override;
+        AnimationPoolBase();
+        virtual ~AnimationPoolBase() = default;
+        /// @param next 若不为空，则在更新结束后于工作线程上预先计算该时刻的动画值
+        virtual void update(const TimePoint& now, const TimePoint* next) = 0;
+        /// @brief 判断池中是否没有播放中的动画
+        virtual bool empty() const = 0;
     };
+    /// @endcond
 
-    /// @brief 暂停状态
+    /// @brief 动画管理器
+    /// @details 播放中的动画按值类型分组，每种类型的动画参数以结构数组的形式连续存放，
+    ///          每帧先在紧凑的循环中计算所有动画的当前值，再统一调用 setter 与发送信号
+    /// @details 动画池只在 UI 线程(即调用 updateAll() 的线程)上被访问，其它线程上的注册、注销
+    ///          与状态切换会被放入无锁的多生产者单消费者队列，在每次更新开始时统一应用
+    /// @details 开启异步计算后，每帧更新结束时会在线程池中预先计算下一帧(按上一帧的间隔估计)的
+    ///          动画值并写入后备缓冲区，下一帧若时刻与估计相差不超过半帧则直接交换缓冲区使用，
+    ///          否则在 UI 线程上重新计算
+    /// @details 有动画播放时，每帧更新后请求下一帧；setter 通过块对象的属性或控件的访问器
+    ///          修改外观时会自动标记重绘，修改其它绘制数据时应调用 Block::markDirty()
+    /// @details 此类是线程安全的
     /// @ingroup 动画支持库
-    class AnimationPause : public AnimationState {
+    class AnimationManager {
+        friend class AnimationPoolBase;
+        friend class AnimationAbstract;
+        struct Command {
+            AnimationAbstract* animation;
+            std::function<void()> change;   // 在 UI 线程上对动画的修改，可以为空
+            Command* next;
+        };
+        std::vector<AnimationPoolBase*> pools_;
+        std::atomic<Command*> commands_ = nullptr;
+        std::atomic<std::thread::id> uiThread_;
+        std::atomic<bool> async_ = false;
+        TimePoint lastUpdate_{};
+
+        AnimationManager();
+        AnimationManager(const AnimationManager&) = delete;
+        AnimationManager(AnimationManager&&) = delete;
+        AnimationManager& operator=(const AnimationManager&) = delete;
+        AnimationManager& operator=(AnimationManager&&) = delete;
+
+        bool onUIThread() const;
+        void request(AnimationAbstract* animation, std::function<void()> change = {});
+        void applyCommands(const AnimationAbstract* skip = nullptr);
+        void release(AnimationAbstract* animation);
     public:
-        AnimationPause(AnimationAbstract* owner);
-        void update(const TimePoint& now) override;
+        ~AnimationManager();
+        /// @cond IGNORE
+        template<typename Pool>
+        Pool& pool();
+        /// @endcond
+
+        /// @brief 注册动画对象
+        /// @param animation 动画对象
+        /// @details 只有注册过的动画对象才会在播放时被更新
+        void registerAnimation(AnimationAbstract* animation);
+        /// @brief 注销动画对象
+        /// @param animation 动画对象
+        void unregisterAnimation(AnimationAbstract* animation);
+        /// @brief 更新所有动画对象
+        /// @param now 当前时间
+        /// @note 调用此函数的线程被视为 UI 线程；首次调用之前，首次获取管理器实例的线程被视为 UI 线程
+        void updateAll(const TimePoint& now);
+        /// @brief 设置是否在工作线程上异步计算动画值
+        /// @param enable 是否开启
+        /// @note 开启后自定义过渡函数会在工作线程上被调用，因此必须是线程安全的；
+        ///       setter 与信号仍在 UI 线程上被调用
+        void setAsyncEvaluation(bool enable);
+        /// @brief 判断是否开启了异步计算
+        bool isAsyncEvaluation() const;
+
+        /// @brief 获取动画管理器实例
+        static AnimationManager& getInstance();
     };
 
     /// @brief 动画参数结构体
@@ -149,78 +268,243 @@ namespace GFt {
     template<typename Type>
         requires Animatable<Type>
     class Animation : public AnimationAbstract {
+        friend class AnimationPool<Type>;
         Type start_value_;
         Type end_value_;
 
         Getter<Type> getter_;
         Setter<Type> setter_;
+
+        void assignInitial(const Initial<Type>& initial) {
+            auto ptr = std::get_if<Type>(&initial);
+            ptr ? start_value_ = *ptr, getter_ = Getter<Type>()
+                : getter_ = std::get<Getter<Type>>(initial);
+        }
     protected:
+        /// @note 总是在 UI 线程上被调用
         void hadSetPlay() override {
             if (getter_)
                 start_value_ = getter_();
         }
-        void playingUpdate(const TimePoint& now) override {
-            using namespace std::chrono;
-            finished_ = duration_cast<milliseconds>(now - start_time_);
-            auto elapsed_ns = duration_cast<nanoseconds>(finished_).count();
-            auto progress = elapsed_ns * 1e-6f / duration_ms_;
-            if (progress > 1.f) {
-                setStop();
-                onFinished();
-                start_time_ = now;
-                return;
-            }
-            setter_(start_value_ + (end_value_ - start_value_) * trans_func_(progress));
-            onUpdated();
-        }
+        void attach() override { AnimationManager::getInstance().pool<AnimationPool<Type>>().attach(this); }
+        void detach() override { AnimationManager::getInstance().pool<AnimationPool<Type>>().detach(this); }
+        void sync() override { AnimationManager::getInstance().pool<AnimationPool<Type>>().sync(this); }
     public:
         /// @brief 构造函数
         /// @param params 动画参数结构体
         Animation(const AnimationParams<Type>& params)
-            : setter_(params.setter), end_value_(params.target),
-            AnimationAbstract(TimePoint(), params.duration, params.trans_func) {
-            setInitial(params.initial);
+            : AnimationAbstract(TimePoint(), params.duration, params.trans_func),
+            end_value_(params.target), setter_(params.setter) {
+            assignInitial(params.initial);
         }
+        ~Animation() { releaseSelf(); }
         /// @brief 设置动画初始化值
         /// @param initial 动画初始值，可以是值或 getter 方法
         /// @details 若为 getter 方法则在动画开始时调用并作为初始值
         ///          若为值则直接作为初始值
         void setInitial(const Initial<Type>& initial) {
-            auto ptr = std::get_if<Type>(&initial);
-            ptr ? start_value_ = *ptr, getter_ = Getter<Type>()
-                : getter_ = std::get<Getter<Type>>(initial);
+            requestChange([this, initial] { assignInitial(initial); });
         }
         /// @brief 设置动画目标值
         /// @param target 动画目标值
-        void setTarget(const Type& target) { end_value_ = target; }
+        void setTarget(const Type& target) {
+            requestChange([this, target] { end_value_ = target; });
+        }
     };
-    /// @brief 动画管理器
-    /// @details 此类是线程安全的
-    /// @ingroup 动画支持库
-    class AnimationManager {
-        std::list<AnimationAbstract*> animations_;
-        std::mutex mutex_;
 
-        AnimationManager() = default;
-        AnimationManager(const AnimationManager&) = delete;
-        AnimationManager(AnimationManager&&) = delete;
-        AnimationManager& operator=(const AnimationManager&) = delete;
-        AnimationManager& operator=(AnimationManager&&) = delete;
+    /// @cond IGNORE
+    /// @brief 同一值类型的播放中动画的连续存储
+    /// @details 计算所需的参数以结构数组存放，移除时与末尾元素交换；
+    ///          更新期间的移除只将所有者置空，待更新结束后再压缩
+    /// @details 参数数组只在 UI 线程上修改，修改前会等待正在进行的异步计算结束并作废其结果，
+    ///          异步计算只读取参数数组，不访问动画对象
+    template<typename Type>
+    class AnimationPool : public AnimationPoolBase {
+        using Clock = std::chrono::steady_clock;
+        std::vector<Animation<Type>*> owners_;
+        std::vector<TimePoint> starts_;
+        std::vector<float> rates_;      // 1 / 持续时间(时钟周期数)
+        std::vector<EaseKernel> kernels_;
+        std::vector<TransFunc> customs_;    // 仅对无法批量计算的过渡函数保存副本
+        std::vector<Type> from_;
+        std::vector<Type> to_;
+        std::vector<Type> values_;
+        std::vector<unsigned char> done_;   // 取值为 AnimationStatus
+        std::vector<Type> backValues_;
+        std::vector<unsigned char> backDone_;
+        std::vector<float> progress_;
+        std::vector<float> eased_;
+        std::future<void> job_;
+        bool jobValid_ = false;
+        TimePoint jobTime_;
+        Clock::duration jobTolerance_{};
+        bool updating_ = false;
+        bool dirty_ = false;
+
+        /// @brief 等待异步计算结束
+        /// @return 后备缓冲区中的结果是否仍然有效
+        bool join() {
+            if (job_.valid())
+                job_.get();
+            return std::exchange(jobValid_, false);
+        }
+        void compute(const TimePoint& now, std::vector<Type>& values, std::vector<unsigned char>& done) {
+            auto count = starts_.size();
+            values.resize(count);
+            done.resize(count);
+            progress_.resize(count);
+            eased_.resize(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                auto elapsed = (now - starts_[i]).count();
+                // 持续时间不大于 0 的动画(速率为无穷大)一开始即完成，避免 0 * inf 得到 NaN
+                auto progress = elapsed >= 0 && std::isinf(rates_[i]) ? 1.f : elapsed * rates_[i];
+                done[i] = progress >= 1.f ? AnimationStatus::Done
+                    : progress < 0.f ? AnimationStatus::Waiting : AnimationStatus::Running;
+                progress_[i] = progress < 0.f ? 0.f : progress < 1.f ? progress : 1.f;
+            }
+            // 过渡函数相同的相邻动画成批计算
+            for (std::size_t i = 0, j = 0; i < count; i = j) {
+                for (j = i + 1; j < count && kernels_[j] == kernels_[i]; ++j);
+                if (kernels_[i].kind != EaseKernel::Kind::Custom)
+                    kernels_[i].evaluate(&progress_[i], &eased_[i], j - i);
+                else for (auto k = i; k < j; ++k)
+                    eased_[k] = customs_[k](progress_[k]);
+            }
+            for (std::size_t i = 0; i < count; ++i)
+                values[i] = from_[i] + (to_[i] - from_[i]) * eased_[i];
+        }
+        void load(std::size_t i, Animation<Type>* animation) {
+            starts_[i] = animation->start_time_;
+            using Period = Clock::period;
+            constexpr float ticks_per_ms = 1e-3f * Period::den / Period::num;
+            rates_[i] = animation->duration_ms_ > 0.f ? 1.f / (animation->duration_ms_ * ticks_per_ms)
+                : std::numeric_limits<float>::infinity();
+            kernels_[i] = EaseKernel::of(animation->trans_func_);
+            customs_[i] = kernels_[i].kind == EaseKernel::Kind::Custom ? animation->trans_func_ : TransFunc();
+            from_[i] = animation->start_value_;
+            to_[i] = animation->end_value_;
+        }
+        void moveSlot(std::size_t from, std::size_t to) {
+            owners_[to] = owners_[from];
+            starts_[to] = starts_[from];
+            rates_[to] = rates_[from];
+            kernels_[to] = std::move(kernels_[from]);
+            customs_[to] = std::move(customs_[from]);
+            from_[to] = std::move(from_[from]);
+            to_[to] = std::move(to_[from]);
+            values_[to] = std::move(values_[from]);
+            if (owners_[to])
+                owners_[to]->slot_ = to;
+        }
+        void popBack() {
+            owners_.pop_back();
+            starts_.pop_back();
+            rates_.pop_back();
+            kernels_.pop_back();
+            customs_.pop_back();
+            from_.pop_back();
+            to_.pop_back();
+            values_.pop_back();
+        }
+        void compact() {
+            for (std::size_t i = 0; i < owners_.size();) {
+                if (owners_[i]) {
+                    ++i;
+                    continue;
+                }
+                if (i + 1 != owners_.size())
+                    moveSlot(owners_.size() - 1, i);
+                popBack();
+            }
+            dirty_ = false;
+        }
+
     public:
-        /// @brief 注册动画对象
-        /// @param animation 动画对象
-        void registerAnimation(AnimationAbstract* animation);
-        /// @brief 注销动画对象
-        /// @param animation 动画对象
-        void unregisterAnimation(AnimationAbstract* animation);
-        /// @brief 更新所有动画对象
-        /// @param now 当前时间
-        void updateAll(const TimePoint& now);
+        ~AnimationPool() { join(); }
 
-        /// @brief 获取动画管理器实例
-        static AnimationManager& getInstance();
+        void attach(Animation<Type>* animation) {
+            if (animation->slot_ != AnimationAbstract::npos)
+                return;
+            join();
+            animation->slot_ = owners_.size();
+            owners_.push_back(animation);
+            starts_.emplace_back();
+            rates_.emplace_back();
+            kernels_.emplace_back();
+            customs_.emplace_back();
+            from_.push_back(animation->start_value_);
+            to_.push_back(animation->end_value_);
+            values_.push_back(animation->start_value_);
+            load(animation->slot_, animation);
+        }
+        void detach(Animation<Type>* animation) {
+            auto i = animation->slot_;
+            if (i == AnimationAbstract::npos)
+                return;
+            join();
+            animation->slot_ = AnimationAbstract::npos;
+            owners_[i] = nullptr;
+            if (updating_) {
+                dirty_ = true;
+                return;
+            }
+            if (i + 1 != owners_.size())
+                moveSlot(owners_.size() - 1, i);
+            popBack();
+        }
+        void sync(Animation<Type>* animation) {
+            if (animation->slot_ == AnimationAbstract::npos)
+                return;
+            join();
+            load(animation->slot_, animation);
+        }
+        bool empty() const override { return owners_.empty(); }
+        void update(const TimePoint& now, const TimePoint* next) override {
+            // 第一遍：只做数值计算，或直接使用预先计算好的结果
+            auto jobTime = jobTime_;
+            auto tolerance = jobTolerance_;
+            if (join() && now - jobTime <= tolerance && jobTime - now <= tolerance) {
+                values_.swap(backValues_);
+                done_.swap(backDone_);
+            }
+            else
+                compute(now, values_, done_);
+            // 第二遍：调用 setter 与发送信号，回调中可能修改动画池
+            auto count = owners_.size();
+            updating_ = true;
+            for (std::size_t i = 0; i < count; ++i) {
+                auto animation = owners_[i];
+                if (!animation || done_[i] == AnimationStatus::Waiting)
+                    continue;
+                // setter 中可能向动画池中加入动画而使数组重新分配，因此传入副本
+                if (animation->setter_)
+                    animation->setter_(Type(values_[i]));
+                if (owners_[i] == animation && !animation->onUpdated.empty())
+                    animation->onUpdated();
+                if (owners_[i] == animation && done_[i] == AnimationStatus::Done)
+                    animation->finish();
+            }
+            updating_ = false;
+            if (dirty_)
+                compact();
+            if (next && !owners_.empty()) {
+                jobTime_ = *next;
+                jobTolerance_ = (*next - now) / 2;
+                jobValid_ = true;
+                job_ = ThreadPool::getInstance().submit([this, time = *next] {
+                    compute(time, backValues_, backDone_);
+                    });
+            }
+        }
     };
 
+    template<typename Pool>
+    Pool& AnimationManager::pool() {
+        static Pool instance;
+        return instance;
+    }
+    /// @endcond
+
     /// @brief 过渡函数集合
     /// @details 此命名空间包含了一些常用的过渡函数，并给出了它们的曲线图像
     /// @note 自定义过渡函数要求：
@@ -231,14 +515,15 @@ namespace GFt {
     namespace TransFuncs {
         /// @brief 线性过渡函数(默认函数)
         constexpr float linear(float x) { return x; }
+        /// @brief 幂函数
+        struct Power {
+            float power;    ///< 幂指数
+            float operator()(float k) const { return ::std::pow(k, power); }
+        };
         /// @brief 幂函数生成器
         /// @param power 幂指数
         /// @return 幂函数
-        constexpr auto power(float power) {
-            return [power](float k)->float {
-                return ::std::pow(k, power);
-                };
-        }
+        constexpr Power power(float power) { return Power{ power }; }
         /// @brief 贝塞尔过渡
         constexpr float bezier(float x) { return 3.f * x * x - 2.f * x * x * x; }
         /// @brief 柔性过渡
@@ -247,19 +532,75 @@ namespace GFt {
             auto y = x * tao;
             return (y - ::std::sin(y)) / tao;
         }
+        /// @brief 过阻尼衰减函数
+        struct OverDamped {
+            float damping;  ///< 等效阻尼因数
+            float operator()(float x) const {
+                return (1.f - ::std::exp(-damping * x * x)) * (1 / (1 - ::std::exp(-damping)));
+            }
+        };
         /// @brief 过阻尼衰减函数生成器
         /// @param damping 等效阻尼因数，值越大越快地达到目标值，此值不能为零
         /// @return 过阻尼衰减函数
-        constexpr auto overDamped(float damping) {
-            return [damping](float x)-> float {
-                return (1.f - ::std::exp(-damping * x * x)) * (1 / (1 - ::std::exp(-damping)));
-                };
-        }
+        constexpr OverDamped overDamped(float damping) { return OverDamped{ damping }; }
+        /// @brief 欠阻尼衰减函数
+        struct UnderDamped {
+            float damping;  ///< 等效阻尼因数
+            float operator()(float x) const { return 1.f - (1.f - x) * ::std::cos(x * damping); }
+        };
         /// @brief 欠阻尼衰减函数生成器
         /// @param damping 等效阻尼因数，值越大超调震荡频率越高
         /// @return 欠阻尼衰减函数
-        constexpr auto underDamped(float damping) {
-            return [damping](float x)-> float { return 1.f - (1.f - x) * ::std::cos(x * damping); };
-        }
+        constexpr UnderDamped underDamped(float damping) { return UnderDamped{ damping }; }
+
+        /// @brief 查找表近似的过渡函数
+        /// @details 在 [0, 1] 上均匀采样原函数并线性插值，采样点数从 16 开始倍增，
+        ///          直到在每个区间内的检验点上误差都不超过给定的误差上限
+        /// @details 适合代替计算代价较高的自定义过渡函数；查找表的数据在副本之间共享，
+        ///          因此可以廉价地复制到 TransFunc 中
+        /// @note 误差是在检验点上测得的估计值，对于在单个采样区间内剧烈变化的函数可能偏小
+        /// @code
+        /// TransFunc ease = TransFuncs::LookupTable(myExpensiveCurve, 1e-4f);
+        /// @endcode
+        class LookupTable {
+            friend struct ::GFt::EaseKernel;
+            std::shared_ptr<const std::vector<float>> samples_;
+            float maxError_ = 0.f;
+
+            static float lookup(const std::vector<float>& samples, float x) {
+                auto n = samples.size() - 1;
+                auto t = (x < 0.f ? 0.f : x > 1.f ? 1.f : x) * n;
+                auto i = static_cast<std::size_t>(t);
+                i = i < n ? i : n - 1;
+                return samples[i] + (samples[i + 1] - samples[i]) * (t - i);
+            }
+
+        public:
+            /// @brief 构造函数
+            /// @param func 原过渡函数
+            /// @param max_error 允许的最大绝对误差
+            /// @param max_size 最大采样区间数，达到此数量时即使未满足误差要求也停止细分
+            LookupTable(const TransFunc& func, float max_error = 1e-4f, std::size_t max_size = 1 << 16);
+            /// @brief 计算过渡函数值
+            /// @details 超出 [0, 1] 的自变量会被截断到区间端点
+            float operator()(float x) const { return lookup(*samples_, x); }
+            /// @brief 批量计算过渡函数值
+            void operator()(const float* x, float* y, std::size_t count) const;
+            /// @brief 获取实测的最大绝对误差
+            float maxError() const;
+            /// @brief 获取采样区间数
+            std::size_t size() const;
+        };
+
+        /// @brief 批量计算过渡函数值
+        /// @param func 过渡函数
+        /// @param x 自变量数组
+        /// @param y 结果数组，可以与 x 相同
+        /// @param count 元素数量
+        /// @details 对内置过渡函数及 LookupTable 使用不调用标准数学库、可被编译器自动向量化的实现，
+        ///          其中三角、指数与幂函数采用多项式近似，在 [0, 1] 上的绝对误差小于 1e-5；
+        ///          其它函数逐个调用
+        /// @note 是否被向量化取决于编译器的优化级别，GCC 下通常需要 -O3
+        void batch(const TransFunc& func, const float* x, float* y, std::size_t count);
     }
 }
\ No newline at end of file
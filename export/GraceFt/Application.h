@@ -2,14 +2,32 @@
 
 #include <GraceFt/Window.h>
 #include <filesystem>
+#include <functional>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <atomic>
+#include <condition_variable>
 
 namespace GFt {
     /// @class Application
     /// @brief 应用程序类
     /// @details 该类封装了程序的主要逻辑, 包括渲染, 事件处理, 帧率控制等
+    /// @details 在按需模式下，主循环只在有输入、到期的计划事件、播放中的动画或重绘请求时处理一帧，
+    ///          且只在有对象需要重绘时才重绘；没有任何待处理的工作时线程休眠，直到被唤醒
+    /// @see setLoopMode()
     /// @ingroup 基础UI封装库
     class Application {
-        void render(Window* window, bool cilpO);
+    public:
+        /// @brief 主循环模式
+        enum class LoopMode {
+            Continuous, ///< 每一帧都处理事件并重绘(默认)
+            OnDemand,   ///< 仅在需要时处理事件与重绘，空闲时休眠
+        };
+
+    private:
+        using Clock = std::chrono::steady_clock;
+        static void render(Window* window, bool cilpO, bool full);
         void handleEvents(Window* window);
         static Window* root_;
         static double FPS_;
@@ -18,6 +36,17 @@ namespace GFt {
         static float eventTime_;
 
         static bool shouldClose_;
+
+        static std::mutex postMutex_;
+        static std::vector<std::function<void()>> posted_;
+        static void runPosted();
+
+        static LoopMode loopMode_;
+        static std::atomic<bool> renderRequested_;
+        static std::mutex wakeMutex_;
+        static std::condition_variable wakeCond_;
+        static Clock::time_point nextFrame_;    // 下一帧最迟的开始时刻，为 max 时表示没有待处理的工作
+        static void waitForFrame();
     private:
         Application(const Application&) = delete;
         Application& operator=(const Application&) = delete;
@@ -93,6 +122,48 @@ namespace GFt {
         /// @details 此函数是惰性求值函数
         /// @return 可执行文件所在的路径，若失败则返回空路径
         static std::filesystem::path localPath();
+        /// @brief 投递任务到 UI 线程
+        /// @param task 要执行的任务
+        /// @details 任务会在下一帧事件处理之前(onEventCall 信号触发之后)按投递顺序执行，
+        ///          可在任务中安全地访问 Block 对象树
+        /// @note 此函数是线程安全的，通常用于将工作线程的计算结果交回 UI 线程
+        /// @see ThreadPool::submitThen()
+        static void post(std::function<void()> task);
+        /// @brief 设置主循环模式
+        /// @param mode 主循环模式
+        /// @details 按需模式下 onEventCall 信号只在被唤醒的帧中触发，每帧都需要执行的工作
+        ///          应在执行时调用 requestFrame() 以保证下一帧被处理
+        /// @note 计划事件、协程、动画与 post() 投递的任务会自动请求所需的帧，
+        ///       块对象的属性改变会自动标记重绘
+        static void setLoopMode(LoopMode mode);
+        /// @brief 获取主循环模式
+        static LoopMode getLoopMode();
+        /// @brief 设置绘制对象树时使用的光栅化方式
+        /// @param mode 光栅化方式
+        /// @details 为 Graphics::RasterMode::Tiled 时，各对象的纯色填充在遍历对象树时被记录，
+        ///          并在呈现前按屏幕分块由全局线程池并行绘制
+        /// @see Graphics::setRasterMode()
+        static void setRasterMode(Graphics::RasterMode mode);
+        /// @brief 获取绘制对象树时使用的光栅化方式
+        static Graphics::RasterMode getRasterMode();
+        /// @brief 请求尽快处理下一帧
+        /// @details 在按需模式下唤醒休眠中的主循环；此函数是线程安全的
+        static void requestFrame();
+        /// @brief 请求最迟在指定时刻处理一帧
+        /// @param at 时刻
+        /// @details 多次请求时以最早的时刻为准；此函数是线程安全的
+        static void requestFrame(Clock::time_point at);
+        /// @brief 立即绘制一帧
+        /// @param full 是否重绘整个窗口，为 false 时只重绘被标记的对象所在的区域
+        /// @param cilpO 是否启用绘图裁剪优化
+        /// @details 主循环会自动绘制，此函数用于在主循环之外(如测试与基准程序中)驱动绘制
+        /// @note 仅能在 UI 线程上调用
+        /// @see Block::markDirty()
+        static void renderFrame(bool full = false, bool cilpO = true);
+        /// @brief 请求在下一帧重绘整个窗口
+        /// @details 此函数是线程安全的
+        /// @see Block::update()
+        static void requestRender();
 
         static Signal<void> onRenderCall;   ///< 每一帧渲染(之前)时触发此信号
         static Signal<void> onEventCall;    ///< 每一帧事件处理(之前)时触发此信号
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <GraceFt/Event.h>
+#include <GraceFt/Color.h>
+#include <GraceFt/PixelMap.h>
+#include <GraceFt/DamageRegion.h>
+
+namespace GFt {
+    /// @brief 后端产生的鼠标消息
+    /// @ingroup 基础UI封装库
+    struct MouseMessage {
+        /// @brief 鼠标消息类型
+        enum class Type {
+            Move,       ///< 移动
+            Press,      ///< 按键按下
+            Release,    ///< 按键释放
+            Wheel,      ///< 滚轮滚动
+        };
+        Type type;                                  ///< 消息类型
+        iPoint position;                            ///< 鼠标位置，以窗口客户区左上角为原点
+        MouseButton button = MouseButton::Unknown;  ///< 按下或释放的按键
+        MouseWheel wheel = MouseWheel::None;        ///< 滚轮方向
+    };
+    /// @brief 后端产生的键盘消息
+    /// @ingroup 基础UI封装库
+    struct KeyMessage {
+        /// @brief 键盘消息类型
+        enum class Type {
+            Press,      ///< 按键按下
+            Release,    ///< 按键释放
+            Char,       ///< 文本输入
+        };
+        Type type;          ///< 消息类型
+        int key;            ///< 按键码，类型为 Char 时为输入的字符
+        bool shift = false; ///< Shift 键是否按下
+        bool ctrl = false;  ///< Ctrl 键是否按下
+    };
+
+    /// @class Backend
+    /// @brief 平台后端接口
+    /// @details 窗口、输入、屏幕参数与帧的呈现均通过当前后端完成，Window、Application
+    ///          与设备无关单位不直接调用平台接口
+    /// @details 默认使用基于 EGE 的窗口后端；测试或性能测试可以在创建窗口之前安装
+    ///          HeadlessBackend，以在不创建窗口的情况下运行整个应用程序
+    /// @note 绘图仍由 Graphics 完成，后端只提供屏幕对应的绘图目标
+    /// @ingroup 基础UI封装库
+    class Backend {
+    public:
+        /// @brief 窗口创建选项
+        enum WindowFlags {
+            Hidden = 0x1,   ///< 创建后不显示
+            NoBorder = 0x2, ///< 无边框
+            TopMost = 0x4,  ///< 置顶
+        };
+
+        virtual ~Backend() = default;
+
+        /// @brief 获取当前后端
+        /// @details 未安装后端时使用基于 EGE 的窗口后端，以 GFT_HEADLESS 构建时使用 HeadlessBackend
+        static Backend& instance();
+        /// @brief 安装后端
+        /// @param backend 新的后端，为 nullptr 时恢复为默认后端
+        /// @note 应在创建窗口之前调用，窗口创建后替换后端的行为是未定义的
+        static void install(std::unique_ptr<Backend> backend);
+
+        /// @brief 创建窗口
+        /// @param size 客户区大小
+        /// @param flags 创建选项，由 WindowFlags 组合而成
+        /// @return 是否创建成功
+        virtual bool createWindow(const iSize& size, int flags) = 0;
+        /// @brief 关闭窗口
+        virtual void closeWindow() = 0;
+        /// @brief 窗口是否仍在运行
+        virtual bool isRunning() = 0;
+        /// @brief 主循环开始前调用
+        virtual void beginLoop() {}
+        /// @brief 等待至下一帧，用于帧率控制
+        /// @param fps 目标帧率
+        virtual void waitFrame(double fps) = 0;
+
+        /// @brief 显示或隐藏窗口
+        virtual void showWindow(bool show) = 0;
+        /// @brief 改变窗口客户区的大小
+        virtual void resizeWindow(const iSize& size) = 0;
+        /// @brief 将窗口移动到屏幕上的指定位置
+        virtual void moveWindow(const iPoint& pos) = 0;
+        /// @brief 最小化窗口
+        virtual void minimizeWindow() = 0;
+        /// @brief 设置窗口标题
+        virtual void setWindowTitle(const std::wstring& title) = 0;
+        /// @brief 设置窗口是否置顶
+        virtual void setWindowTopMost(bool topMost) = 0;
+        /// @brief 设置窗口是否无边框
+        virtual void setWindowFrameless(bool frameless) = 0;
+        /// @brief 设置窗口的不透明度
+        virtual void setWindowAlpha(float alpha) = 0;
+        /// @brief 设置窗口的透明色，为空时取消
+        virtual void setWindowColorKey(const std::optional<Color>& color) = 0;
+        /// @brief 窗口(含边框)在屏幕上的区域
+        virtual iRect windowRect() = 0;
+        /// @brief 窗口客户区在屏幕上的区域
+        virtual iRect clientRect() = 0;
+
+        /// @brief 屏幕大小
+        virtual iSize screenSize() = 0;
+        /// @brief 屏幕工作区(除去任务栏等)
+        virtual iRect workArea() = 0;
+        /// @brief 系统 DPI
+        virtual int dpi() = 0;
+        /// @brief 鼠标在屏幕上的位置
+        virtual iPoint cursorPosition() = 0;
+        /// @brief 显示或隐藏鼠标
+        /// @return 调用之前鼠标是否显示
+        virtual bool showCursor(bool show) = 0;
+
+        /// @brief 取出一条鼠标消息
+        /// @param msg 取出的消息
+        /// @return 没有待处理的消息时返回 false
+        virtual bool pollMouse(MouseMessage& msg) = 0;
+        /// @brief 取出一条键盘消息
+        /// @param msg 取出的消息
+        /// @return 没有待处理的消息时返回 false
+        virtual bool pollKey(KeyMessage& msg) = 0;
+        /// @brief 是否有待处理的鼠标消息
+        virtual bool hasMouse() = 0;
+        /// @brief 是否有待处理的键盘消息
+        virtual bool hasKey() = 0;
+
+        /// @brief 屏幕对应的绘图目标
+        /// @return 为 nullptr 时绘制到窗口
+        virtual PixelMap* screen() = 0;
+        /// @brief 以背景色清除整个屏幕
+        virtual void clear() = 0;
+        /// @brief 以背景色清除屏幕的指定区域
+        virtual void clear(const iRect& rect) = 0;
+        /// @brief 将之后对屏幕的绘制限制在重绘区域内
+        /// @details 设置视口会重置裁剪区域，因此应在设置视口之后调用；
+        ///          软件光栅化的绘制另由 Graphics::setClipRegion() 裁剪，只以软件绘制的后端无需实现
+        /// @param damage 重绘区域，以屏幕左上角为原点
+        virtual void clipToDamage([[maybe_unused]] const DamageRegion& damage) {}
+        /// @brief 呈现一帧
+        /// @param damage 本帧重绘的区域，为 nullptr 时为整个屏幕
+        virtual void present(const DamageRegion* damage = nullptr) = 0;
+    };
+}
@@ -1,11 +1,15 @@
 #pragma once
 
-#include <set>
+#include <vector>
+#include <cstdint>
+#include <memory>
 
 #include <GraceFt/GraphInterface.h>
 #include <GraceFt/EventMonitor.h>
 #include <GraceFt/Event.h>
 #include <GraceFt/Signal.hpp>
+#include <GraceFt/DamageRegion.h>
+#include <GraceFt/PixelMap.h>
 
 namespace GFt {
     /// @class Block
@@ -15,17 +19,54 @@ namespace GFt {
     ///          同时也负责视图重绘
     /// @ingroup 基础UI封装库
     class Block : public GraphInterface, public EventMonitor {
-        struct CompareByZIndex {
-            bool operator()(const Block* a, const Block* b) const;
+    public:
+        /// @brief 绘制缓存模式
+        enum class CacheMode {
+            None,   ///< 每次绘制时重新绘制整棵子树(默认)
+            Cached, ///< 将整棵子树绘制到离屏位图中，内容未改变时直接复制位图
         };
+
+    private:
         int zIndex_;
         Block* parent_;
-        std::multiset<Block*, CompareByZIndex> children_;
-        bool sortChildren_ = true;
+        // 按层级从高到低、同层级按加入的先后排列，正序为输入事件的捕获顺序，逆序为绘制顺序
+        std::vector<Block*> children_;
+        std::size_t childIndex_ = 0;        // 在父对象的 children_ 中的下标
+        std::uint64_t childOrder_ = 0;      // 加入父对象的次序
+        std::uint64_t nextChildOrder_ = 0;
         bool hide_ = false;
+        bool dirty_ = true;     // 自身或子对象需要重绘
+        bool damaged_ = true;   // 自身需要重绘
+        iRect painted_;         // 上次绘制时在窗口中占据的区域
+        std::vector<iRect> damage_; // 被移出的子对象留下的区域
+        mutable iPoint rootOffset_;         // 相对于根对象左上角的位置
+        mutable bool rootOffsetValid_ = false;
+        struct HitGrid;
+        mutable std::unique_ptr<HitGrid> hitGrid_; // 子对象较多时用于命中测试的均匀网格
+        mutable bool hitGridValid_ = false;
+        CacheMode cacheMode_ = CacheMode::None;
+        bool cacheValid_ = false;
+        std::unique_ptr<PixelMap> cache_;
 
         friend class Application;
-        void handleOnDraw(const iPoint& pos, bool cilpO);
+        static bool precedes(const Block* a, const Block* b);
+        static void* targetImage();
+        void reindexChildren(std::size_t first, std::size_t last);
+        void insertChild(Block* child);
+        bool eraseChild(Block* child);
+        void reorderChild(Block* child);
+        void markTreeDirty();
+        iPoint rootOffset() const;
+        void invalidatePosition();
+        bool drawsChild(const Block* child, bool cilpO) const;
+        void releasePainted(std::vector<iRect>& damage);
+        void collectDamage(DamageRegion& region, const iPoint& pos, bool cilpO, bool visible, bool moved);
+        void handleOnDraw(const iPoint& pos, bool cilpO, const DamageRegion* damage = nullptr);
+        void drawSubtree(const iPoint& pos, bool cilpO, const DamageRegion* damage);
+        void drawCache(const iPoint& pos, bool cilpO, const DamageRegion* damage);
+        static void setCanvasRasterMode(Graphics::RasterMode mode);
+        static Graphics::RasterMode canvasRasterMode();
+        static void flushCanvas();
         void handleOnMouseButtonPress(MouseButtonPressEvent* event, const iPoint& pos = iPoint());
         void handleOnMouseButtonRelease(MouseButtonReleaseEvent* event, const iPoint& pos = iPoint());
         void handleOnMouseMove(MouseMoveEvent* event, const iPoint& pos = iPoint());
@@ -78,6 +119,8 @@ namespace GFt {
         /// @param event 文本输入事件
         /// @see onKeyPress
         void onTextInput(TextInputEvent* event) override;
+        /// @brief 绘制区域改变时标记重绘
+        void rectChanged() override;
 
     public:
         /// @brief 构造函数
@@ -119,6 +162,18 @@ namespace GFt {
         /// @see hide() show()
         bool isHide() const;
 
+        /// @brief 设置绘制缓存模式
+        /// @param mode 缓存模式
+        /// @details 缓存模式下，此对象及其子对象首次绘制时被绘制到与此对象等大的离屏位图中，
+        ///          之后的每一帧只复制该位图；任意子对象被标记重绘时缓存自动失效并在下次绘制时重建，
+        ///          仅移动此对象不会使缓存失效
+        /// @details 适用于结构复杂但很少改变的子树，如标题栏或按钮网格
+        /// @note 缓存模式下超出此对象区域的子对象内容将被裁剪
+        /// @see markDirty()
+        void setCacheMode(CacheMode mode);
+        /// @brief 获取绘制缓存模式
+        /// @return 缓存模式
+        CacheMode getCacheMode() const;
         /// @brief 获取层级
         /// @return 层级
         /// @see setZIndex
@@ -135,7 +190,38 @@ namespace GFt {
         iPoint relativePosFrom(Block* block) const;
         /// @brief 计算相对于屏幕的绝对坐标
         /// @return 绝对坐标
+        /// @details 各对象相对于根对象的位置与窗口客户区在屏幕上的位置分别缓存，
+        ///          只在区域改变、父对象改变或窗口移动后重新计算
         iPoint absolutePosition() const;
+        /// @brief 获取位于指定位置的子对象
+        /// @param pos 屏幕坐标
+        /// @return 区域包含该位置的子对象中层级最高(同层级时最先加入)的一个，不存在时返回 nullptr
+        /// @details 子对象较多时使用按子对象区域划分的均匀网格，网格在子对象增删、
+        ///          层级或区域改变后的首次查询时重建
+        /// @details 鼠标事件的分发与 Application::updateBlockHoverState() 均使用此函数
+        Block* childAt(const iPoint& pos) const;
+        /// @brief 使缓存的窗口客户区位置失效
+        /// @details 主循环在窗口移动或改变大小时会自动调用此函数；此函数是线程安全的
+        /// @see absolutePosition()
+        static void invalidateWindowOrigin();
+
+        /// @brief 标记此对象需要重绘
+        /// @details 同时标记其所有祖先对象，此函数只设置标记，可以频繁调用
+        /// @details 按需模式下只重绘被标记的对象在上一帧与本帧所占据的区域，
+        ///          与该区域相交的其它对象会在裁剪到该区域后一同重绘
+        /// @details 块对象自身的属性(区域、层级、显示状态、子对象)改变时会自动调用此函数，
+        ///          派生类在改变影响绘制结果的成员后也应调用此函数
+        /// @details 控件返回非 const 引用的访问器(如 Button::backgroundColor())被调用时即视为将被修改，同样会调用此函数
+        /// @note 仅能在 UI 线程上调用
+        void markDirty();
+        /// @brief 请求重绘此对象
+        /// @details 标记此对象需要重绘，并确保主循环在按需模式下处理下一帧
+        /// @note 仅能在 UI 线程上调用，其它线程应通过 Application::post() 投递后再调用
+        /// @see Application::setLoopMode()
+        void update();
+        /// @brief 判断此对象或其子对象是否需要重绘
+        /// @return 是否需要重绘
+        bool isDirty() const;
     public:
         Signal<Block*> HoverOn;     ///< 当鼠标悬停该对象时之上时触发该信号
         Signal<Block*> HoverOff;    ///< 当鼠标移开该对象时之上时触发该信号
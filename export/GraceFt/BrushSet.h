@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <cstdint>
 
 #include <GraceFt/Color.h>
 #include <GraceFt/Texture.h>
@@ -35,6 +36,7 @@ namespace GFt {
     class BrushSet {
         friend class Graphics;
         void* brush_;
+        mutable std::uint64_t version_;
         /// @cond IGNORE
         void release();
         /// @endcond
@@ -57,6 +59,7 @@ namespace GFt {
         /// @param style 填充样式
         void setFillStyle(const Color& color, FillStyle style = FillStyle::Solid);
         /// @brief 设置纹理画刷填充
+        /// @details 画刷引用纹理而不复制，纹理应在画刷使用期间保持有效；纹理被重新赋值后画刷随之使用新的图像
         /// @param texture 纹理
         /// @param rect 在纹理图像上的矩形区域
         void setTexture(const Texture& texture, const fRect& rect);
@@ -84,5 +87,9 @@ namespace GFt {
         /// @brief 获取当前画刷模式
         /// @return 画刷模式
         BrushStyle getBrushStyle() const;
+        /// @brief 获取版本号
+        /// @details 每次修改后改变，纹理画刷的纹理被重新赋值后同样改变，且不同对象的版本号互不相同，
+        ///          Graphics 据此跳过对同一状态的重复绑定，避免重复创建渐变与纹理画刷
+        std::uint64_t version() const;
     };
 }
\ No newline at end of file
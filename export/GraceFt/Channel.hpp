@@ -1,80 +1,220 @@
 #pragma once
 
-#include <queue>
 #include <mutex>
-#include <thread>
+#include <chrono>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <condition_variable>
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <tuple>
 
 namespace GFt {
+    /// @brief 通道关闭异常
+    /// @details 向已关闭的通道发送数据，或从已关闭且为空的通道阻塞接收数据时抛出此异常
+    /// @ingroup 糖衣工具
+    class ChannelClosed : public std::runtime_error {
+    public:
+        ChannelClosed() : std::runtime_error("Channel is closed") {}
+    };
+
+    /// @cond IGNORE
+    /// @brief select 的等待者，注册到各个通道上，任一通道有数据或被关闭时被唤醒
+    struct ChannelWaiter {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool ready = false;
+
+        virtual ~ChannelWaiter() = default;
+        virtual void wake() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ready = true;
+            }
+            cv.notify_one();
+        }
+    };
+    template<typename T, typename F>
+    class RecvCase;
+    template<typename T>
+    class RecvAwaiter;
+    /// @endcond
+
     /// @brief 通道模板类
-    /// @tparam T 通道中元素的类型
+    /// @tparam T 通道中元素的类型，允许为仅可移动的类型
     /// @ingroup 糖衣工具
     /// @note 此类是线程安全的，可用于多线程环境下线程间的数据交换
+    /// @details 内部使用定长环形缓冲区存储元素，构造后不再分配内存；
+    ///          通道满或空时线程会在条件变量上休眠，而不是忙等
     template<typename T>
     class Channel {
-        std::queue<T> queue_;
+        struct Slot {
+            alignas(T) unsigned char data[sizeof(T)];
+        };
+        std::size_t capacity_;
+        std::unique_ptr<Slot[]> buffer_;
+        std::size_t head_ = 0;
+        std::size_t size_ = 0;
+        bool closed_ = false;
+
         std::mutex mutex_;
+        std::condition_variable notEmpty_;
+        std::condition_variable notFull_;
+        std::vector<ChannelWaiter*> waiters_;
 
-        std::size_t capacity_;
+        template<typename U, typename F>
+        friend class RecvCase;
+        template<typename U>
+        friend class RecvAwaiter;
 
         Channel(const Channel&) = delete;
         Channel& operator=(const Channel&) = delete;
         Channel(Channel&&) = delete;
         Channel& operator=(Channel&&) = delete;
+
+        T* at(std::size_t index) {
+            return std::launder(reinterpret_cast<T*>(buffer_[index % capacity_].data));
+        }
+        // 以下函数要求调用者已持有 mutex_
+        template<typename U>
+        void push(U&& data) {
+            ::new (static_cast<void*>(buffer_[(head_ + size_) % capacity_].data))
+                T(std::forward<U>(data));
+            ++size_;
+        }
+        void wakeWaiters() {
+            for (auto waiter : waiters_)
+                waiter->wake();
+        }
+        T pop() {
+            T* ptr = at(head_);
+            T data = std::move(*ptr);
+            ptr->~T();
+            head_ = (head_ + 1) % capacity_;
+            --size_;
+            return data;
+        }
+        template<typename U>
+        void sendImpl(U&& data) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                notFull_.wait(lock, [this] { return size_ < capacity_ || closed_; });
+                if (closed_)
+                    throw ChannelClosed();
+                push(std::forward<U>(data));
+                wakeWaiters();
+            }
+            notEmpty_.notify_one();
+        }
+        template<typename U>
+        bool trySendImpl(U&& data) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (closed_ || size_ >= capacity_)
+                    return false;
+                push(std::forward<U>(data));
+                wakeWaiters();
+            }
+            notEmpty_.notify_one();
+            return true;
+        }
+        template<typename U, typename Rep, typename Period>
+        bool sendForImpl(U&& data, const std::chrono::duration<Rep, Period>& timeout) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (!notFull_.wait_for(lock, timeout,
+                    [this] { return size_ < capacity_ || closed_; }))
+                    return false;
+                if (closed_)
+                    throw ChannelClosed();
+                push(std::forward<U>(data));
+                wakeWaiters();
+            }
+            notEmpty_.notify_one();
+            return true;
+        }
+        // 供 select 使用
+        void attach(ChannelWaiter* waiter) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            waiters_.push_back(waiter);
+        }
+        void detach(ChannelWaiter* waiter) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            waiters_.erase(std::remove(waiters_.begin(), waiters_.end(), waiter), waiters_.end());
+        }
+        // 返回值为空且 closed 为 true 表示通道已关闭且为空
+        std::optional<T> tryTake(bool& closed) {
+            std::optional<T> data;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                closed = closed_ && size_ == 0;
+                if (size_ == 0)
+                    return data;
+                data.emplace(pop());
+            }
+            notFull_.notify_one();
+            return data;
+        }
     public:
         /// @brief 构造函数
         /// @param capacity 通道的容量，默认为1
-        Channel(std::size_t capacity = 1ull) : capacity_(capacity <= 0? 1 : capacity) {}
-        ~Channel() = default;
+        Channel(std::size_t capacity = 1ull)
+            : capacity_(capacity == 0 ? 1 : capacity),
+            buffer_(std::make_unique<Slot[]>(capacity == 0 ? 1 : capacity)) {}
+        ~Channel() {
+            while (size_ > 0)
+                at(head_++)->~T(), --size_;
+        }
 
         /// @brief 发送数据到通道
         /// @param data 要发送的数据
         /// @details 若通道已满，则线程会被阻塞，直到有空余位置
-        void send(const T& data) {
-            while (queue_.size() >= capacity_)
-                std::this_thread::yield();
-            std::lock_guard<std::mutex> lock(mutex_);
-            queue_.push(data);
-        }
+        /// @exception ChannelClosed 若通道已关闭(包括阻塞期间被关闭)
+        void send(const T& data) { sendImpl(data); }
         /// @brief 发送数据到通道
         /// @param data 要发送的数据
         /// @see send()
-        void send(T&& data) {
-            while (queue_.size() >= capacity_)
-                std::this_thread::yield();
-            std::lock_guard<std::mutex> lock(mutex_);
-            queue_.push(std::move(data));
-        }
+        void send(T&& data) { sendImpl(std::move(data)); }
         /// @brief 尝试发送数据到通道
         /// @param data 要发送的数据
         /// @return 若成功发送，则返回true，否则返回false
-        /// @details 若通道已满，则不会发送数据，并返回false
-        bool try_send(const T& data) {
-            if (queue_.size() >= capacity_)
-                return false;
-            std::lock_guard<std::mutex> lock(mutex_);
-            queue_.push(data);
-            return true;
-        }
+        /// @details 若通道已满或已关闭，则不会发送数据，并返回false
+        bool try_send(const T& data) { return trySendImpl(data); }
         /// @brief 尝试发送数据到通道
         /// @param data 要发送的数据
         /// @return 若成功发送，则返回true，否则返回false
+        /// @note 发送失败时 data 不会被移动
         /// @see try_send()
-        bool try_send(T&& data) {
-            if (queue_.size() >= capacity_)
-                return false;
-            std::lock_guard<std::mutex> lock(mutex_);
-            queue_.push(std::move(data));
-            return true;
+        bool try_send(T&& data) { return trySendImpl(std::move(data)); }
+        /// @brief 限时发送数据到通道
+        /// @param data 要发送的数据
+        /// @param timeout 最长等待时间
+        /// @return 若在超时前成功发送，则返回true，否则返回false
+        /// @exception ChannelClosed 若通道已关闭
+        template<typename Rep, typename Period>
+        bool send_for(const T& data, const std::chrono::duration<Rep, Period>& timeout) {
+            return sendForImpl(data, timeout);
+        }
+        /// @brief 限时发送数据到通道
+        /// @see send_for()
+        template<typename Rep, typename Period>
+        bool send_for(T&& data, const std::chrono::duration<Rep, Period>& timeout) {
+            return sendForImpl(std::move(data), timeout);
         }
         /// @brief 从通道接收数据
         /// @return 接收到的数据
         /// @details 若通道为空，则线程会被阻塞，直到有数据到来
+        /// @exception ChannelClosed 若通道已关闭且其中已无剩余数据
         T recv() {
-            while (queue_.empty())
-                std::this_thread::yield();
-            std::lock_guard<std::mutex> lock(mutex_);
-            T data = queue_.front();
-            queue_.pop();
+            std::unique_lock<std::mutex> lock(mutex_);
+            notEmpty_.wait(lock, [this] { return size_ > 0 || closed_; });
+            if (size_ == 0)
+                throw ChannelClosed();
+            T data = pop();
+            lock.unlock();
+            notFull_.notify_one();
             return data;
         }
         /// @brief 尝试从通道接收数据
@@ -82,12 +222,238 @@ namespace GFt {
         /// @return 若成功接收，则返回true，否则返回false
         /// @details 若通道为空，则不会接收数据，并返回false
         bool try_recv(T& data) {
-            std::lock_guard<std::mutex> lock(mutex_);
-            if (queue_.empty())
-                return false;
-            data = queue_.front();
-            queue_.pop();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (size_ == 0)
+                    return false;
+                data = pop();
+            }
+            notFull_.notify_one();
+            return true;
+        }
+        /// @brief 限时从通道接收数据
+        /// @param data 接收到的数据
+        /// @param timeout 最长等待时间
+        /// @return 若在超时前成功接收，则返回true；若超时或通道已关闭且为空，则返回false
+        template<typename Rep, typename Period>
+        bool recv_for(T& data, const std::chrono::duration<Rep, Period>& timeout) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                notEmpty_.wait_for(lock, timeout, [this] { return size_ > 0 || closed_; });
+                if (size_ == 0)
+                    return false;
+                data = pop();
+            }
+            notFull_.notify_one();
             return true;
         }
+        /// @brief 批量发送数据到通道
+        /// @tparam InputIt 输入迭代器类型
+        /// @param first 待发送数据的起始位置，数据会被移动进通道
+        /// @param n 待发送数据的数量
+        /// @details 每次加锁都会写入当前所有空余位置，若通道已满，则线程会被阻塞，
+        ///          直到 n 个数据全部发送完毕
+        /// @exception ChannelClosed 若通道已关闭，此时已发送的数据不会被撤回
+        template<typename InputIt>
+        void send_n(InputIt first, std::size_t n) {
+            while (n > 0) {
+                std::size_t count = 0;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    notFull_.wait(lock, [this] { return size_ < capacity_ || closed_; });
+                    if (closed_)
+                        throw ChannelClosed();
+                    for (; count < n && size_ < capacity_; ++count, ++first)
+                        push(std::move(*first));
+                    wakeWaiters();
+                }
+                n -= count;
+                count > 1 ? notEmpty_.notify_all() : notEmpty_.notify_one();
+            }
+        }
+        /// @brief 尝试批量发送数据到通道
+        /// @tparam InputIt 输入迭代器类型
+        /// @param first 待发送数据的起始位置，成功发送的数据会被移动进通道
+        /// @param n 待发送数据的最大数量
+        /// @return 实际发送的数据数量，若通道已满或已关闭则返回0
+        /// @details 只加锁一次，写入不超过 n 个数据，不会阻塞
+        template<typename InputIt>
+        std::size_t try_send_n(InputIt first, std::size_t n) {
+            std::size_t count = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (closed_)
+                    return 0;
+                for (; count < n && size_ < capacity_; ++count, ++first)
+                    push(std::move(*first));
+                if (count > 0)
+                    wakeWaiters();
+            }
+            if (count > 0)
+                count > 1 ? notEmpty_.notify_all() : notEmpty_.notify_one();
+            return count;
+        }
+        /// @brief 批量从通道接收数据
+        /// @tparam OutputIt 输出迭代器类型
+        /// @param out 接收数据的写入位置
+        /// @param n 最多接收的数据数量
+        /// @return 实际接收的数据数量
+        /// @details 若通道为空，则线程会被阻塞，直到有数据到来；之后只加锁一次，
+        ///          取出通道中不超过 n 个数据
+        /// @exception ChannelClosed 若通道已关闭且其中已无剩余数据
+        template<typename OutputIt>
+        std::size_t recv_n(OutputIt out, std::size_t n) {
+            std::size_t count = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                notEmpty_.wait(lock, [this] { return size_ > 0 || closed_; });
+                if (size_ == 0)
+                    throw ChannelClosed();
+                for (; count < n && size_ > 0; ++count)
+                    *out++ = pop();
+            }
+            count > 1 ? notFull_.notify_all() : notFull_.notify_one();
+            return count;
+        }
+        /// @brief 尝试批量从通道接收数据
+        /// @tparam OutputIt 输出迭代器类型
+        /// @param out 接收数据的写入位置
+        /// @param n 最多接收的数据数量
+        /// @return 实际接收的数据数量，若通道为空则返回0
+        template<typename OutputIt>
+        std::size_t try_recv_n(OutputIt out, std::size_t n) {
+            std::size_t count = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (; count < n && size_ > 0; ++count)
+                    *out++ = pop();
+            }
+            if (count > 0)
+                count > 1 ? notFull_.notify_all() : notFull_.notify_one();
+            return count;
+        }
+        /// @brief 关闭通道
+        /// @details 关闭后不再接受新的数据，所有阻塞中的发送者会抛出 ChannelClosed，
+        ///          接收者仍可取出通道中剩余的数据，取尽后阻塞接收会抛出 ChannelClosed
+        /// @note 重复关闭无效果
+        void close() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                closed_ = true;
+                wakeWaiters();
+            }
+            notEmpty_.notify_all();
+            notFull_.notify_all();
+        }
+        /// @brief 判断通道是否已关闭
+        bool isClosed() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return closed_;
+        }
+        /// @brief 获取通道中当前元素的数量
+        /// @note 返回值只是调用时刻的快照
+        std::size_t size() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return size_;
+        }
+        /// @brief 获取通道的容量
+        std::size_t capacity() const { return capacity_; }
+    };
+
+    /// @cond IGNORE
+    template<typename T, typename F>
+    class RecvCase {
+        Channel<T>& channel_;
+        F handler_;
+    public:
+        RecvCase(Channel<T>& channel, F handler)
+            : channel_(channel), handler_(std::move(handler)) {}
+        void attach(ChannelWaiter* waiter) { channel_.attach(waiter); }
+        void detach(ChannelWaiter* waiter) { channel_.detach(waiter); }
+        // 返回 1 表示已处理一个数据，0 表示通道为空，-1 表示通道已关闭且为空
+        int poll() {
+            bool closed = false;
+            auto data = channel_.tryTake(closed);
+            if (!data)
+                return closed ? -1 : 0;
+            handler_(std::move(*data));
+            return 1;
+        }
     };
-}
\ No newline at end of file
+    template<typename... Cases>
+    int selectUntil(const std::chrono::steady_clock::time_point* deadline, Cases&... cases) {
+        constexpr int count = sizeof...(Cases);
+        ChannelWaiter waiter;
+        (cases.attach(&waiter), ...);
+        struct Detach {
+            ChannelWaiter* waiter;
+            std::tuple<Cases&...> cases;
+            ~Detach() { std::apply([this](auto&... c) { (c.detach(waiter), ...); }, cases); }
+        } guard{ &waiter, std::tie(cases...) };
+        // 轮换起始位置，避免总是优先处理前面的通道
+        thread_local unsigned rotate = 0;
+        unsigned start = rotate++;
+        while (true) {
+            int closed = 0;
+            for (int k = 0; k < count; ++k) {
+                int index = static_cast<int>((start + k) % count), result = 0, i = 0;
+                ((i++ == index ? (void)(result = cases.poll()) : (void)0), ...);
+                if (result > 0)
+                    return index;
+                closed += result < 0;
+            }
+            if (closed == count)
+                throw ChannelClosed();
+            std::unique_lock<std::mutex> lock(waiter.mutex);
+            if (deadline) {
+                if (!waiter.cv.wait_until(lock, *deadline, [&] { return waiter.ready; }))
+                    return -1;
+            }
+            else
+                waiter.cv.wait(lock, [&] { return waiter.ready; });
+            waiter.ready = false;
+        }
+    }
+    /// @endcond
+
+    /// @brief 构造 select 的接收分支
+    /// @param channel 要等待的通道
+    /// @param handler 接收到数据时调用的函数，参数为接收到的数据
+    /// @return 接收分支对象，用作 select() 或 select_for() 的参数
+    /// @ingroup 糖衣工具
+    template<typename T, typename F>
+    RecvCase<T, F> onRecv(Channel<T>& channel, F handler) {
+        return RecvCase<T, F>(channel, std::move(handler));
+    }
+    /// @brief 同时等待多个通道
+    /// @param cases 由 onRecv() 构造的接收分支
+    /// @return 被执行的分支的下标(从0开始)
+    /// @details 阻塞直到任一通道有数据，取出一个数据并调用对应分支的处理函数；
+    ///          若多个通道同时有数据，会轮流选择，不会固定偏向某一通道
+    /// @exception ChannelClosed 若所有通道均已关闭且为空
+    /// @ingroup 糖衣工具
+    /// @code
+    /// Channel<int> numbers(16);
+    /// Channel<std::string> texts(16);
+    /// select(
+    ///     onRecv(numbers, [](int n) { std::cout << n << std::endl; }),
+    ///     onRecv(texts, [](std::string s) { std::cout << s << std::endl; }));
+    /// @endcode
+    template<typename... Cases>
+    int select(Cases&&... cases) {
+        return selectUntil(nullptr, cases...);
+    }
+    /// @brief 限时同时等待多个通道
+    /// @param timeout 最长等待时间
+    /// @param cases 由 onRecv() 构造的接收分支
+    /// @return 被执行的分支的下标，若超时则返回-1
+    /// @exception ChannelClosed 若所有通道均已关闭且为空
+    /// @see select()
+    /// @ingroup 糖衣工具
+    template<typename Rep, typename Period, typename... Cases>
+    int select_for(const std::chrono::duration<Rep, Period>& timeout, Cases&&... cases) {
+        auto deadline = std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+        return selectUntil(&deadline, cases...);
+    }
+}
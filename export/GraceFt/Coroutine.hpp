@@ -0,0 +1,408 @@
+#pragma once
+
+#include <chrono>
+#include <tuple>
+#include <mutex>
+#include <queue>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <optional>
+#include <exception>
+#include <functional>
+#include <coroutine>
+#include <GraceFt/Signal.hpp>
+#include <GraceFt/Channel.hpp>
+
+namespace GFt {
+    /// @defgroup 协程支持库
+    /// @brief 这里提供基于 C++20 协程的异步任务支持
+    /// @details 协程中可以通过 co_await 等待时间、帧、通道或信号，
+    ///          所有协程都在 UI 线程上被恢复执行，因此可以在其中安全地访问 Block 对象树
+    /// @ingroup 基础设施库
+
+    /// @brief 协程调度器
+    /// @details 调度器会在每一帧 onEventCall 信号被触发时恢复到期的协程，
+    ///          定时等待按截止时间存放在最小堆中，每帧只检查堆顶
+    /// @ingroup 协程支持库
+    class TaskScheduler {
+        using Clock = std::chrono::steady_clock;
+        struct Timer {
+            Clock::time_point deadline;
+            std::coroutine_handle<> handle;
+            bool operator>(const Timer& other) const { return deadline > other.deadline; }
+        };
+        std::vector<std::coroutine_handle<>> nextFrame_;
+        std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+        std::mutex postMutex_;
+        std::vector<std::function<void()>> posted_;
+
+        TaskScheduler();
+        TaskScheduler(const TaskScheduler&) = delete;
+        TaskScheduler(TaskScheduler&&) = delete;
+        TaskScheduler& operator=(const TaskScheduler&) = delete;
+        TaskScheduler& operator=(TaskScheduler&&) = delete;
+
+        void update();
+        static TaskScheduler& getInstance();
+
+    public:
+        /// @brief 在下一帧恢复协程
+        static void resumeNextFrame(std::coroutine_handle<> handle);
+        /// @brief 在指定时刻之后的首帧恢复协程
+        static void resumeAt(Clock::time_point deadline, std::coroutine_handle<> handle);
+        /// @brief 投递函数到下一帧执行
+        /// @details 此函数是线程安全的，用于从其它线程唤醒协程
+        static void post(std::function<void()> func);
+    };
+
+    template<typename T = void>
+    class Task;
+
+    /// @cond IGNORE
+    class TaskPromiseBase {
+        template<typename T> friend class Task;
+        std::coroutine_handle<> continuation_;
+        bool detached_ = false;
+
+    protected:
+        std::exception_ptr exception_;
+
+        void rethrow() {
+            if (exception_)
+                std::rethrow_exception(exception_);
+        }
+
+    public:
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+                auto& promise = h.promise();
+                if (promise.continuation_)
+                    return promise.continuation_;
+                if (promise.detached_) {
+                    // 无人等待的任务将异常交给调度器在下一帧抛出，以免异常被静默吞掉；
+                    // 协程此时已挂起，可以先释放协程帧再抛出
+                    auto exception = std::move(promise.exception_);
+                    h.destroy();
+                    if (exception)
+                        TaskScheduler::post([exception] { std::rethrow_exception(exception); });
+                }
+                return std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception() { exception_ = std::current_exception(); }
+    };
+    template<typename T>
+    class TaskPromise : public TaskPromiseBase {
+        std::optional<T> value_;
+    public:
+        Task<T> get_return_object();
+        template<typename U>
+        void return_value(U&& value) { value_.emplace(std::forward<U>(value)); }
+        T result() {
+            rethrow();
+            return std::move(*value_);
+        }
+    };
+    template<>
+    class TaskPromise<void> : public TaskPromiseBase {
+    public:
+        Task<void> get_return_object();
+        void return_void() {}
+        void result() { rethrow(); }
+    };
+    /// @endcond
+
+    /// @brief 协程任务
+    /// @tparam T 协程返回值类型
+    /// @details 调用协程函数后任务立即开始执行，直到首个挂起点；
+    ///          可以在另一个协程中 co_await 任务以等待其完成并获取返回值
+    /// @details 若任务对象在协程完成前被销毁，协程会继续运行并在完成后自行释放
+    /// @ingroup 协程支持库
+    /// @code
+    /// Task<> blink(Block* block) {
+    ///     for (int i = 0; i < 3; ++i) {
+    ///         block->hide();
+    ///         co_await delay(300);
+    ///         block->show();
+    ///         co_await delay(300);
+    ///     }
+    /// }
+    /// @endcode
+    template<typename T>
+    class Task {
+    public:
+        using promise_type = TaskPromise<T>;
+
+    private:
+        std::coroutine_handle<promise_type> handle_;
+
+    public:
+        /// @cond IGNORE
+        explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+        /// @endcond
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                detach();
+                handle_ = std::exchange(other.handle_, nullptr);
+            }
+            return *this;
+        }
+        ~Task() { detach(); }
+
+        /// @brief 判断任务是否已完成
+        bool done() const { return !handle_ || handle_.done(); }
+        /// @brief 放弃对任务的所有权
+        /// @details 协程会继续运行，并在完成后自行释放
+        void detach() {
+            if (!handle_)
+                return;
+            if (handle_.done())
+                handle_.destroy();
+            else
+                handle_.promise().detached_ = true;
+            handle_ = nullptr;
+        }
+
+        /// @cond IGNORE
+        bool await_ready() const { return done(); }
+        void await_suspend(std::coroutine_handle<> awaiting) {
+            handle_.promise().continuation_ = awaiting;
+        }
+        T await_resume() { return handle_.promise().result(); }
+        /// @endcond
+    };
+
+    /// @cond IGNORE
+    template<typename T>
+    Task<T> TaskPromise<T>::get_return_object() {
+        return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+    }
+    inline Task<void> TaskPromise<void>::get_return_object() {
+        return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+    }
+
+    struct DelayAwaiter {
+        std::chrono::steady_clock::time_point deadline;
+        bool await_ready() const { return std::chrono::steady_clock::now() >= deadline; }
+        void await_suspend(std::coroutine_handle<> h) { TaskScheduler::resumeAt(deadline, h); }
+        void await_resume() const {}
+    };
+    struct NextFrameAwaiter {
+        bool await_ready() const { return false; }
+        void await_suspend(std::coroutine_handle<> h) { TaskScheduler::resumeNextFrame(h); }
+        void await_resume() const {}
+    };
+
+    /// @brief 等待通道数据的等待体，注册为通道的等待者，有数据时经由调度器在 UI 线程恢复
+    template<typename T>
+    class RecvAwaiter : public ChannelWaiter {
+        Channel<T>& channel_;
+        std::optional<T> value_;
+        bool closed_ = false;
+        std::atomic<bool> posted_ = false;
+        std::coroutine_handle<> handle_;
+
+        bool take() {
+            value_ = channel_.tryTake(closed_);
+            return value_ || closed_;
+        }
+        // 在 UI 线程上执行：先注销，再取数据；仍为空时重新注册
+        void retry() {
+            channel_.detach(this);
+            if (take())
+                return handle_.resume();
+            posted_ = false;
+            channel_.attach(this);
+            if (channel_.size() > 0 || channel_.isClosed())
+                wake();
+        }
+    public:
+        explicit RecvAwaiter(Channel<T>& channel) : channel_(channel) {}
+        void wake() override {
+            if (!posted_.exchange(true))
+                TaskScheduler::post([this] { retry(); });
+        }
+        bool await_ready() { return take(); }
+        void await_suspend(std::coroutine_handle<> h) {
+            handle_ = h;
+            channel_.attach(this);
+            // 数据可能在 await_ready() 之后、注册之前到达，此时不会收到通知
+            if (channel_.size() > 0 || channel_.isClosed())
+                wake();
+        }
+        T await_resume() {
+            if (!value_)
+                throw ChannelClosed();
+            return std::move(*value_);
+        }
+    };
+
+    /// @brief 等待信号发出的等待体
+    /// @details 槽函数与等待体共用 State 中的互斥量：连接在持有锁时进行，因此槽函数总能读到已发布的 ID；
+    ///          等待体析构(包括协程帧在恢复前被销毁)时断开槽函数并清空 signal，已投递的恢复随之作废
+    template<typename... Args>
+    class SignalAwaiter {
+        using Values = std::tuple<std::decay_t<Args>...>;
+        struct State {
+            std::mutex mutex;
+            bool fired = false;
+            std::optional<Values> values;
+            std::coroutine_handle<> handle;
+            Signal<Args...>* signal = nullptr;
+            SlotId<Args...> id = 0;
+            // 在持有锁时调用，返回是否仍处于连接状态
+            bool disconnect() {
+                if (!signal)
+                    return false;
+                signal->disconnect(id);
+                signal = nullptr;
+                return true;
+            }
+        };
+        Signal<Args...>& signal_;
+        std::shared_ptr<State> state_ = std::make_shared<State>();
+    public:
+        explicit SignalAwaiter(Signal<Args...>& signal) : signal_(signal) {}
+        SignalAwaiter(const SignalAwaiter&) = delete;
+        SignalAwaiter(SignalAwaiter&&) = default;
+        ~SignalAwaiter() {
+            if (!state_)
+                return;
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->disconnect();
+        }
+        bool await_ready() const { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->handle = h;
+            state_->signal = &signal_;
+            state_->id = signal_.connect([state = state_](Args... args) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                // 信号可能被多次发出，只响应第一次
+                if (state->fired || !state->signal)
+                    return;
+                state->fired = true;
+                state->values.emplace(args...);
+                TaskScheduler::post([state] {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    if (!state->disconnect())
+                        return;
+                    lock.unlock();
+                    state->handle.resume();
+                    });
+                });
+        }
+        auto await_resume() {
+            if constexpr (sizeof...(Args) == 1)
+                return std::get<0>(std::move(*state_->values));
+            else
+                return std::move(*state_->values);
+        }
+    };
+    class VoidSignalAwaiter {
+        struct State {
+            std::mutex mutex;
+            bool fired = false;
+            std::coroutine_handle<> handle;
+            Signal<void>* signal = nullptr;
+            SlotId<void> id = 0;
+            bool disconnect() {
+                if (!signal)
+                    return false;
+                signal->disconnect(id);
+                signal = nullptr;
+                return true;
+            }
+        };
+        Signal<void>& signal_;
+        std::shared_ptr<State> state_ = std::make_shared<State>();
+    public:
+        explicit VoidSignalAwaiter(Signal<void>& signal) : signal_(signal) {}
+        VoidSignalAwaiter(const VoidSignalAwaiter&) = delete;
+        VoidSignalAwaiter(VoidSignalAwaiter&&) = default;
+        ~VoidSignalAwaiter() {
+            if (!state_)
+                return;
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->disconnect();
+        }
+        bool await_ready() const { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->handle = h;
+            state_->signal = &signal_;
+            state_->id = signal_.connect([state = state_] {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (state->fired || !state->signal)
+                    return;
+                state->fired = true;
+                TaskScheduler::post([state] {
+                    std::unique_lock<std::mutex> lock(state->mutex);
+                    if (!state->disconnect())
+                        return;
+                    lock.unlock();
+                    state->handle.resume();
+                    });
+                });
+        }
+        void await_resume() const {}
+    };
+    /// @endcond
+
+    /// @brief 等待指定时间
+    /// @param ms 等待时间（毫秒）
+    /// @details 协程会在至少 ms 毫秒后的首帧被恢复
+    /// @ingroup 协程支持库
+    inline DelayAwaiter delay(float ms) {
+        return DelayAwaiter{ std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<float, std::milli>(ms)) };
+    }
+    /// @brief 等待下一帧
+    /// @ingroup 协程支持库
+    inline NextFrameAwaiter nextFrame() { return {}; }
+    /// @brief 异步接收通道数据
+    /// @param channel 要接收数据的通道
+    /// @return 可 co_await 的等待体，其结果为接收到的数据
+    /// @details 通道为空时协程挂起而不阻塞线程，数据到来后在 UI 线程恢复
+    /// @exception ChannelClosed 若通道已关闭且其中已无剩余数据
+    /// @ingroup 协程支持库
+    /// @code
+    /// Task<> consume(Channel<std::string>& lines, Label* label) {
+    ///     while (true)
+    ///         label->setText(co_await recvAsync(lines));
+    /// }
+    /// @endcode
+    template<typename T>
+    RecvAwaiter<T> recvAsync(Channel<T>& channel) { return RecvAwaiter<T>(channel); }
+    /// @brief 等待信号发出
+    /// @details 结果为信号的参数：单个参数时为该参数的值，多个参数时为 std::tuple
+    /// @details 协程帧在恢复前被销毁时槽函数随之断开，因此信号应在等待结束或协程帧销毁之前保持有效
+    /// @note 协程会在信号发出后的下一帧恢复
+    /// @ingroup 协程支持库
+    /// @code
+    /// Task<> waitClick(Button* button) {
+    ///     co_await button->onClicked;
+    ///     ...
+    /// }
+    /// @endcode
+    template<typename... Args>
+    SignalAwaiter<Args...> operator co_await(Signal<Args...>& signal) {
+        return SignalAwaiter<Args...>(signal);
+    }
+    /// @brief 等待无参数信号发出
+    /// @ingroup 协程支持库
+    inline VoidSignalAwaiter operator co_await(Signal<void>& signal) {
+        return VoidSignalAwaiter(signal);
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+
+#include <GraceFt/Rect.hpp>
+
+namespace GFt {
+    /// @class DamageRegion
+    /// @brief 需要重绘的区域
+    /// @details 由少量互不重叠的矩形组成：加入的矩形与已有矩形重叠时合并为外接矩形，
+    ///          矩形数量超过上限时合并使外接矩形面积增加最少的一对
+    /// @ingroup 基础UI封装库
+    class DamageRegion {
+        std::vector<iRect> rects_;
+        std::size_t maxRects_;
+
+        iRect takeClosestPair();
+
+    public:
+        /// @brief 构造函数
+        /// @param maxRects 矩形数量的上限，至少为 1
+        explicit DamageRegion(std::size_t maxRects = 8);
+
+        /// @brief 加入需要重绘的矩形
+        /// @param rect 矩形，宽或高不大于 0 时忽略
+        void add(const iRect& rect);
+        /// @brief 清空区域
+        void clear();
+        /// @brief 判断区域是否为空
+        bool empty() const;
+        /// @brief 判断矩形是否与区域相交
+        /// @param rect 矩形
+        bool intersects(const iRect& rect) const;
+        /// @brief 组成区域的矩形
+        const std::vector<iRect>& rects() const;
+        /// @brief 区域的总面积
+        long long area() const;
+    };
+}
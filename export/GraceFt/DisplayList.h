@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <GraceFt/Graphics.h>
+
+namespace GFt {
+    /// @class DisplayList
+    /// @brief 绘图命令列表
+    /// @details 提供与 Graphics 相同的绘图与状态接口，调用时只记录命令而不绘制，
+    ///          之后可以回放到任意绘图设备上，用于缓存内容不变的绘制、统计绘图调用等
+    /// @details 命令以紧凑的字节流存储，多边形、曲线与字符串等变长数据存放在独立的表中
+    /// @details 画笔、画刷与文字配置在绑定时被复制，回放时使用记录时的状态，
+    ///          连续绑定同一版本的配置只复制一次；路径与位图只记录指针，回放时使用它们当时的状态，
+    ///          因此应保证它们在回放时仍然有效；纹理画刷的副本同样引用纹理本身，
+    ///          纹理在两次绑定之间被重新赋值时画刷的版本号改变，回放时会重新绑定并使用纹理当时的图像
+    /// @details 回放时状态命令被延迟到下一个绘制命令之前执行，
+    ///          与已生效的状态相同或在生效之前就被覆盖的状态命令会被省略；
+    ///          配置按记录时的版本号比较，因此绑定同一对象前后修改过它时不会被省略
+    /// @see Graphics::beginRecording()
+    /// @ingroup 接口类型
+    class DisplayList {
+    public:
+        /// @brief 统计信息
+        struct Statistics {
+            std::size_t commands = 0;       ///< 命令数量
+            std::size_t drawCalls = 0;      ///< 绘制命令数量
+            std::size_t stateChanges = 0;   ///< 执行的状态命令数量
+            std::size_t elided = 0;         ///< 被省略的状态命令数量
+        };
+
+    private:
+        enum class Op : std::uint8_t;
+        /// @brief 绑定时复制的配置
+        template<typename Set>
+        struct Snapshots {
+            std::vector<Set> sets;
+            std::vector<std::uint64_t> versions;    // 复制时原对象的版本号
+        };
+        std::vector<std::uint8_t> stream_;
+        std::vector<fPolygon> polygons_;
+        std::vector<fBezier> beziers_;
+        std::vector<fFitCurve> curves_;
+        std::vector<std::wstring> strings_;
+        std::vector<std::vector<std::wstring>> fonts_;
+        Snapshots<PenSet> pens_;
+        Snapshots<BrushSet> brushes_;
+        Snapshots<TextSet> texts_;
+        std::size_t commands_ = 0;
+        std::size_t drawCalls_ = 0;
+
+        template<typename T>
+        void write(const T& value);
+        void writeOp(Op op, bool draw);
+        void writeMatrix(const fMat3x3& matrix);
+        std::uint32_t addFonts(const std::vector<std::wstring>& fonts);
+        template<typename Set>
+        void writeState(Op op, Snapshots<Set>& table, const Set* set);
+
+    public:
+        DisplayList() = default;
+
+        /// @brief 清除所有命令
+        void reset();
+        /// @brief 是否没有命令
+        bool empty() const;
+        /// @brief 获取命令数量
+        std::size_t size() const;
+        /// @brief 获取绘制命令数量
+        std::size_t drawCalls() const;
+        /// @brief 获取命令字节流的大小(不含变长数据)
+        std::size_t bytes() const;
+
+        /// @brief 回放到绘图设备
+        /// @param g 绘图设备
+        /// @return 本次回放的统计信息
+        Statistics replay(Graphics& g) const;
+
+        /// @name 与 Graphics 相同的接口
+        /// @{
+        void setAntiAliasing(bool enable);
+        void setTransform(const fMat3x3& matrix);
+        void resetTransform();
+        void clear();
+        void setBackgroundColor(const Color& color);
+        void bindPenSet(PenSet* penSet);
+        void bindBrushSet(BrushSet* brushSet);
+        void bindTextSet(TextSet* textSet);
+
+        void drawLine(const fLine& line);
+        void drawRect(const fRect& rect);
+        void drawRoundRect(const fRoundRect& rect);
+        void drawArc(const fRect& rect, float startAngle, float sweepAngle);
+        void drawEllipse(const fEllipse& ellipse);
+        void drawCircle(const fCircle& circle);
+        void drawPie(const fRect& rect, float startAngle, float sweepAngle);
+        void drawPolygon(const fPolygon& polygon);
+        void drawBezier(const fBezier& curve);
+        void drawFitCurve(const fFitCurve& curve);
+        void drawPath(const Path& path, const fPoint& pos = fPoint());
+
+        void drawFillRect(const fRect& rect);
+        void drawFillRoundRect(const fRoundRect& rect);
+        void drawFillPie(const fRect& rect, float startAngle, float sweepAngle);
+        void drawFillPolygon(const fPolygon& polygon);
+        void drawFillEllipse(const fEllipse& ellipse);
+        void drawFillCircle(const fCircle& circle);
+        void drawFillFitCurve(const fFitCurve& curve);
+        void drawFillPath(const Path& path, const fPoint& pos = fPoint());
+
+        void drawImage(const fPoint& pos, const PixelMap& pixelMap);
+        void drawImage(const fRect& dest, const fRect& src, const PixelMap& pixelMap);
+        void drawAlphaImage(const PixelMap& pixelMap, const fPoint& dest, const fRect& src);
+        void drawAlphaImage(const PixelMap& pixelMap, const fRect& dest, const fRect& src, bool smooth = false);
+
+        void drawText(const std::wstring& text, const fPoint& pos, const std::vector<std::wstring>& fonts = {});
+        void drawText(const std::wstring& text, const fRect& rect,
+            int flags = TextAlign::Left | TextAlign::Top, const std::vector<std::wstring>& fonts = {});
+        /// @}
+    };
+}
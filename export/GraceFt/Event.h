@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include <GraceFt/Point.hpp>
 
 namespace GFt {
@@ -198,6 +200,7 @@ namespace GFt {
     public:
         /// @cond IGNORE
         MouseEvent(const iPoint& position);
+        MouseEvent(const iPoint& position, const iPoint& absolutePosition);
         virtual ~MouseEvent() = default;
         /// @endcond
         /// @brief 获取鼠标位置
@@ -255,6 +258,7 @@ namespace GFt {
     public:
         /// @cond IGNORE
         MouseButtonEvent(const iPoint& position, MouseButton button);
+        MouseButtonEvent(const iPoint& position, MouseButton button, const iPoint& absolutePosition);
         virtual ~MouseButtonEvent() = default;
         /// @endcond
         /// @brief 获取鼠标按钮
@@ -269,6 +273,7 @@ namespace GFt {
     public:
         /// @cond IGNORE
         MouseWheelEvent(const iPoint& position, MouseWheel wheel);
+        MouseWheelEvent(const iPoint& position, MouseWheel wheel, const iPoint& absolutePosition);
         virtual ~MouseWheelEvent() = default;
         /// @endcond
         /// @brief 获取鼠标滚轮状态
@@ -278,11 +283,20 @@ namespace GFt {
     /// @brief 鼠标移动事件
     /// @ingroup 事件对象类型
     class MouseMoveEvent : public MouseEvent {
+        std::vector<iPoint> history_;
+
     public:
         /// @cond IGNORE
         MouseMoveEvent(const iPoint& position);
+        MouseMoveEvent(const iPoint& position, const iPoint& absolutePosition, std::vector<iPoint> history);
         virtual ~MouseMoveEvent() = default;
         /// @endcond
+        /// @brief 获取本次事件合并的所有鼠标位置
+        /// @details 主循环每帧只分发一次鼠标移动事件，期间收到的所有移动位置按先后顺序保存在此，
+        ///          最后一个即为 position()；绘图类应用可以据此还原完整的鼠标轨迹
+        /// @details 位置的坐标系与 position() 相同
+        /// @return 鼠标位置序列，至少包含一个位置
+        const std::vector<iPoint>& history() const;
     };
     /// @brief 键盘按键按下事件
     /// @ingroup 事件对象类型
@@ -308,6 +322,7 @@ namespace GFt {
     public:
         /// @cond IGNORE
         MouseButtonPressEvent(const iPoint& position, MouseButton button);
+        MouseButtonPressEvent(const iPoint& position, MouseButton button, const iPoint& absolutePosition);
         virtual ~MouseButtonPressEvent() = default;
         /// @endcond
     };
@@ -317,6 +332,7 @@ namespace GFt {
     public:
         /// @cond IGNORE
         MouseButtonReleaseEvent(const iPoint& position, MouseButton button);
+        MouseButtonReleaseEvent(const iPoint& position, MouseButton button, const iPoint& absolutePosition);
         virtual ~MouseButtonReleaseEvent() = default;
         /// @endcond
     };
@@ -18,6 +18,9 @@ namespace GFt {
         /// @brief 绘制接口
         /// @param g 绘图对象
         virtual void onDraw(Graphics& g) = 0;
+        /// @brief 绘制区域改变时调用
+        /// @details 在 onPositionChanged 与 onSizeChanged 信号发出之前调用
+        virtual void rectChanged() {}
 
     public:
         /// @brief 构造函数
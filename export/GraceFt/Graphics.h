@@ -16,7 +16,14 @@
 #include <GraceFt/Color.h>
 #include <GraceFt/Circle.hpp>
 
+#include <memory>
+
 namespace GFt {
+    class DamageRegion;
+    class Rasterizer;
+    class TileRenderer;
+    class DisplayList;
+
     /// @defgroup 文本枚举
     /// @brief 这里列出了文本对齐方式的枚举值
     /// @ingroup 枚举
@@ -37,11 +44,50 @@ namespace GFt {
     /// @details 该类提供了绘图相关的接口，包括绘制线段、矩形、圆形、椭圆、圆弧、多边形、贝塞尔曲线、拟合曲线、路径、图像、文本等
     /// @ingroup 接口类型
     class Graphics {
+    public:
+        /// @brief 状态绑定的统计信息
+        /// @see getBindStatistics()
+        struct BindStatistics {
+            std::size_t penBinds = 0;       ///< 执行的画笔绑定次数
+            std::size_t penElided = 0;      ///< 因状态未改变而跳过的画笔绑定次数
+            std::size_t brushBinds = 0;     ///< 执行的画刷绑定次数
+            std::size_t brushElided = 0;    ///< 因状态未改变而跳过的画刷绑定次数
+            std::size_t textBinds = 0;      ///< 执行的文字配置绑定次数
+            std::size_t textElided = 0;     ///< 因状态未改变而跳过的文字配置绑定次数
+        };
+        /// @brief 光栅化方式
+        enum class RasterMode {
+            Native,     ///< 由 EGE 绘制(默认)
+            Software,   ///< 纯色填充由内置的软件光栅化器绘制，其余仍由 EGE 绘制
+            Tiled,      ///< 纯色填充先被记录，在 flush() 时按屏幕分块由线程池并行绘制，其余仍由 EGE 绘制
+        };
+
+    private:
         static PenSet defaultPenSet_;
         static BrushSet defaultBrushSet_;
         static TextSet defaultTextSet_;
-        void* target_;
         PixelMap* targetPixelMap_;
+        void* resolveTarget() const;
+        void* target() const;
+
+        RasterMode rasterMode_ = RasterMode::Native;
+        bool antiAliasing_ = false;
+        fMat3x3 transform_ = fMat3x3::I();
+        unsigned int fillColor_ = 0;
+        bool solidFill_ = false;
+        const DamageRegion* clipRegion_ = nullptr;
+        std::unique_ptr<Rasterizer> rasterizer_;
+        std::unique_ptr<TileRenderer> tiles_;
+        DisplayList* recorder_ = nullptr;
+        BindStatistics bindStatistics_;
+        bool shouldBind(int slot, std::uint64_t version);
+        std::vector<fPoint> points_;
+        bool beginSoftwareFill();
+        void endSoftwareFill();
+#ifdef GFT_HEADLESS
+        void strokeSoftware(bool closed);
+        void drawPixels(const PixelMap& pixelMap, fRect dest, const fRect& src, bool blend);
+#endif
     private:
         Graphics(const Graphics& other) = delete;
         Graphics& operator=(const Graphics& other) = delete;
@@ -60,6 +106,40 @@ namespace GFt {
         /// @brief 设置抗锯齿
         /// @param enable 是否启用抗锯齿
         void setAntiAliasing(bool enable);
+        /// @brief 设置光栅化方式
+        /// @details 软件光栅化只处理纯色画刷的多边形类填充(矩形、圆角矩形、扇形、多边形、椭圆与圆)，
+        ///          曲线与路径的填充、渐变与纹理画刷以及所有线条、图像与文本仍由 EGE 绘制
+        /// @param mode 光栅化方式
+        void setRasterMode(RasterMode mode);
+        /// @brief 获取光栅化方式
+        RasterMode getRasterMode() const;
+        /// @brief 绘制分块模式下已记录的填充
+        /// @details 由 EGE 绘制的图形、切换绘图目标与析构前会自动调用此函数以保持绘制顺序，
+        ///          直接通过 EGE 访问绘图目标前应手动调用
+        void flush();
+        /// @brief 开始将绘图调用录制到命令列表中
+        /// @param list 命令列表，录制期间应保持有效
+        /// @details 录制期间绘制与状态函数只向列表追加命令，不作用于绘图目标；
+        ///          文字配置例外，它同时作用于绘图目标，以便正确测量文字；
+        ///          drawText() 返回测量得到的宽度，get 系列函数返回绘图目标的状态
+        /// @see DisplayList
+        void beginRecording(DisplayList* list);
+        /// @brief 结束录制
+        void endRecording();
+        /// @brief 获取正在录制的命令列表，未在录制时为 nullptr
+        DisplayList* recorder() const;
+        /// @brief 获取状态绑定的统计信息
+        /// @details 绑定与绘图目标上已生效的画笔、画刷或文字配置版本相同的对象时跳过绑定，
+        ///          已生效的版本记录在绘图目标上，因此多个绘图设备交替使用同一目标时结果仍然正确
+        /// @see PenSet::version() BrushSet::version() TextSet::version()
+        const BindStatistics& getBindStatistics() const;
+        /// @brief 清零状态绑定的统计信息
+        void resetBindStatistics();
+        /// @brief 设置软件光栅化时的裁剪区域
+        /// @details 区域以绘图目标的左上角为原点，为 nullptr 时不额外裁剪；
+        ///          EGE 绘制的内容由绘图目标自身的裁剪区域限制，不受此设置影响
+        /// @param region 裁剪区域，应保证在下次设置之前有效
+        void setClipRegion(const DamageRegion* region);
         /// @brief 应用变换矩阵
         /// @param matrix 变换矩阵
         void setTransform(const fMat3x3& matrix);
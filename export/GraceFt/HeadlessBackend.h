@@ -0,0 +1,120 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+
+#include <GraceFt/Backend.h>
+
+namespace GFt {
+    /// @class HeadlessBackend
+    /// @brief 无窗口的后端
+    /// @details 屏幕是内存中的位图，输入来自调用方合成的消息，不依赖任何窗口系统，
+    ///          用于自动化测试与性能测试
+    /// @details 帧率控制不会等待，主循环会以最快的速度运行
+    /// @details 以 GFT_HEADLESS（cup 特性 headless）构建时不依赖 EGE 与 Win32：位图为内存中的像素缓冲区，
+    ///          图形统一由软件光栅化器绘制，文字不被绘制，只按字号估算宽高
+    /// @code
+    /// auto backend = std::make_unique<HeadlessBackend>();
+    /// auto headless = backend.get();
+    /// Backend::install(std::move(backend));
+    /// Window* window = Window::createWindow(&root);
+    /// Application app(window);
+    /// headless->click(iPoint(10, 10));
+    /// Application::renderFrame(true);
+    /// headless->framebuffer().saveToFile(L"frame.png");
+    /// @endcode
+    /// @ingroup 基础UI封装库
+    class HeadlessBackend final : public Backend {
+        PixelMap screen_;
+        iSize screenSize_;
+        int dpi_;
+        iPoint origin_;
+        iPoint cursor_;
+        std::wstring title_;
+        bool running_ = false;
+        bool visible_ = false;
+        bool cursorVisible_ = true;
+        std::size_t frames_ = 0;
+        long long presentedArea_ = 0;
+
+        std::mutex inputMutex_;
+        std::deque<MouseMessage> mouse_;
+        std::deque<KeyMessage> keys_;
+
+        void pushMouse(const MouseMessage& msg);
+        void pushKey(const KeyMessage& msg);
+
+    public:
+        /// @brief 构造函数
+        /// @param screenSize 模拟的屏幕大小
+        /// @param dpi 模拟的系统 DPI
+        explicit HeadlessBackend(const iSize& screenSize = iSize(1920, 1080), int dpi = 96);
+
+        /// @brief 获取屏幕对应的位图
+        const PixelMap& framebuffer() const;
+        /// @brief 获取已呈现的帧数
+        std::size_t presentedFrames() const;
+        /// @brief 获取已呈现的像素总数
+        /// @details 部分重绘的帧只计入重绘区域的面积
+        long long presentedArea() const;
+        /// @brief 获取窗口标题
+        const std::wstring& title() const;
+        /// @brief 窗口是否显示
+        bool isVisible() const;
+
+        /// @name 合成输入
+        /// @details 位置以窗口客户区左上角为原点；这些函数是线程安全的，并会唤醒主循环
+        /// @{
+
+        /// @brief 移动鼠标
+        void moveMouse(const iPoint& pos);
+        /// @brief 按下鼠标按键
+        void pressMouse(const iPoint& pos, MouseButton button = MouseButton::Left);
+        /// @brief 释放鼠标按键
+        void releaseMouse(const iPoint& pos, MouseButton button = MouseButton::Left);
+        /// @brief 在指定位置按下并释放鼠标按键
+        void click(const iPoint& pos, MouseButton button = MouseButton::Left);
+        /// @brief 滚动鼠标滚轮
+        void scrollMouse(const iPoint& pos, MouseWheel wheel);
+        /// @brief 按下键盘按键
+        void pressKey(Key key, bool shift = false, bool ctrl = false);
+        /// @brief 释放键盘按键
+        void releaseKey(Key key, bool shift = false, bool ctrl = false);
+        /// @brief 输入文本
+        void typeText(const std::wstring& text);
+        /// @}
+
+        bool createWindow(const iSize& size, int flags) override;
+        void closeWindow() override;
+        bool isRunning() override;
+        void waitFrame(double fps) override;
+
+        void showWindow(bool show) override;
+        void resizeWindow(const iSize& size) override;
+        void moveWindow(const iPoint& pos) override;
+        void minimizeWindow() override;
+        void setWindowTitle(const std::wstring& title) override;
+        void setWindowTopMost(bool topMost) override;
+        void setWindowFrameless(bool frameless) override;
+        void setWindowAlpha(float alpha) override;
+        void setWindowColorKey(const std::optional<Color>& color) override;
+        iRect windowRect() override;
+        iRect clientRect() override;
+
+        iSize screenSize() override;
+        iRect workArea() override;
+        int dpi() override;
+        iPoint cursorPosition() override;
+        bool showCursor(bool show) override;
+
+        bool pollMouse(MouseMessage& msg) override;
+        bool pollKey(KeyMessage& msg) override;
+        bool hasMouse() override;
+        bool hasKey() override;
+
+        PixelMap* screen() override;
+        void clear() override;
+        void clear(const iRect& rect) override;
+        void present(const DamageRegion* damage = nullptr) override;
+    };
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <GraceFt/Color.h>
+#include <GraceFt/PixelView.hpp>
+#include <GraceFt/ThreadPool.h>
+
+namespace GFt {
+    /// @defgroup 图像处理
+    /// @details 此部分函数在头文件 ImageOps.h 中定义，作用于像素视图，可通过 PixelMap::view() 获取
+    /// @details 图像按行划分后由线程池并行处理，支持 SSE2 时每次处理 4 个像素或 4 个通道；
+    ///          较小的图像只划分为少量任务，调用线程也会参与执行
+    /// @ingroup 工具集
+
+    /// @brief 图像处理函数
+    /// @details 除 convert() 外只接受每像素 4 字节的格式，透明度位于每个像素的最后一个字节，
+    ///          因此 BGRA8 与 RGBA8 均可使用，结果保持原有的通道顺序
+    /// @details 尺寸或格式不符合要求时抛出 std::invalid_argument
+    /// @ingroup 图像处理
+    namespace ImageOps {
+        /// @brief 缩放时使用的滤波器
+        enum class Filter {
+            Bilinear,   ///< 双线性插值，适合放大或小幅缩小
+            Box,        ///< 按面积平均，适合生成缩略图等大幅缩小
+        };
+
+        /// @brief 将颜色通道乘以透明度，转换为预乘透明度的图像
+        /// @param image 图像
+        /// @param pool 线程池
+        void premultiply(PixelView image, ThreadPool& pool = ThreadPool::getInstance());
+        /// @brief 将预乘透明度的图像还原
+        /// @details 完全透明的像素还原为黑色
+        /// @param image 图像
+        /// @param pool 线程池
+        void unpremultiply(PixelView image, ThreadPool& pool = ThreadPool::getInstance());
+        /// @brief 将预乘透明度的图像以 source-over 方式混合到目标上
+        /// @details 各通道为 src * k + dst * (1 - src.a * k)，k 为 opacity / 255；
+        ///          目标也应为预乘透明度的图像，不透明的目标两者没有区别
+        /// @param dst 目标图像
+        /// @param src 源图像，尺寸应与目标相同，格式应与目标相同
+        /// @param opacity 整体不透明度，0~255
+        /// @param pool 线程池
+        void blend(PixelView dst, ConstPixelView src, int opacity = 255, ThreadPool& pool = ThreadPool::getInstance());
+        /// @brief 将颜色接近指定颜色的像素设置为完全透明
+        /// @details 匹配的像素被置为 0，即预乘透明度下的完全透明
+        /// @param image 图像，格式为 BGRA8 或 RGBA8
+        /// @param key 关键色，忽略其透明度
+        /// @param tolerance 每个颜色通道允许的差值
+        /// @param pool 线程池
+        void removeColorKey(PixelView image, const Color& key, int tolerance = 0,
+            ThreadPool& pool = ThreadPool::getInstance());
+        /// @brief 转换像素格式
+        /// @details 转换为灰度时使用 (77R + 150G + 29B) / 256，与 BasicPixelView::setPixel() 相同；
+        ///          由灰度转换时各颜色通道等于灰度，图像不透明；格式相同时直接复制
+        /// @param src 源图像
+        /// @param dst 目标图像，尺寸应与源图像相同
+        /// @param pool 线程池
+        void convert(ConstPixelView src, PixelView dst, ThreadPool& pool = ThreadPool::getInstance());
+        /// @brief 缩放图像
+        /// @details 将源图像缩放到目标图像的尺寸，超出边界的采样取边缘像素；
+        ///          应对预乘透明度的图像缩放，以免透明像素的颜色渗入边缘
+        /// @param src 源图像
+        /// @param dst 目标图像，格式应与源图像相同
+        /// @param filter 滤波器
+        /// @param pool 线程池
+        void resize(ConstPixelView src, PixelView dst, Filter filter = Filter::Bilinear,
+            ThreadPool& pool = ThreadPool::getInstance());
+        /// @brief 高斯模糊
+        /// @details 先纵向后横向分两次卷积，卷积核半径为 3σ，超出边界的采样取边缘像素；
+        ///          应对预乘透明度的图像模糊，常用于绘制阴影
+        /// @param src 源图像
+        /// @param dst 目标图像，尺寸与格式应与源图像相同，且不能与源图像重叠
+        /// @param sigma 标准差，不大于 0 时直接复制
+        /// @param pool 线程池
+        void gaussianBlur(ConstPixelView src, PixelView dst, float sigma, ThreadPool& pool = ThreadPool::getInstance());
+        /// @brief 原地高斯模糊
+        /// @details 先将图像复制到临时缓冲区
+        /// @param image 图像
+        /// @param sigma 标准差
+        /// @param pool 线程池
+        void gaussianBlur(PixelView image, float sigma, ThreadPool& pool = ThreadPool::getInstance());
+    }
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <utility>
+#include <_private.inl>
+
+namespace GFt {
+    /// @brief 多生产者单消费者无锁通道
+    /// @tparam T 通道中元素的类型，允许为仅可移动的类型
+    /// @ingroup 糖衣工具
+    /// @details 接口与 Channel 相同，允许任意多个线程发送，但只允许一个线程接收；
+    ///          元素存放在构造时一次性分配的环形缓冲区中，每个槽位带有序号，
+    ///          生产者通过 CAS 竞争写入位置，收发过程不加锁也不分配内存
+    /// @note 阻塞的 send() / recv() 先短暂自旋，之后在槽位序号上休眠等待；
+    ///       槽位记录是否有线程在其上休眠，没有线程休眠时收发不会发出唤醒
+    /// @see Channel SpscChannel
+    template<typename T>
+    class MpscChannel {
+        static constexpr std::size_t cl_ = _GFt_private_::_cache_line;
+        static constexpr int spin_ = 64;
+
+        struct Cell {
+            std::atomic<std::size_t> seq;
+            std::atomic<bool> waiting;
+            alignas(T) unsigned char data[sizeof(T)];
+        };
+        std::size_t mask_;
+        std::unique_ptr<Cell[]> cells_;
+        // 消费者独占
+        alignas(cl_) std::size_t head_ = 0;
+        // 生产者共享
+        alignas(cl_) std::atomic<std::size_t> tail_ = 0;
+
+        MpscChannel(const MpscChannel&) = delete;
+        MpscChannel& operator=(const MpscChannel&) = delete;
+        MpscChannel(MpscChannel&&) = delete;
+        MpscChannel& operator=(MpscChannel&&) = delete;
+
+        static std::size_t roundUp(std::size_t n) {
+            std::size_t result = 1;
+            while (result < n)
+                result <<= 1;
+            return result;
+        }
+        // 先声明正在等待再休眠，与 wake() 中的栅栏配对：
+        // 要么唤醒方看到等待标记，要么 wait() 看到槽位的新序号而不休眠
+        // 同一槽位上可能有多个线程休眠，等待标记只由唤醒方清除
+        static void sleep(Cell& cell, std::size_t seq) {
+            cell.waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            cell.seq.wait(seq, std::memory_order_acquire);
+        }
+        static void wake(Cell& cell) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // 同一槽位上可能同时有消费者与等待空位的生产者
+            if (cell.waiting.load(std::memory_order_relaxed) && cell.waiting.exchange(false, std::memory_order_relaxed))
+                cell.seq.notify_all();
+        }
+        // 抢占一个可写入的槽位，通道满时返回 nullptr 并通过 seq 返回槽位当前序号
+        Cell* claim(std::size_t& pos, std::size_t& seq) {
+            pos = tail_.load(std::memory_order_relaxed);
+            while (true) {
+                Cell& cell = cells_[pos & mask_];
+                seq = cell.seq.load(std::memory_order_acquire);
+                auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        return &cell;
+                }
+                else if (diff < 0)
+                    return nullptr;
+                else
+                    pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        template<typename U>
+        static void publish(Cell* cell, std::size_t pos, U&& data) {
+            ::new (static_cast<void*>(cell->data)) T(std::forward<U>(data));
+            cell->seq.store(pos + 1, std::memory_order_release);
+            wake(*cell);
+        }
+        template<typename U>
+        bool trySendImpl(U&& data) {
+            std::size_t pos, seq;
+            Cell* cell = claim(pos, seq);
+            if (!cell)
+                return false;
+            publish(cell, pos, std::forward<U>(data));
+            return true;
+        }
+        template<typename U>
+        void sendImpl(U&& data) {
+            std::size_t pos, seq;
+            for (int i = 0;; ++i) {
+                if (Cell* cell = claim(pos, seq))
+                    return publish(cell, pos, std::forward<U>(data));
+                // 通道满，等待消费者释放该槽位
+                if (i >= spin_)
+                    sleep(cells_[pos & mask_], seq);
+            }
+        }
+        T take(Cell& cell) {
+            T* ptr = std::launder(reinterpret_cast<T*>(cell.data));
+            T data = std::move(*ptr);
+            ptr->~T();
+            cell.seq.store(head_ + mask_ + 1, std::memory_order_release);
+            wake(cell);
+            ++head_;
+            return data;
+        }
+    public:
+        /// @brief 构造函数
+        /// @param capacity 通道的容量，会向上取整为2的幂，默认为1024
+        MpscChannel(std::size_t capacity = 1024ull)
+            : mask_(roundUp(capacity == 0 ? 1 : capacity) - 1),
+            cells_(new Cell[mask_ + 1]) {
+            for (std::size_t i = 0; i <= mask_; ++i) {
+                cells_[i].seq.store(i, std::memory_order_relaxed);
+                cells_[i].waiting.store(false, std::memory_order_relaxed);
+            }
+        }
+        ~MpscChannel() {
+            while (true) {
+                Cell& cell = cells_[head_ & mask_];
+                if (cell.seq.load(std::memory_order_acquire) != head_ + 1)
+                    break;
+                take(cell);
+            }
+        }
+
+        /// @brief 发送数据到通道
+        /// @param data 要发送的数据
+        /// @details 若通道已满，则线程会被阻塞，直到有空余位置
+        void send(const T& data) { sendImpl(data); }
+        /// @brief 发送数据到通道
+        /// @see send()
+        void send(T&& data) { sendImpl(std::move(data)); }
+        /// @brief 尝试发送数据到通道
+        /// @param data 要发送的数据
+        /// @return 若成功发送，则返回true，否则返回false
+        bool try_send(const T& data) { return trySendImpl(data); }
+        /// @brief 尝试发送数据到通道
+        /// @note 发送失败时 data 不会被移动
+        /// @see try_send()
+        bool try_send(T&& data) { return trySendImpl(std::move(data)); }
+        /// @brief 从通道接收数据
+        /// @return 接收到的数据
+        /// @details 若通道为空，则线程会被阻塞，直到有数据到来
+        /// @note 只允许单个线程调用
+        T recv() {
+            Cell& cell = cells_[head_ & mask_];
+            for (int i = 0;; ++i) {
+                auto seq = cell.seq.load(std::memory_order_acquire);
+                if (seq == head_ + 1)
+                    break;
+                if (i >= spin_)
+                    sleep(cell, seq);
+            }
+            return take(cell);
+        }
+        /// @brief 尝试从通道接收数据
+        /// @param data 接收到的数据
+        /// @return 若成功接收，则返回true，否则返回false
+        /// @note 只允许单个线程调用
+        bool try_recv(T& data) {
+            Cell& cell = cells_[head_ & mask_];
+            if (cell.seq.load(std::memory_order_acquire) != head_ + 1)
+                return false;
+            data = take(cell);
+            return true;
+        }
+        /// @brief 获取通道的容量
+        std::size_t capacity() const { return mask_ + 1; }
+    };
+}
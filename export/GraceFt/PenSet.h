@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include <GraceFt/Color.h>
 
 namespace GFt {
@@ -54,6 +56,7 @@ namespace GFt {
     class PenSet {
         friend class Graphics;
         void* pen_;
+        std::uint64_t version_;
     public:
         /// @brief 构造函数
         /// @param color 画笔颜色
@@ -119,5 +122,9 @@ namespace GFt {
         /// @brief 获取接点样式
         /// @return 接点样式
         JoinStyle getJoinStyle() const;
+        /// @brief 获取版本号
+        /// @details 每次修改后改变，且不同对象的版本号互不相同，
+        ///          Graphics 据此跳过对同一状态的重复绑定
+        std::uint64_t version() const;
     };
 }
\ No newline at end of file
@@ -1,18 +1,32 @@
 #pragma once
 
 #include <string>
+#include <memory>
+#include <cstdint>
 
 #include <GraceFt/Size.hpp>
 #include <GraceFt/Rect.hpp>
+#include <GraceFt/PixelView.hpp>
 
 namespace GFt {
     /// @class PixelMap
     /// @brief 位图类
+    /// @details 复制位图时只共享像素，直到其中一方被修改时才复制，因此可以廉价地按值传递；
+    ///          作为 Graphics 绘图目标的位图在复制时总是立即复制像素，以免之后的绘制影响副本；
+    ///          交出过可写视图的位图同样如此，直到其像素被替换
+    /// @details 通过 view() 可以直接读写像素
     /// @ingroup 接口类型
     class PixelMap {
         friend class Graphics;
         friend class Texture;
+        friend class Block;
         void* pixmap_;
+        std::shared_ptr<void> image_;   // 持有 pixmap_，被多个位图共享时写入前需要 detach()
+        int painters_ = 0;              // 以此位图为绘图目标的 Graphics 数量
+        bool viewed_ = false;           // 当前像素是否交出过可写视图，为真时复制位图需要复制像素
+        std::uint64_t bound_[3] = {};   // 由 Graphics 记录的作用于此位图的画笔、画刷与文字配置的版本号，0 表示未知
+        void adopt(void* image);
+        void detach();
     public:
         /// @brief 构造函数
         /// @param size 位图大小
@@ -24,9 +38,28 @@ namespace GFt {
         ~PixelMap();
 
         /// @brief 从当前位图中裁剪出一个新的位图
+        /// @details 裁剪出的位图持有像素的副本，只需访问部分区域时应使用 view(const iRect&)
         /// @param rect 裁剪区域
         /// @return 裁剪出的位图
         PixelMap clip(const iRect& rect) const;
+        /// @brief 获取可写的像素视图
+        /// @details 像素与其它位图共享时先复制一份，视图在位图被修改、复制赋值或析构之前有效；
+        ///          之后复制此位图时总是复制像素，通过视图写入不会影响副本
+        /// @return 格式为 PixelFormat::BGRA8 的视图
+        PixelView view();
+        /// @brief 获取只读的像素视图
+        /// @return 格式为 PixelFormat::BGRA8 的视图
+        ConstPixelView view() const;
+        /// @brief 获取部分区域的可写像素视图，不复制像素
+        /// @param rect 区域，会被限制在位图范围内
+        /// @return 子视图
+        PixelView view(const iRect& rect);
+        /// @brief 获取部分区域的只读像素视图，不复制像素
+        /// @param rect 区域，会被限制在位图范围内
+        /// @return 子视图
+        ConstPixelView view(const iRect& rect) const;
+        /// @brief 像素是否与其它位图共享
+        bool isShared() const;
         /// @brief 获取位图大小
         /// @return 位图大小
         iSize size() const;
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <GraceFt/Color.h>
+#include <GraceFt/Size.hpp>
+#include <GraceFt/Rect.hpp>
+
+namespace GFt {
+    /// @brief 像素格式
+    /// @details 名称按像素在内存中的字节顺序排列
+    /// @ingroup 复合数据类型
+    enum class PixelFormat : std::uint8_t {
+        BGRA8,  ///< 每像素 4 字节，与 EGE 位图及 0xAARRGGBB 整数在小端机器上的布局相同
+        RGBA8,  ///< 每像素 4 字节，常见于图像文件与纹理上传
+        Gray8,  ///< 每像素 1 字节的灰度
+    };
+    /// @brief 获取像素格式每个像素的字节数
+    /// @param format 像素格式
+    /// @return 每个像素的字节数
+    constexpr int bytesPerPixel(PixelFormat format) {
+        return format == PixelFormat::Gray8 ? 1 : 4;
+    }
+
+    /// @class BasicPixelView
+    /// @brief 像素缓冲区视图
+    /// @details 由首像素指针、宽高、行跨度与像素格式描述一块像素，不持有内存，
+    ///          复制视图或取子视图都不会复制像素
+    /// @details 行跨度以字节为单位，可以大于一行像素的字节数，子视图与其所属的视图使用相同的行跨度
+    /// @note 视图只在其指向的缓冲区有效期间有效，对于 PixelMap，参见 PixelMap::view()
+    /// @tparam Byte std::uint8_t 或 const std::uint8_t，分别对应可写与只读的视图
+    /// @ingroup 复合数据类型
+    template<typename Byte>
+        requires std::is_same_v<std::remove_const_t<Byte>, std::uint8_t>
+    class BasicPixelView {
+        Byte* data_ = nullptr;
+        int width_ = 0, height_ = 0;
+        std::ptrdiff_t stride_ = 0;
+        PixelFormat format_ = PixelFormat::BGRA8;
+
+        template<typename Other>
+            requires std::is_same_v<std::remove_const_t<Other>, std::uint8_t>
+        friend class BasicPixelView;
+        static constexpr bool writable = !std::is_const_v<Byte>;
+        using Pixel = std::conditional_t<writable, std::uint32_t, const std::uint32_t>;
+
+    public:
+        /// @brief 构造空视图
+        constexpr BasicPixelView() = default;
+        /// @brief 构造函数
+        /// @param data 首像素的地址
+        /// @param width 宽度
+        /// @param height 高度
+        /// @param stride 相邻两行首像素之间的字节数
+        /// @param format 像素格式
+        constexpr BasicPixelView(Byte* data, int width, int height, std::ptrdiff_t stride,
+            PixelFormat format = PixelFormat::BGRA8)
+            : data_(data), width_(data ? width : 0), height_(data ? height : 0), stride_(stride), format_(format) {}
+        /// @brief 由可写视图构造只读视图
+        template<typename Other>
+            requires (!writable && std::is_same_v<Other, std::uint8_t>)
+        constexpr BasicPixelView(const BasicPixelView<Other>& other)
+            : data_(other.data_), width_(other.width_), height_(other.height_),
+            stride_(other.stride_), format_(other.format_) {}
+
+        /// @return 首像素的地址
+        constexpr Byte* data() const { return data_; }
+        /// @return 宽度
+        constexpr int width() const { return width_; }
+        /// @return 高度
+        constexpr int height() const { return height_; }
+        /// @return 尺寸
+        constexpr iSize size() const { return iSize(width_, height_); }
+        /// @return 相邻两行首像素之间的字节数
+        constexpr std::ptrdiff_t stride() const { return stride_; }
+        /// @return 像素格式
+        constexpr PixelFormat format() const { return format_; }
+        /// @return 每个像素的字节数
+        constexpr int bytesPerPixel() const { return GFt::bytesPerPixel(format_); }
+        /// @brief 是否不包含任何像素
+        constexpr bool empty() const { return width_ <= 0 || height_ <= 0; }
+        /// @brief 每行像素是否首尾相连，即可以把整个视图当作一段连续内存处理
+        constexpr bool contiguous() const { return stride_ == static_cast<std::ptrdiff_t>(width_) * bytesPerPixel(); }
+
+        /// @brief 获取一行像素的首地址
+        /// @param y 行号
+        constexpr Byte* row(int y) const { return data_ + y * stride_; }
+        /// @brief 以 32 位整数获取一行像素的首地址
+        /// @details 仅适用于每像素 4 字节的格式，BGRA8 格式下每个整数为 0xAARRGGBB
+        /// @param y 行号
+        Pixel* pixels(int y) const { return reinterpret_cast<Pixel*>(row(y)); }
+
+        /// @brief 获取像素的颜色
+        /// @details 不检查坐标是否越界
+        /// @param x 横坐标
+        /// @param y 纵坐标
+        /// @return 像素的颜色，灰度格式下不透明
+        constexpr Color pixel(int x, int y) const {
+            auto p = row(y) + x * bytesPerPixel();
+            switch (format_) {
+            case PixelFormat::BGRA8:
+                return Color(p[2], p[1], p[0], p[3]);
+            case PixelFormat::RGBA8:
+                return Color(p[0], p[1], p[2], p[3]);
+            default:
+                return Color(p[0], p[0], p[0]);
+            }
+        }
+        /// @brief 设置像素的颜色
+        /// @details 不检查坐标是否越界，灰度格式下写入颜色的亮度
+        /// @param x 横坐标
+        /// @param y 纵坐标
+        /// @param color 新的颜色
+        constexpr void setPixel(int x, int y, const Color& color) const
+            requires writable {
+            auto p = row(y) + x * bytesPerPixel();
+            switch (format_) {
+            case PixelFormat::BGRA8:
+                p[0] = color.blue(), p[1] = color.green(), p[2] = color.red(), p[3] = color.alpha();
+                break;
+            case PixelFormat::RGBA8:
+                p[0] = color.red(), p[1] = color.green(), p[2] = color.blue(), p[3] = color.alpha();
+                break;
+            default:
+                p[0] = static_cast<std::uint8_t>((color.red() * 77 + color.green() * 150 + color.blue() * 29) >> 8);
+                break;
+            }
+        }
+
+        /// @brief 获取子视图
+        /// @details 区域会被限制在视图范围内，子视图与当前视图共享像素
+        /// @param rect 子视图在当前视图中的区域
+        /// @return 子视图，区域与视图不相交时为空视图
+        constexpr BasicPixelView sub(const iRect& rect) const {
+            auto left = std::clamp(rect.left(), 0, width_), top = std::clamp(rect.top(), 0, height_);
+            auto right = std::clamp(rect.right(), left, width_), bottom = std::clamp(rect.bottom(), top, height_);
+            if (right == left || bottom == top)
+                return BasicPixelView(nullptr, 0, 0, stride_, format_);
+            return BasicPixelView(row(top) + left * bytesPerPixel(), right - left, bottom - top, stride_, format_);
+        }
+    };
+    /// @brief 可写的像素视图
+    /// @ingroup 复合数据类型
+    using PixelView = BasicPixelView<std::uint8_t>;
+    /// @brief 只读的像素视图
+    /// @ingroup 复合数据类型
+    using ConstPixelView = BasicPixelView<const std::uint8_t>;
+}
@@ -3,16 +3,58 @@
 #include <unordered_map>
 #include <functional>
 #include <concepts>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <queue>
+#include <deque>
+#include <array>
 
 namespace GFt {
     /// @brief 计划刻事件管理器
     /// @details 它可以将一系列的计划刻事件添加到计划中，并在特定时刻统一执行这些计划事件，
     ///          计划事件的执行顺序与添加的顺序相同，计划刻事件会在每一帧 onEventCall
-    ///          信号被触发时调用，且每个计划刻事件只会被调用一次
+    ///          信号被触发时调用，且每个计划刻事件只会被调用一次(重复计划事件除外)
+    /// @details 延时计划事件按截止时间存放在最小堆中，每一帧只会处理已到期的事件，
+    ///          未到期的事件不产生任何开销
+    /// @details 设置每帧时间预算后，立即计划事件会按优先级执行，直到用尽本帧预算，
+    ///          剩余事件顺延到下一帧，从而避免大量事件集中在同一帧执行造成卡顿
+    /// @see setFrameBudget()
     class PlanEvent {
+    public:
+        /// @brief 计划事件优先级
+        enum class Priority {
+            High,       ///< 高优先级，不受时间预算限制，总会在下一帧执行
+            Normal,     ///< 普通优先级
+            Low,        ///< 低优先级，仅在普通优先级事件全部执行完后执行
+            Idle,       ///< 空闲事件，仅在其它事件全部执行完且本帧仍有剩余预算时执行
+        };
+
+    private:
         using PlanFunc = std::function<void()>;
+        using Clock = std::chrono::steady_clock;
+        struct Timer {
+            Clock::time_point deadline;
+            std::size_t id;
+            bool operator>(const Timer& other) const {
+                return deadline != other.deadline ? deadline > other.deadline : id > other.id;
+            }
+        };
+        struct TimedEvent {
+            PlanFunc func;
+            Clock::duration interval;   // 为零表示只执行一次
+        };
+        struct CondEvent {
+            std::size_t id;
+            std::function<bool()> condition;
+            PlanFunc func;
+        };
         static std::size_t nextId_;
-        std::unordered_map<std::size_t, PlanFunc> planEvents_;
+        std::array<std::deque<std::pair<std::size_t, PlanFunc>>, 4> planEvents_;
+        Clock::duration frameBudget_ = Clock::duration::zero();
+        std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+        std::unordered_map<std::size_t, TimedEvent> timedEvents_;
+        std::vector<std::unique_ptr<CondEvent>> condEvents_;
 
         PlanEvent() = default;
         PlanEvent(const PlanEvent&) = delete;
@@ -20,14 +62,16 @@ namespace GFt {
         PlanEvent& operator=(const PlanEvent&) = delete;
         PlanEvent& operator=(PlanEvent&&) = delete;
 
-        std::size_t addPlanEvent_(float after, const PlanFunc& planEvent);
-        std::size_t addPlanEvent_(const PlanFunc& planEvent);
+        std::size_t addPlanEvent_(float after, float interval, const PlanFunc& planEvent);
+        std::size_t addPlanEvent_(const PlanFunc& planEvent, Priority priority);
         std::size_t addPlanEvent_(const std::function<bool()>& condition, const PlanFunc& planEvent);
-        std::size_t reAddPlanEvent_(std::size_t id, const PlanFunc& planEvent);
         void removePlanEvent_(std::size_t id);
         static PlanEvent& getInstance();
     private:
         void executePlanEvents();
+        void executeQueued(Clock::time_point start);
+        void executeTimers(Clock::time_point now);
+        void executeConditions();
 
     public:
         /// @brief 添加立即执行计划事件
@@ -35,6 +79,14 @@ namespace GFt {
         /// @return 计划事件ID
         static std::size_t add(const PlanFunc& planEvent);
 
+        /// @brief 添加指定优先级的立即执行计划事件
+        /// @param planEvent 计划事件函数
+        /// @param priority 计划事件优先级
+        /// @details 未设置时间预算时，除空闲事件外的所有事件都会在下一帧按优先级依次执行；
+        ///          设置时间预算后，事件可能被顺延到之后的帧，但同一优先级内的执行顺序不变
+        /// @return 计划事件ID
+        static std::size_t add(const PlanFunc& planEvent, Priority priority);
+
         /// @brief 添加延时执行计划事件
         /// @param after 计划事件延迟执行时间（单位：毫秒）
         /// @param planEvent 计划事件函数
@@ -46,11 +98,33 @@ namespace GFt {
         /// @param condition 计划事件条件函数
         /// @param planEvent 计划事件函数
         /// @details 计划事件会在 condition 函数返回 true 时执行
+        /// @note 条件函数会在每一帧被调用，直到其返回 true 或事件被移除
         /// @return 计划事件ID
         static std::size_t add(const std::function<bool()>& condition, const PlanFunc& planEvent);
 
+        /// @brief 添加重复执行计划事件
+        /// @param interval 执行间隔（单位：毫秒）
+        /// @param planEvent 计划事件函数
+        /// @details 计划事件会每隔至少 interval 毫秒执行一次，直到被移除；
+        ///          若某一帧耗时过长错过了多次执行，也只会补执行一次
+        /// @return 计划事件ID
+        static std::size_t repeat(float interval, const PlanFunc& planEvent);
+
         /// @brief 移除计划事件
         /// @param id 计划事件ID
+        /// @details 可用于移除任意种类的计划事件，包括在计划事件函数中移除自身
         static void remove(std::size_t id);
+
+        /// @brief 设置每帧执行立即计划事件的时间预算
+        /// @param ms 时间预算（单位：毫秒），为0时不限制(默认)
+        /// @details 每帧从高优先级开始依次执行立即计划事件，高优先级事件总会被执行，
+        ///          其余事件在累计耗时超过预算后顺延到下一帧，但每帧至少会执行一个事件以保证进度；
+        ///          空闲事件仅在其它事件全部执行完毕后，利用本帧剩余的预算执行
+        /// @note 延时、重复与条件计划事件在到期时立即执行，不受预算限制
+        /// @note 在计划事件执行期间添加的立即计划事件总是留到下一帧执行
+        static void setFrameBudget(float ms);
+
+        /// @brief 获取每帧执行立即计划事件的时间预算（单位：毫秒）
+        static float getFrameBudget();
     };
-}
\ No newline at end of file
+}
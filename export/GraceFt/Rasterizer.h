@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <GraceFt/Color.h>
+#include <GraceFt/Point.hpp>
+#include <GraceFt/Rect.hpp>
+
+namespace GFt {
+    /// @class Rasterizer
+    /// @brief 软件光栅化器
+    /// @details 将由直线段组成的路径填充到 32 位像素缓冲区中，像素格式为 0xAARRGGBB(与 EGE 的 color_t 相同)
+    /// @details 逐行只处理与该行相交的边：抗锯齿时按边在每个像素内扫过的有符号面积累加覆盖率(解析抗锯齿)，
+    ///          只访问被边经过的像素，其间覆盖率恒定的区间整段填充或混合；
+    ///          不抗锯齿时按像素中心计算与边的交点；支持 SSE2 时每次混合 4 个像素
+    /// @details 抗锯齿时非零环绕规则取覆盖率的绝对值并限制在 1 以内，奇偶规则将其按周期 2 折回 [0, 1]，
+    ///          对于自相交的边界附近的像素是近似值
+    /// @details 混合使用非预乘的 source-over：各通道为 dst + (src - dst) * a，透明度为 a + dst.a * (1 - a)，
+    ///          其中 a 为颜色的透明度与覆盖率之积
+    /// @ingroup 接口类型
+    class Rasterizer {
+    public:
+        /// @brief 填充规则
+        enum class FillRule {
+            NonZero,    ///< 非零环绕
+            EvenOdd,    ///< 奇偶
+        };
+
+    private:
+        struct Edge {
+            float x0, y0, x1, y1;   // y0 < y1
+            float dxdy;
+            float dir;              // 原方向向下为 1，向上为 -1
+        };
+        std::uint32_t* pixels_ = nullptr;
+        int width_ = 0;
+        int height_ = 0;
+        int stride_ = 0;
+        iRect clip_;
+        bool antiAliasing_ = true;
+
+        std::vector<Edge> edges_;
+        fPoint start_;
+        fPoint current_;
+        bool open_ = false;
+
+        std::vector<float> cells_;
+        std::vector<int> touched_;
+        std::vector<const Edge*> active_;
+        std::vector<std::pair<float, float>> crossings_;
+
+        void addEdge(const fPoint& from, const fPoint& to);
+        void fillAntiAliased(const iRect& area, std::uint32_t color, FillRule rule);
+        void fillAliased(const iRect& area, std::uint32_t color, FillRule rule);
+
+    public:
+        Rasterizer() = default;
+
+        /// @brief 设置绘制目标
+        /// @param pixels 像素缓冲区
+        /// @param width 宽度
+        /// @param height 高度
+        /// @param stride 相邻两行起始像素之间的像素数
+        /// @details 同时将裁剪区域重置为整个缓冲区
+        void setTarget(std::uint32_t* pixels, int width, int height, int stride);
+        /// @brief 设置裁剪区域
+        /// @param clip 裁剪矩形，会被限制在缓冲区范围内
+        void setClip(const iRect& clip);
+        /// @brief 设置是否抗锯齿
+        void setAntiAliasing(bool enable);
+
+        /// @brief 清除当前路径
+        void reset();
+        /// @brief 开始新的子路径
+        /// @details 若上一个子路径未闭合，则自动闭合
+        void moveTo(const fPoint& p);
+        /// @brief 向当前子路径添加直线段
+        void lineTo(const fPoint& p);
+        /// @brief 闭合当前子路径
+        void close();
+        /// @brief 添加一个闭合的多边形子路径
+        void addPolygon(const fPoint* points, std::size_t count);
+
+        /// @brief 以指定颜色和规则填充当前路径
+        /// @details 路径在填充后保留，可以更换裁剪区域后再次填充
+        void fill(const Color& color, FillRule rule = FillRule::NonZero);
+    };
+}
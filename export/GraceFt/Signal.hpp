@@ -70,6 +70,12 @@ namespace GFt {
             if (slots_.find(id) != slots_.end())
                 slots_.erase(id);
         }
+        /// @brief 判断是否没有连接任何槽函数
+        /// @details 可用于在高频路径上跳过无人监听的信号发送
+        bool empty() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return slots_.empty();
+        }
         /// @brief 发送信号
         /// @param args 信号参数
         /// @note 调用槽函数时不保证调用顺序与连接顺序一致
@@ -143,6 +149,11 @@ namespace GFt {
             if (slots_.find(id) != slots_.end())
                 slots_.erase(id);
         }
+        /// @brief 判断是否没有连接任何槽函数
+        bool empty() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return slots_.empty();
+        }
         /// @brief 发送信号
         void emit() {
             Slots slots;
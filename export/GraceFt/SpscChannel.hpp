@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <new>
+#include <thread>
+#include <utility>
+#include <_private.inl>
+
+namespace GFt {
+    /// @brief 单生产者单消费者无锁通道
+    /// @tparam T 通道中元素的类型，允许为仅可移动的类型
+    /// @tparam N 通道的容量，必须为2的幂
+    /// @ingroup 糖衣工具
+    /// @details 接口与 Channel 相同，但只允许一个线程发送、一个线程接收；
+    ///          元素存放在对象内部的定长环形缓冲区中，收发过程不加锁也不分配内存
+    /// @note 阻塞的 send() / recv() 先短暂自旋，之后在原子变量上休眠等待；
+    ///       双方各自记录是否正在休眠，对端只在有线程休眠时才发出唤醒
+    /// @see Channel
+    template<typename T, std::size_t N>
+    class SpscChannel {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "SpscChannel capacity must be a power of 2");
+        static constexpr std::size_t mask_ = N - 1;
+        static constexpr std::size_t cl_ = _GFt_private_::_cache_line;
+        static constexpr int spin_ = 64;
+
+        // 消费者写入
+        alignas(cl_) std::atomic<std::size_t> head_ = 0;
+        std::size_t cachedTail_ = 0;
+        std::atomic<bool> consumerWaiting_ = false;
+        // 生产者写入
+        alignas(cl_) std::atomic<std::size_t> tail_ = 0;
+        std::size_t cachedHead_ = 0;
+        std::atomic<bool> producerWaiting_ = false;
+        alignas(cl_) unsigned char buffer_[N][sizeof(T)];
+
+        SpscChannel(const SpscChannel&) = delete;
+        SpscChannel& operator=(const SpscChannel&) = delete;
+        SpscChannel(SpscChannel&&) = delete;
+        SpscChannel& operator=(SpscChannel&&) = delete;
+
+        // 先声明正在等待再休眠，与 wake() 中的栅栏配对：
+        // 要么对端看到等待标记并唤醒，要么 wait() 看到对端写入的新值而不休眠
+        static void sleep(std::atomic<bool>& waiting, std::atomic<std::size_t>& index, std::size_t old) {
+            waiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            index.wait(old, std::memory_order_acquire);
+        }
+        // 由唤醒方清除等待标记，被唤醒的线程真正运行之前不会重复唤醒
+        static void wake(std::atomic<bool>& waiting, std::atomic<std::size_t>& index) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting.load(std::memory_order_relaxed) && waiting.exchange(false, std::memory_order_relaxed))
+                index.notify_one();
+        }
+        T* at(std::size_t index) {
+            return std::launder(reinterpret_cast<T*>(buffer_[index & mask_]));
+        }
+        template<typename U>
+        bool trySendImpl(U&& data) {
+            auto tail = tail_.load(std::memory_order_relaxed);
+            if (tail - cachedHead_ == N) {
+                cachedHead_ = head_.load(std::memory_order_acquire);
+                if (tail - cachedHead_ == N)
+                    return false;
+            }
+            ::new (static_cast<void*>(buffer_[tail & mask_])) T(std::forward<U>(data));
+            tail_.store(tail + 1, std::memory_order_release);
+            wake(consumerWaiting_, tail_);
+            return true;
+        }
+        template<typename U>
+        void sendImpl(U&& data) {
+            for (int i = 0; !trySendImpl(std::forward<U>(data)); ++i) {
+                if (i < spin_)
+                    continue;
+                // 通道满，等待消费者移动 head_
+                auto head = head_.load(std::memory_order_acquire);
+                if (tail_.load(std::memory_order_relaxed) - head == N)
+                    sleep(producerWaiting_, head_, head);
+            }
+        }
+    public:
+        SpscChannel() = default;
+        ~SpscChannel() {
+            auto tail = tail_.load(std::memory_order_acquire);
+            for (auto head = head_.load(); head != tail; ++head)
+                at(head)->~T();
+        }
+
+        /// @brief 发送数据到通道
+        /// @param data 要发送的数据
+        /// @details 若通道已满，则线程会被阻塞，直到有空余位置
+        void send(const T& data) { sendImpl(data); }
+        /// @brief 发送数据到通道
+        /// @see send()
+        void send(T&& data) { sendImpl(std::move(data)); }
+        /// @brief 尝试发送数据到通道
+        /// @param data 要发送的数据
+        /// @return 若成功发送，则返回true，否则返回false
+        bool try_send(const T& data) { return trySendImpl(data); }
+        /// @brief 尝试发送数据到通道
+        /// @note 发送失败时 data 不会被移动
+        /// @see try_send()
+        bool try_send(T&& data) { return trySendImpl(std::move(data)); }
+        /// @brief 从通道接收数据
+        /// @return 接收到的数据
+        /// @details 若通道为空，则线程会被阻塞，直到有数据到来
+        T recv() {
+            auto head = head_.load(std::memory_order_relaxed);
+            for (int i = 0; head == cachedTail_; ++i) {
+                cachedTail_ = tail_.load(std::memory_order_acquire);
+                if (head != cachedTail_ || i < spin_)
+                    continue;
+                sleep(consumerWaiting_, tail_, head);
+            }
+            T* ptr = at(head);
+            T data = std::move(*ptr);
+            ptr->~T();
+            head_.store(head + 1, std::memory_order_release);
+            wake(producerWaiting_, head_);
+            return data;
+        }
+        /// @brief 尝试从通道接收数据
+        /// @param data 接收到的数据
+        /// @return 若成功接收，则返回true，否则返回false
+        bool try_recv(T& data) {
+            auto head = head_.load(std::memory_order_relaxed);
+            if (head == cachedTail_) {
+                cachedTail_ = tail_.load(std::memory_order_acquire);
+                if (head == cachedTail_)
+                    return false;
+            }
+            T* ptr = at(head);
+            data = std::move(*ptr);
+            ptr->~T();
+            head_.store(head + 1, std::memory_order_release);
+            wake(producerWaiting_, head_);
+            return true;
+        }
+        /// @brief 获取通道中当前元素的数量
+        /// @note 返回值只是调用时刻的近似值
+        std::size_t size() const {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+        }
+        /// @brief 获取通道的容量
+        static constexpr std::size_t capacity() { return N; }
+    };
+}
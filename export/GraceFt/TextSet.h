@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include <GraceFt/Font.h>
 #include <GraceFt/Color.h>
 
@@ -13,6 +15,7 @@ namespace GFt {
         Font font_;
         unsigned int color_;
         bool transparent_ = false;
+        std::uint64_t version_;
     public:
         /// @brief 构造函数
         /// @param color 文本颜色
@@ -25,6 +28,7 @@ namespace GFt {
 
         /// @brief 字体设置
         /// @return 保有的字体对象
+        /// @note 版本号在调用此函数时更新，因此不应保存返回的引用并在绑定之后修改字体
         Font& font();
         const Font& font() const;
 
@@ -41,5 +45,9 @@ namespace GFt {
         /// @brief 获取文本背景模式
         /// @return 是否为透明
         bool isTransparent() const;
+        /// @brief 获取版本号
+        /// @details 每次修改后改变，且不同对象的版本号互不相同，
+        ///          Graphics 据此跳过对同一状态的重复绑定
+        std::uint64_t version() const;
     };
 }
\ No newline at end of file
@@ -6,6 +6,7 @@
 namespace GFt {
     /// @class Texture
     /// @brief 纹理类
+    /// @details 赋值时在原有的纹理上替换图像，引用此纹理的画刷随之使用新的图像
     /// @ingroup 接口类型
     class Texture {
         friend class BrushSet;
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <memory>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+namespace GFt {
+    /// @brief 工作窃取线程池
+    /// @details 每个工作线程拥有自己的任务队列，工作线程提交的任务进入自身队列尾部并优先
+    ///          从尾部取出执行(利于缓存局部性)，空闲时从其它线程队列的头部窃取任务；
+    ///          非工作线程提交的任务会轮流分派到各个队列中
+    /// @details 全局共享的线程池可通过 getInstance() 获取，框架内的并行功能均使用该实例，
+    ///          以避免线程数量超过 CPU 核心数
+    /// @note 此类是线程安全的
+    /// @ingroup 糖衣工具
+    class ThreadPool {
+        using Job = std::function<void()>;
+        struct Worker {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+        };
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::vector<std::thread> threads_;
+        std::atomic<std::size_t> pending_ = 0;
+        std::atomic<std::size_t> next_ = 0;
+        std::mutex sleepMutex_;
+        std::condition_variable sleepCv_;
+        bool stop_ = false;
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        void workerLoop(std::size_t index);
+        void enqueue(Job job);
+        bool tryRunOne(std::size_t self);
+        std::size_t currentWorker() const;
+        static void postToUI(std::function<void()> task);
+
+    public:
+        /// @brief 构造函数
+        /// @param threads 工作线程数量，为0时使用 CPU 的硬件线程数
+        ThreadPool(std::size_t threads = 0);
+        /// @brief 析构函数
+        /// @details 会等待已提交的任务全部执行完毕
+        ~ThreadPool();
+
+        /// @brief 提交任务
+        /// @param func 任务函数
+        /// @param args 任务函数的参数
+        /// @return 可获取任务返回值的 std::future，任务抛出的异常会在 get() 时重新抛出
+        template<typename F, typename... Args>
+        auto submit(F&& func, Args&&... args)
+            -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
+            using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+            auto task = std::make_shared<std::packaged_task<R()>>(
+                [func = std::forward<F>(func), ... args = std::forward<Args>(args)]() mutable {
+                    return std::invoke(std::move(func), std::move(args)...);
+                });
+            auto future = task->get_future();
+            enqueue([task] { (*task)(); });
+            return future;
+        }
+        /// @brief 提交任务，并在任务完成后将结果交给 UI 线程处理
+        /// @param func 在工作线程上执行的任务函数
+        /// @param then 在 UI 线程上执行的后续函数，参数为任务函数的返回值(若有)
+        /// @details 后续函数会在下一帧事件处理前由 Application::exec() 调用，
+        ///          因此可以在其中安全地修改 Block 对象树；若任务抛出异常，后续函数不会被调用
+        /// @see Application::post()
+        template<typename F, typename Then>
+        void submitThen(F&& func, Then&& then) {
+            enqueue([func = std::forward<F>(func), then = std::forward<Then>(then)]() mutable {
+                using R = std::invoke_result_t<F&>;
+                if constexpr (std::is_void_v<R>) {
+                    func();
+                    postToUI(std::move(then));
+                }
+                else
+                    postToUI([then = std::move(then), result = func()]() mutable {
+                        then(std::move(result));
+                    });
+            });
+        }
+        /// @brief 并行遍历下标区间
+        /// @param begin 起始下标
+        /// @param end 结束下标(不包含)
+        /// @param body 循环体，参数为下标
+        /// @param grain 每个任务处理的下标数量，为0时自动选择
+        /// @details 区间被切分为若干块分派到工作线程，调用线程在等待期间也会参与执行任务，
+        ///          因此可以在任务中嵌套调用此函数；没有可执行的任务时调用线程休眠，
+        ///          直到最后一块完成时被唤醒；函数在所有下标处理完毕后返回，
+        ///          若循环体抛出异常，则在返回前重新抛出首个异常
+        template<typename F>
+        void parallelFor(std::size_t begin, std::size_t end, F&& body, std::size_t grain = 0) {
+            if (begin >= end)
+                return;
+            auto count = end - begin;
+            if (grain == 0)
+                grain = std::max<std::size_t>(1, count / (size() * 4));
+            auto chunks = (count + grain - 1) / grain;
+            std::atomic<std::size_t> remaining = chunks;
+            std::exception_ptr error;
+            std::mutex errorMutex;
+            std::mutex doneMutex;
+            std::condition_variable doneCv;
+            bool done = false;
+            auto run = [&](std::size_t first, std::size_t last) {
+                try {
+                    for (auto i = first; i < last; ++i)
+                        body(i);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error)
+                        error = std::current_exception();
+                }
+                // 只有最后一块需要加锁，在锁内通知以免调用线程提前返回而销毁 doneCv
+                if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    done = true;
+                    doneCv.notify_one();
+                }
+            };
+            // 首块留给调用线程执行
+            for (std::size_t c = 1; c < chunks; ++c) {
+                auto first = begin + c * grain;
+                enqueue([&run, first, last = std::min(first + grain, end)] { run(first, last); });
+            }
+            run(begin, std::min(begin + grain, end));
+            auto self = currentWorker();
+            while (remaining.load(std::memory_order_acquire) > 0)
+                if (!tryRunOne(self)) {
+                    // 剩余的块都已被其它线程取走
+                    std::unique_lock<std::mutex> lock(doneMutex);
+                    doneCv.wait(lock, [&] { return done; });
+                }
+            if (error)
+                std::rethrow_exception(error);
+        }
+        /// @brief 获取工作线程数量
+        std::size_t size() const;
+        /// @brief 获取全局共享的线程池实例
+        /// @details 该实例在首次调用时创建，线程数量为 CPU 的硬件线程数
+        static ThreadPool& getInstance();
+    };
+}
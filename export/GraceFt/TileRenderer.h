@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <GraceFt/Rasterizer.h>
+
+namespace GFt {
+    class ThreadPool;
+
+    /// @class TileRenderer
+    /// @brief 分块并行的填充绘制器
+    /// @details 先记录一帧内的填充命令，绘制时按命令的包围盒将其分配到屏幕上的方形分块中，
+    ///          再由线程池并行绘制各个分块；同一分块内的命令按记录的先后顺序绘制，
+    ///          不同分块互不重叠，因此结果与按顺序逐个绘制相同
+    /// @note 在同一目标上以 EGE 绘制前会先绘制已记录的命令，因此填充与 EGE 绘制交替时每次只能并行少量命令
+    /// @details 绘制目标的像素格式与 Rasterizer 相同
+    /// @ingroup 接口类型
+    class TileRenderer {
+        struct Command {
+            std::uint32_t first;    // 在 points_ 中的起始下标
+            std::uint32_t count;
+            iRect clip;             // 已限制在绘制目标内
+            iRect bounds;           // 包围盒与裁剪区域的交集
+            Color color;
+            Rasterizer::FillRule rule;
+            bool antiAliasing;
+        };
+        std::uint32_t* pixels_ = nullptr;
+        int width_ = 0;
+        int height_ = 0;
+        int stride_ = 0;
+        int tileSize_ = 64;
+
+        std::vector<fPoint> points_;
+        std::vector<Command> commands_;
+        std::vector<std::vector<std::uint32_t>> bins_;  // 每个分块中的命令下标
+        std::vector<std::uint32_t> occupied_;           // 存在命令的分块
+        std::size_t lastTiles_ = 0;
+
+    public:
+        TileRenderer() = default;
+
+        /// @brief 设置绘制目标
+        /// @param pixels 像素缓冲区
+        /// @param width 宽度
+        /// @param height 高度
+        /// @param stride 相邻两行起始像素之间的像素数
+        /// @details 目标改变时先绘制已记录的命令
+        void setTarget(std::uint32_t* pixels, int width, int height, int stride);
+        /// @brief 设置分块的边长
+        /// @details 默认为 64 像素，已记录的命令会先被绘制
+        void setTileSize(int size);
+        /// @brief 获取分块的边长
+        int tileSize() const;
+
+        /// @brief 记录一个多边形的填充
+        /// @param points 顶点，多边形自动闭合
+        /// @param count 顶点数量
+        /// @param clip 裁剪矩形
+        /// @param color 颜色
+        /// @param rule 填充规则
+        /// @param antiAliasing 是否抗锯齿
+        void addFill(const fPoint* points, std::size_t count, const iRect& clip, const Color& color,
+            Rasterizer::FillRule rule = Rasterizer::FillRule::NonZero, bool antiAliasing = true);
+        /// @brief 是否没有待绘制的命令
+        bool empty() const;
+        /// @brief 获取待绘制的命令数量
+        std::size_t size() const;
+        /// @brief 获取上次绘制时存在命令的分块数量
+        /// @details 上次未分块而直接绘制时为 0
+        std::size_t lastTileCount() const;
+
+        /// @brief 使用全局线程池绘制并清除已记录的命令
+        void flush();
+        /// @brief 使用指定的线程池绘制并清除已记录的命令
+        /// @details 调用线程也会参与绘制，函数在所有分块绘制完毕后返回
+        /// @details 线程池只有一个工作线程或命令只覆盖少量分块时不分块，由调用线程按顺序直接绘制
+        void flush(ThreadPool& pool);
+        /// @brief 丢弃已记录的命令
+        void clear();
+    };
+}
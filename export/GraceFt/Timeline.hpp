@@ -0,0 +1,492 @@
+#pragma once
+
+#include <GraceFt/Animation.hpp>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace GFt {
+    /// @cond IGNORE
+    /// @brief 以记录数组存放播放中动画的动画池
+    /// @details Derived 需提供：
+    /// - void load(Record& record, Owner* owner, bool fresh)：将动画对象的参数读入记录，fresh 表示新加入动画池
+    /// - void store(const Record& record, Owner* owner)：移出动画池时将需要保留的状态写回动画对象
+    /// - void evaluate(const TimePoint& now)：计算所有记录在 now 时刻的 value 与 status
+    /// @details 与 AnimationPool 相同，移除时与末尾元素交换，更新期间的移除只将所有者置空，
+    ///          待更新结束后再压缩；回调的调用顺序也与 AnimationPool 相同
+    template<typename Derived, typename Owner, typename Record>
+    class RecordPool : public AnimationPoolBase {
+    protected:
+        std::vector<Owner*> owners_;
+        std::vector<Record> records_;
+        bool updating_ = false;
+        bool dirty_ = false;
+
+        Derived& derived() { return static_cast<Derived&>(*this); }
+        void removeAt(std::size_t i) {
+            if (i + 1 != owners_.size()) {
+                owners_[i] = owners_.back();
+                records_[i] = std::move(records_.back());
+                if (owners_[i])
+                    owners_[i]->slot_ = i;
+            }
+            owners_.pop_back();
+            records_.pop_back();
+        }
+        void compact() {
+            for (std::size_t i = 0; i < owners_.size();)
+                owners_[i] ? void(++i) : removeAt(i);
+            dirty_ = false;
+        }
+
+    public:
+        void attach(Owner* owner) {
+            if (owner->slot_ != AnimationAbstract::npos)
+                return;
+            owner->slot_ = owners_.size();
+            owners_.push_back(owner);
+            records_.emplace_back();
+            derived().load(records_.back(), owner, true);
+        }
+        void detach(Owner* owner) {
+            auto i = owner->slot_;
+            if (i == AnimationAbstract::npos)
+                return;
+            derived().store(records_[i], owner);
+            owner->slot_ = AnimationAbstract::npos;
+            owners_[i] = nullptr;
+            if (updating_)
+                dirty_ = true;
+            else
+                removeAt(i);
+        }
+        void sync(Owner* owner) {
+            if (owner->slot_ != AnimationAbstract::npos)
+                derived().load(records_[owner->slot_], owner, false);
+        }
+        bool empty() const override { return owners_.empty(); }
+        /// @note 不支持异步计算，next 被忽略
+        void update(const TimePoint& now, const TimePoint*) override {
+            derived().evaluate(now);
+            auto count = owners_.size();
+            updating_ = true;
+            for (std::size_t i = 0; i < count; ++i) {
+                auto owner = owners_[i];
+                auto status = records_[i].status;
+                if (!owner || status == AnimationStatus::Waiting)
+                    continue;
+                if (status != AnimationStatus::Empty) {
+                    // setter 中可能向动画池中加入动画而使数组重新分配，因此传入副本
+                    auto value = records_[i].value;
+                    if (owner->setter_)
+                        owner->setter_(value);
+                    if (owners_[i] == owner && !owner->onUpdated.empty())
+                        owner->onUpdated();
+                }
+                if (owners_[i] == owner && status != AnimationStatus::Running)
+                    owner->finish();
+            }
+            updating_ = false;
+            if (dirty_)
+                compact();
+        }
+    };
+
+    template<typename Type>
+    struct KeyframeTrack {
+        std::vector<float> times;
+        std::vector<Type> values;
+        std::vector<EaseKernel> kernels;    // 第 i 项为结束于第 i 个关键帧的区间的过渡函数
+        std::vector<TransFunc> customs;     // 仅对无法批量计算的过渡函数保存副本
+    };
+    /// @endcond
+
+    /// @brief 关键帧动画
+    /// @tparam Type 动画值类型
+    /// @details 由若干按时刻排列的关键帧组成，相邻两个关键帧之间按后一个关键帧指定的过渡函数插值，
+    ///          动画时长等于最后一个关键帧的时刻；第一个关键帧之前保持第一个关键帧的值
+    /// @details 关键帧数据在动画对象与动画池之间共享且不可变，修改关键帧时会复制一份新的数据；
+    ///          每个播放中的动画记录当前所在的区间，每帧从该区间向后查找，而不必搜索整个关键帧序列
+    /// @code
+    /// KeyframeAnimation<float> blink([&](const float& v) { alpha = v; });
+    /// blink.at(0, 0.f).at(100, 1.f, TransFuncs::bezier).at(400, 1.f).at(600, 0.f);
+    /// @endcode
+    /// @ingroup 动画支持库
+    template<typename Type>
+        requires Animatable<Type>
+    class KeyframeAnimation : public AnimationAbstract {
+        friend class KeyframePool<Type>;
+        template<typename Derived, typename Owner, typename Record> friend class RecordPool;
+        using Track = KeyframeTrack<Type>;
+
+        std::shared_ptr<const Track> track_ = std::make_shared<const Track>();
+        std::shared_ptr<const Track> applied_ = track_;     // 已在 UI 线程上生效的关键帧数据
+        Setter<Type> setter_;
+
+        /// @details 修改关键帧的线程持有 track_，UI 线程只读取随请求传入的 applied_
+        void apply() {
+            requestChange([this, track = track_] {
+                applied_ = track;
+                assignDuration(track->times.empty() ? 0.f : track->times.back());
+                });
+        }
+
+        KeyframePool<Type>& pool() { return AnimationManager::getInstance().pool<KeyframePool<Type>>(); }
+    protected:
+        void hadSetPlay() override {}
+        void attach() override { pool().attach(this); }
+        void detach() override { pool().detach(this); }
+        void sync() override { pool().sync(this); }
+    public:
+        /// @brief 构造函数
+        /// @param setter 动画值的 setter 方法
+        explicit KeyframeAnimation(const Setter<Type>& setter)
+            : AnimationAbstract(TimePoint(), 0.f, {}), setter_(setter) {}
+        ~KeyframeAnimation() { releaseSelf(); }
+        /// @brief 添加关键帧
+        /// @param ms 关键帧时刻（毫秒），从动画开始时计
+        /// @param value 关键帧的值
+        /// @param ease 从上一个关键帧过渡到此关键帧所用的过渡函数，默认为线性过渡
+        /// @details 时刻相同的关键帧按添加的先后顺序排列，可用于实现值的跳变
+        /// @return 动画对象自身，以便连续添加
+        KeyframeAnimation& at(float ms, const Type& value, const TransFunc& ease = {}) {
+            auto track = std::make_shared<Track>(*track_);
+            auto pos = std::upper_bound(track->times.begin(), track->times.end(), ms) - track->times.begin();
+            auto kernel = EaseKernel::of(ease ? ease : TransFunc(TransFuncs::linear));
+            track->times.insert(track->times.begin() + pos, ms);
+            track->values.insert(track->values.begin() + pos, value);
+            track->kernels.insert(track->kernels.begin() + pos, kernel);
+            track->customs.insert(track->customs.begin() + pos,
+                kernel.kind == EaseKernel::Kind::Custom ? ease : TransFunc());
+            track_ = std::move(track);
+            apply();
+            return *this;
+        }
+        /// @brief 移除所有关键帧
+        /// @note 没有关键帧的动画开始播放后会立即结束，且不会调用 setter
+        void clear() {
+            track_ = std::make_shared<const Track>();
+            apply();
+        }
+        /// @brief 获取关键帧数量
+        std::size_t size() const { return track_->times.size(); }
+    };
+
+    /// @brief 此概念约束类型 Type 必须支持弹簧动画所需的向量运算
+    /// @details 即对于 Type 类型的值 a 和 b，表达式 a + b、a - b 与 a * k (k 为浮点数)
+    ///          都必须合法，且返回值类型可以隐式转换为 Type 类型
+    template<typename Type>
+    concept SpringAnimatable = Animatable<Type> && requires(Type v) {
+        { v + v } -> std::convertible_to<Type>;
+        { v - v } -> std::convertible_to<Type>;
+        { v * 1.f } -> std::convertible_to<Type>;
+    };
+
+    /// @brief 弹簧动画参数结构体
+    /// @ingroup 动画支持库
+    template<typename Type>
+        requires SpringAnimatable<Type>
+    struct SpringParams {
+        const Setter<Type>& setter;     ///< 动画值的 setter 方法
+        const Initial<Type>& initial;   ///< 动画初始值，可以是值或 getter 方法，若为 getter 方法则在动画开始时调用并作为初始值
+        const Type& target;             ///< 动画目标值
+        float frequency = 10.f;         ///< 弹簧的固有角频率（弧度每秒），值越大越快地到达目标值
+    };
+
+    /// @brief 临界阻尼弹簧动画
+    /// @tparam Type 动画值类型
+    /// @details 以临界阻尼弹簧的解析解逐帧推进位置与速度，结果与帧间隔无关且不会超调；
+    ///          从静止出发时约在 9.2 / frequency 秒后与目标值的距离小于初始距离的千分之一，
+    ///          此时动画吸附到目标值并结束，getDuration() 返回这一时长
+    /// @details 播放中调用 setTarget() 会保留当前的位置与速度，平滑地转向新的目标值而不必重新开始；
+    ///          暂停后恢复播放时同样从暂停时的位置与速度继续
+    /// @code
+    /// SpringAnimation<fPoint> follow({ setter, initial, target, 12.f });
+    /// follow.setPlay();
+    /// // 鼠标移动时
+    /// follow.setTarget(mouse);
+    /// @endcode
+    /// @ingroup 动画支持库
+    template<typename Type>
+        requires SpringAnimatable<Type>
+    class SpringAnimation : public AnimationAbstract {
+        friend class SpringPool<Type>;
+        template<typename Derived, typename Owner, typename Record> friend class RecordPool;
+        /// 从静止出发，(1 + ωt)e^(-ωt) 降至 1e-3 时的 ωt
+        static constexpr float settle_ = 9.2335f;
+
+        Type position_;
+        Type velocity_;
+        Type target_;
+        float frequency_;
+        bool retarget_ = false;     // 目标值或频率已改变，需要重新计算结束时刻
+        Getter<Type> getter_;
+        Setter<Type> setter_;
+
+        SpringPool<Type>& pool() { return AnimationManager::getInstance().pool<SpringPool<Type>>(); }
+        void assignInitial(const Initial<Type>& initial) {
+            auto ptr = std::get_if<Type>(&initial);
+            ptr ? position_ = *ptr, getter_ = Getter<Type>()
+                : getter_ = std::get<Getter<Type>>(initial);
+        }
+    protected:
+        /// @details 从停止状态开始播放时速度清零；若初始值为 getter 方法则重新读取位置，
+        ///          否则从初始值(首次播放)或上次停止时的位置出发
+        void hadSetPlay() override {
+            if (getter_)
+                position_ = getter_();
+            velocity_ = position_ - position_;
+        }
+        void attach() override { pool().attach(this); }
+        void detach() override { pool().detach(this); }
+        void sync() override { pool().sync(this); }
+    public:
+        /// @brief 构造函数
+        /// @param params 弹簧动画参数结构体
+        SpringAnimation(const SpringParams<Type>& params)
+            : AnimationAbstract(TimePoint(), settle_ * 1000.f / params.frequency, {}),
+            position_(params.target), velocity_(params.target - params.target), target_(params.target),
+            frequency_(params.frequency), setter_(params.setter) {
+            assignInitial(params.initial);
+        }
+        ~SpringAnimation() { releaseSelf(); }
+        /// @brief 设置动画初始值
+        /// @param initial 动画初始值，可以是值或 getter 方法
+        /// @details 在下一次从停止状态开始播放时生效
+        void setInitial(const Initial<Type>& initial) {
+            requestChange([this, initial] { assignInitial(initial); });
+        }
+        /// @brief 设置目标值
+        /// @param target 目标值
+        /// @details 播放中调用时保持当前的位置与速度转向新的目标值，并从此刻起重新计算结束时刻
+        void setTarget(const Type& target) {
+            requestChange([this, target] {
+                target_ = target;
+                retarget_ = true;
+                });
+        }
+        /// @brief 获取目标值
+        const Type& getTarget() const { return target_; }
+        /// @brief 设置弹簧的固有角频率
+        /// @param frequency 角频率（弧度每秒），必须大于零
+        void setFrequency(float frequency) {
+            requestChange([this, frequency] {
+                frequency_ = frequency;
+                retarget_ = true;
+                assignDuration(settle_ * 1000.f / frequency);
+                });
+        }
+        /// @brief 获取弹簧的固有角频率
+        float getFrequency() const { return frequency_; }
+    };
+
+    /// @cond IGNORE
+    template<typename Type>
+    struct KeyframeRecord {
+        TimePoint start;
+        std::shared_ptr<const KeyframeTrack<Type>> track;
+        std::size_t cursor = 0;     // 当前所在区间的起始关键帧下标
+        Type value{};
+        unsigned char status = AnimationStatus::Running;
+    };
+    template<typename Type>
+    class KeyframePool : public RecordPool<KeyframePool<Type>, KeyframeAnimation<Type>, KeyframeRecord<Type>> {
+        friend class RecordPool<KeyframePool<Type>, KeyframeAnimation<Type>, KeyframeRecord<Type>>;
+        using Record = KeyframeRecord<Type>;
+
+        void load(Record& record, KeyframeAnimation<Type>* owner, bool) {
+            record.start = owner->start_time_;
+            if (record.track != owner->applied_)
+                record.cursor = 0;
+            record.track = owner->applied_;
+        }
+        void store(const Record&, KeyframeAnimation<Type>*) {}
+        void evaluate(const TimePoint& now) {
+            for (auto& record : this->records_) {
+                auto& track = *record.track;
+                auto n = track.times.size();
+                auto ms = std::chrono::duration<float, std::milli>(now - record.start).count();
+                if (n == 0) {
+                    record.status = ms < 0.f ? AnimationStatus::Waiting : AnimationStatus::Empty;
+                    continue;
+                }
+                if (ms < 0.f) {
+                    record.status = AnimationStatus::Waiting;
+                    continue;
+                }
+                record.status = AnimationStatus::Running;
+                if (ms >= track.times.back()) {
+                    record.value = track.values.back();
+                    record.status = AnimationStatus::Done;
+                    continue;
+                }
+                if (ms <= track.times.front()) {
+                    record.value = track.values.front();
+                    continue;
+                }
+                // 时间单调前进时区间下标只会向后移动
+                auto& i = record.cursor;
+                if (i + 1 >= n || ms < track.times[i])
+                    i = 0;
+                while (i + 2 < n && ms >= track.times[i + 1])
+                    ++i;
+                auto span = track.times[i + 1] - track.times[i];
+                auto x = span > 0.f ? (ms - track.times[i]) / span : 1.f;
+                auto& kernel = track.kernels[i + 1];
+                float k;
+                if (kernel.kind != EaseKernel::Kind::Custom)
+                    kernel.evaluate(&x, &k, 1);
+                else
+                    k = track.customs[i + 1](x);
+                record.value = track.values[i] + (track.values[i + 1] - track.values[i]) * k;
+            }
+        }
+    };
+
+    template<typename Type>
+    struct SpringRecord {
+        TimePoint start;
+        TimePoint last;     // 上一次推进到的时刻
+        TimePoint settle;   // 吸附到目标值的时刻
+        Type position{};
+        Type velocity{};
+        Type target{};
+        float frequency = 0.f;
+        Type value{};
+        unsigned char status = AnimationStatus::Running;
+    };
+    template<typename Type>
+    class SpringPool : public RecordPool<SpringPool<Type>, SpringAnimation<Type>, SpringRecord<Type>> {
+        friend class RecordPool<SpringPool<Type>, SpringAnimation<Type>, SpringRecord<Type>>;
+        using Record = SpringRecord<Type>;
+        using Clock = std::chrono::steady_clock;
+
+        static TimePoint settleFrom(const TimePoint& from, float frequency) {
+            auto seconds = std::chrono::duration<float>(SpringAnimation<Type>::settle_ / frequency);
+            return from + std::chrono::duration_cast<Clock::duration>(seconds);
+        }
+        void load(Record& record, SpringAnimation<Type>* owner, bool fresh) {
+            auto now = Clock::now();
+            record.start = owner->start_time_;
+            record.target = owner->target_;
+            record.frequency = owner->frequency_;
+            if (fresh) {
+                record.position = owner->position_;
+                record.velocity = owner->velocity_;
+                record.last = std::max(record.start, now);
+                record.settle = settleFrom(record.last, record.frequency);
+            }
+            else if (owner->retarget_)
+                record.settle = settleFrom(std::max(record.last, now), record.frequency);
+            owner->retarget_ = false;
+        }
+        void store(const Record& record, SpringAnimation<Type>* owner) {
+            owner->position_ = record.position;
+            owner->velocity_ = record.velocity;
+        }
+        /// @details 临界阻尼下 y = x - target 满足 y'' + 2ωy' + ω²y = 0，
+        ///          其解 y(t) = (y0 + (v0 + ωy0)t)e^(-ωt)，据此精确地推进 dt
+        void evaluate(const TimePoint& now) {
+            for (auto& record : this->records_) {
+                if (now < record.start) {
+                    record.status = AnimationStatus::Waiting;
+                    continue;
+                }
+                auto dt = std::chrono::duration<float>(now - record.last).count();
+                dt = dt > 0.f ? dt : 0.f;
+                record.last = std::max(record.last, now);
+                auto w = record.frequency;
+                auto e = std::exp(-w * dt);
+                Type y = record.position - record.target;
+                Type tmp = record.velocity + y * w;
+                record.position = record.target + (y + tmp * dt) * e;
+                record.velocity = (record.velocity - tmp * (w * dt)) * e;
+                record.status = AnimationStatus::Running;
+                if (now >= record.settle) {
+                    record.position = record.target;
+                    record.velocity = record.target - record.target;
+                    record.status = AnimationStatus::Done;
+                }
+                record.value = record.position;
+            }
+        }
+    };
+    /// @endcond
+
+    /// @brief 动画组
+    /// @details 将若干动画按顺序依次播放或同时播放，子动画可以是任意动画，包括其它动画组；
+    ///          动画组本身不计算任何值，而是按各子动画的开始时刻将其加入对应的动画池，
+    ///          子动画的值与其它动画一起在各自的动画池中计算，播放完毕时直接通知动画组，
+    ///          因此不需要通过 onFinished 信号逐个串联动画
+    /// @details 子动画由动画组统一控制播放、暂停与停止，不应再单独控制或注册；
+    ///          子动画的初始值 getter 会在该子动画实际开始时才被调用
+    /// @note 子动画的生命周期必须长于动画组；动画组的时长由子动画计算得到，setDuration() 对其无效
+    /// @code
+    /// AnimationGroup intro(AnimationGroup::Mode::Sequence);
+    /// intro.add(&fadeIn).add(&slide, 100.f).add(&bounce);
+    /// AnimationManager::getInstance().registerAnimation(&intro);
+    /// intro.setPlay();
+    /// @endcode
+    /// @ingroup 动画支持库
+    class AnimationGroup : public AnimationAbstract {
+    public:
+        /// @brief 播放方式
+        enum class Mode {
+            Sequence,   ///< 依次播放，每个子动画在前一个结束后开始
+            Parallel,   ///< 同时播放
+        };
+        /// @cond IGNORE
+        class Pool;
+        /// @endcond
+
+    private:
+        enum class ChildState : unsigned char { Pending, Started, Finished };
+        struct Child {
+            AnimationAbstract* animation;
+            float delay;
+            float offset = 0.f;     // 相对于动画组开始时刻的开始时刻（毫秒）
+            ChildState state = ChildState::Pending;
+        };
+        Mode mode_;
+        std::vector<Child> children_;
+        std::vector<std::size_t> order_;    // 按开始时刻排序的子动画下标
+        std::size_t next_ = 0;              // order_ 中下一个待开始的位置
+        std::size_t remaining_ = 0;         // 本次播放中尚未结束的子动画数量
+        bool fresh_ = false;
+
+        Pool& pool();
+        void layout();
+        TimePoint startTime(const Child& child) const;
+        TimePoint advance(const TimePoint& now);
+        void start(Child& child, bool fresh);
+        void detachChildren(AnimationStateType state);
+    protected:
+        void hadSetPlay() override;
+        void attach() override;
+        void detach() override;
+        void sync() override;
+        void childFinished(AnimationAbstract* child) override;
+    public:
+        /// @brief 构造函数
+        /// @param mode 播放方式
+        explicit AnimationGroup(Mode mode = Mode::Sequence);
+        ~AnimationGroup();
+        AnimationGroup(const AnimationGroup&) = delete;
+        AnimationGroup& operator=(const AnimationGroup&) = delete;
+        /// @brief 添加子动画
+        /// @param animation 子动画，不能已属于其它动画组
+        /// @param delay 延迟（毫秒）；依次播放时为与前一个子动画结束之间的间隔，同时播放时为相对动画组开始的延迟
+        /// @return 动画组自身，以便连续添加
+        /// @throw std::invalid_argument 子动画为空、为动画组自身或已属于某个动画组
+        /// @note 与状态切换不同，修改子动画列表应在 UI 线程上进行
+        AnimationGroup& add(AnimationAbstract* animation, float delay = 0.f);
+        /// @brief 移除所有子动画
+        /// @note 应在 UI 线程上调用
+        void clear();
+        /// @brief 获取子动画数量
+        std::size_t size() const;
+        /// @brief 获取播放方式
+        Mode mode() const;
+    };
+}
@@ -1,9 +1,18 @@
 #pragma once
 // 这个文件用于声明一些内部使用的函数和结构体
+#include <atomic>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace GFt { class Backend; }
 
 /// @cond IGNORE
 namespace _GFt_private_ {
+    /// @brief 缓存行大小
+    /// @details 用于隔开由不同线程频繁写入的原子变量，避免伪共享
+    inline constexpr std::size_t _cache_line = 64;
     /// @brief 安全浮点数比较函数模板
     /// @tparam T 数值类型
     /// @param a 数值 a
@@ -15,6 +24,16 @@ namespace _GFt_private_ {
     bool _fsafe_equal(T a, T b, T eps = static_cast<T>(1e-6)) {
         return std::abs(a - b) < eps;
     }
+    /// @brief 获取新的状态版本号
+    /// @details 画笔、画刷与文字配置在创建和每次修改时获取新的版本号，
+    ///          所有对象共用同一个计数器，因此版本号相同即表示同一份未被修改的状态；0 表示未知状态
+    inline std::uint64_t _next_state_version() {
+        static std::atomic<std::uint64_t> next = 1;
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+    /// @brief 创建默认的平台后端
+    /// @details 由平台相关的源文件定义，未安装后端时由 Backend::instance() 调用
+    std::unique_ptr<GFt::Backend> _make_default_backend();
     /// @brief 画笔属性结构体
     struct PenSetPrivate {
         unsigned int color;
@@ -26,6 +45,12 @@ namespace _GFt_private_ {
         short userdef;
         float miterlimit;
     };
+    /// @brief 纹理属性结构体
+    /// @details 纹理对象存活期间地址不变，画刷通过它读取纹理当前的图像与版本号
+    struct TexturePrivate {
+        void* image;            // 无窗口构建中为 PixelMap*，否则为 EGE 图像
+        std::uint64_t version;  // 创建与每次赋值时更新
+    };
     /// @brief 画刷属性结构体
     struct BrushSetPrivate {
         int mode;    // 填充模式
@@ -45,7 +70,8 @@ namespace _GFt_private_ {
             } radial;
             struct {    // 纹理填充
                 float x, y, w, h;
-                void* data;
+                void* data;             // 指向纹理的 TexturePrivate
+                std::uint64_t version;  // 画刷上次更新版本号时纹理的版本号
             } texture;
             struct {    // 多边形渐变
                 float cx, cy;
@@ -0,0 +1,118 @@
+#pragma once
+// 这个文件用于声明绘图相关的内部函数和结构体
+// 几何类型的头文件包含了 _private.inl，因此依赖它们的内容不能放在 _private.inl 中
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <_private.inl>
+#include <GraceFt/Color.h>
+#include <GraceFt/Point.hpp>
+#include <GraceFt/Rect.hpp>
+
+/// @cond IGNORE
+namespace _GFt_private_ {
+    /// @brief 将颜色打包为 0xAARRGGBB，与 EGE 的 color_t 相同
+    constexpr unsigned int _pack_color(const GFt::Color& color) {
+        return static_cast<unsigned int>(color.alpha()) << 24 | static_cast<unsigned int>(color.red()) << 16
+            | static_cast<unsigned int>(color.green()) << 8 | color.blue();
+    }
+    /// @brief 将 0xAARRGGBB 解包为颜色
+    constexpr GFt::Color _unpack_color(unsigned int color) {
+        return GFt::Color((color >> 16) & 0xff, (color >> 8) & 0xff, color & 0xff, color >> 24);
+    }
+    /// @brief 将椭圆弧展开为折线追加到 points 中，角度单位为度，y 轴向下时顺时针为正(与 EGE 一致)
+    /// @details 分段数按较长的半径计算，使弦与弧之间的距离不超过 0.25 像素
+    inline void _append_arc(std::vector<GFt::fPoint>& points, GFt::fPoint center, float rx, float ry, float start, float sweep) {
+        constexpr float pi = 3.14159265f;
+        float r = std::max(std::abs(rx), std::abs(ry));
+        float step = r > 0.25f ? 2 * std::acos(1 - 0.25f / r) : pi / 2;
+        float radians = std::abs(sweep) * pi / 180;
+        int segments = std::max(1, static_cast<int>(std::ceil(radians / step)));
+        for (int i = 0; i <= segments; i++) {
+            float angle = (start + sweep * i / segments) * pi / 180;
+            points.emplace_back(center.x() + rx * std::cos(angle), center.y() + ry * std::sin(angle));
+        }
+    }
+    /// @brief 将连续的三次贝塞尔曲线展开为折线追加到 points 中
+    /// @details 控制点按 起点、控制点、控制点、终点(下一段的起点) 排列，与 EGE 一致；每段固定分为 16 段
+    inline void _append_bezier(std::vector<GFt::fPoint>& points, const GFt::fPoint* control, std::size_t count) {
+        if (count == 0)
+            return;
+        points.push_back(control[0]);
+        for (std::size_t i = 0; i + 3 < count; i += 3) {
+            auto& p0 = control[i];
+            auto& p1 = control[i + 1];
+            auto& p2 = control[i + 2];
+            auto& p3 = control[i + 3];
+            for (int k = 1; k <= 16; k++) {
+                float t = k / 16.f, u = 1 - t;
+                points.push_back(p0 * (u * u * u) + p1 * (3 * u * u * t) + p2 * (3 * u * t * t) + p3 * (t * t * t));
+            }
+        }
+    }
+    /// @brief 将经过各点的基数样条展开为折线追加到 points 中
+    /// @details 与 GDI+ 相同，每段的控制点为端点沿相邻两点连线方向偏移 tension / 3
+    inline void _append_curve(std::vector<GFt::fPoint>& points, const GFt::fPoint* through, std::size_t count,
+        float tension, bool closed) {
+        if (count < 2) {
+            points.insert(points.end(), through, through + count);
+            return;
+        }
+        auto at = [&](std::ptrdiff_t i) {
+            auto n = static_cast<std::ptrdiff_t>(count);
+            return closed ? through[(i % n + n) % n] : through[std::clamp<std::ptrdiff_t>(i, 0, n - 1)];
+        };
+        auto segments = closed ? count : count - 1;
+        for (std::size_t i = 0; i < segments; i++) {
+            auto p1 = at(i), p2 = at(i + 1);
+            GFt::fPoint control[] = { p1, p1 + (p2 - at(i - 1)) * (tension / 3),
+                p2 - (at(i + 2) - p1) * (tension / 3), p2 };
+            if (i > 0)
+                points.pop_back();
+            _append_bezier(points, control, 4);
+        }
+    }
+    /// @brief 设置位图的视口，视口外的绘制不被裁剪
+    /// @details 由位图所在的源文件定义，image 为 nullptr 时作用于窗口
+    void _set_viewport(void* image, const GFt::iRect& viewport);
+    /// @brief 以背景色清除整个位图
+    /// @details 由位图所在的源文件定义，image 为 nullptr 时作用于窗口
+    void _clear_image(void* image);
+#ifdef GFT_HEADLESS
+    /// @brief 无窗口构建中的位图
+    /// @details 像素为 0xAARRGGBB，与 EGE 的位图相同；与 EGE 一样，绘图状态记录在位图上
+    struct _Image {
+        int width = 0;
+        int height = 0;
+        std::vector<std::uint32_t> pixels;
+        GFt::iRect viewport;                    // 视口，创建时为整个位图
+        bool clip = true;                       // 是否将绘制裁剪到视口内
+        unsigned int background = 0xff000000;   // 背景色
+        unsigned int lineColor = 0xff000000;    // 线条颜色
+        float lineWidth = 1;                    // 线条宽度
+        long fontSize = 16;                     // 字体高度，用于估算文字大小
+    };
+    /// @brief 无窗口构建中画笔使用的线型、线帽与连接方式
+    /// @details 与 EGE 中的常量同名，使 PenSet 在两种构建中使用相同的代码
+    enum _PenStyle {
+        SOLID_LINE, CENTER_LINE, DOTTED_LINE, DASHED_LINE, NULL_PEN, USERBIT_LINE,
+        LINECAP_FLAT = 0, LINECAP_SQUARE, LINECAP_ROUND,
+        LINEJOIN_MITER = 0, LINEJOIN_BEVEL, LINEJOIN_ROUND,
+    };
+    /// @brief 无窗口构建中的路径
+    /// @details 曲线在加入时即被展开为折线
+    struct _PathData {
+        /// @brief 子路径
+        struct Figure {
+            std::vector<GFt::fPoint> points;
+            bool closed = false;
+        };
+        std::vector<Figure> figures;
+        bool open = false;  // 最后一个子路径是否可以继续追加
+    };
+#endif
+}
+/// @endcond
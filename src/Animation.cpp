@@ -2,95 +2,180 @@
 #include <GraceFt/Application.h>
 
 namespace GFt {
-    AnimationState::AnimationState(AnimationAbstract* owner) : owner_(owner) {}
     AnimationAbstract::AnimationAbstract(
         const TimePoint& start_time,
         float ms,
         const TransFunc& trans_func)
         : start_time_(start_time),
         duration_ms_(ms),
-        trans_func_(trans_func ? trans_func : [](float x)->float { return x; }) {
-        state_ = new AnimationStop(this);
+        trans_func_(trans_func ? trans_func : TransFunc(TransFuncs::linear)) {}
+    /// @details 发出状态改变信号后切换状态，由调用方随后根据新状态加入或移出动画池
+    /// @note 总是在 UI 线程上被调用
+    void AnimationAbstract::changeState(AnimationStateType state) {
+        onStateChanged(state_, state);
+        state_ = state;
     }
-    AnimationAbstract::~AnimationAbstract() {
-        delete state_;
+    void AnimationAbstract::finish() {
+        finished_ = {};
+        changeState(AnimationStateType::Stop);
+        refresh();
+        onFinished();
+        if (parent_)
+            parent_->childFinished(this);
     }
-    void AnimationAbstract::update(const TimePoint& now) { if (state_) state_->update(now); }
+    /// @details 在 UI 线程上调用，使动画池中的数据与动画对象当前的状态和参数一致
+    /// @details 动画组中的子动画由动画组负责加入动画池，这里只处理其停止后的移出
+    void AnimationAbstract::refresh() {
+        if (parent_) {
+            if (state_ != AnimationStateType::Play && slot_ != npos)
+                detach();
+            return;
+        }
+        if (state_ == AnimationStateType::Play && std::exchange(restart_, false))
+            hadSetPlay();
+        if (registered_ && state_ == AnimationStateType::Play)
+            slot_ == npos ? attach() : sync();
+        else if (slot_ != npos)
+            detach();
+    }
+    void AnimationAbstract::requestRefresh() { AnimationManager::getInstance().request(this); }
+    void AnimationAbstract::requestChange(std::function<void()> change) {
+        AnimationManager::getInstance().request(this, std::move(change));
+    }
+    void AnimationAbstract::releaseSelf() { AnimationManager::getInstance().release(this); }
     /// @details 若处于停止状态，则此函数无效
     void AnimationAbstract::setStop() {
-        if (isStopped()) return;
-        if (isPlaying())
-            onStateChanged(AnimationStateType::Play, AnimationStateType::Stop);
-        else if (isPaused())
-            onStateChanged(AnimationStateType::Pause, AnimationStateType::Stop);
-        delete state_;
-        state_ = new AnimationStop(this);
+        requestChange([this] {
+            if (isStopped()) return;
+            finished_ = {};
+            changeState(AnimationStateType::Stop);
+            });
     }
     /// @details 若处于播放状态，则此函数无效
+    /// @details 从停止状态开始播放时从头播放，从暂停状态恢复时从暂停处继续播放；
+    ///          开始时刻取调用此函数的时刻，而不是在 UI 线程上生效的时刻
     void AnimationAbstract::setPlay() {
-        if (isPlaying()) return;
-        if (isPaused())
-            onStateChanged(AnimationStateType::Pause, AnimationStateType::Play);
-        else if (isStopped())
-            onStateChanged(AnimationStateType::Stop, AnimationStateType::Play);
-        delete state_;
-        state_ = new AnimationPlay(this);
-        hadSetPlay();
+        requestChange([this, now = std::chrono::steady_clock::now()] {
+            if (isPlaying()) return;
+            if (isStopped())
+                restart_ = true;
+            start_time_ = now - finished_;
+            changeState(AnimationStateType::Play);
+            });
     }
     /// @details 不允许从停止状态直接切换到暂停状态，必须先切换到播放状态再切换到暂停状态
     ///          若处于停止状态或暂停状态，则此函数无效
     void AnimationAbstract::setPause() {
-        if (isPaused() || isStopped()) return;
-        if (isPlaying())
-            onStateChanged(AnimationStateType::Play, AnimationStateType::Pause);
-        delete state_;
-        state_ = new AnimationPause(this);
+        requestChange([this, now = std::chrono::steady_clock::now()] {
+            if (isPaused() || isStopped()) return;
+            finished_ = now - start_time_;
+            changeState(AnimationStateType::Pause);
+            });
     }
-    bool AnimationAbstract::isPlaying() const {
-        return dynamic_cast<AnimationPlay*>(state_) != nullptr;
+    AnimationStateType AnimationAbstract::state() const { return state_; }
+    bool AnimationAbstract::isPlaying() const { return state_ == AnimationStateType::Play; }
+    bool AnimationAbstract::isPaused() const { return state_ == AnimationStateType::Pause; }
+    bool AnimationAbstract::isStopped() const { return state_ == AnimationStateType::Stop; }
+    void AnimationAbstract::setTransFunc(const TransFunc& trans_func) {
+        requestChange([this, trans_func = trans_func ? trans_func : TransFunc(TransFuncs::linear)] {
+            trans_func_ = trans_func;
+            });
     }
-    bool AnimationAbstract::isPaused() const {
-        return dynamic_cast<AnimationPause*>(state_) != nullptr;
+    void AnimationAbstract::setDuration(float ms) {
+        requestChange([this, ms] { duration_ms_ = ms; });
     }
-    bool AnimationAbstract::isStopped() const {
-        return dynamic_cast<AnimationStop*>(state_) != nullptr;
-    }
-    void AnimationAbstract::setTransFunc(const TransFunc& trans_func) { trans_func_ = trans_func; }
-    void AnimationAbstract::setDuration(float ms) { duration_ms_ = ms; }
     const TransFunc& AnimationAbstract::getTransFunc() const { return trans_func_; }
     float AnimationAbstract::getDuration() const { return duration_ms_; }
-    AnimationStop::AnimationStop(AnimationAbstract* owner) : AnimationState(owner) {}
-    void AnimationStop::update(const TimePoint& now) { owner_->start_time_ = now; }
-    AnimationPlay::AnimationPlay(AnimationAbstract* owner) : AnimationState(owner) {}
-    void AnimationPlay::update(const TimePoint& now) { owner_->playingUpdate(now); }
-    AnimationPause::AnimationPause(AnimationAbstract* owner) : AnimationState(owner) {}
-    void AnimationPause::update(const TimePoint& now) { owner_->start_time_ = now - owner_->finished_; }
+
+    AnimationPoolBase::AnimationPoolBase() { AnimationManager::getInstance().pools_.push_back(this); }
+
+    AnimationManager::~AnimationManager() {
+        auto command = commands_.exchange(nullptr);
+        while (command)
+            delete std::exchange(command, command->next);
+    }
+    bool AnimationManager::onUIThread() const {
+        return uiThread_.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+    /// @details 在 UI 线程上立即修改并刷新，否则连同修改压入无锁栈，由 UI 线程在下次更新开始时执行；
+    ///          两种情况都会请求下一帧，以便主循环在按需模式下开始更新新播放的动画
+    void AnimationManager::request(AnimationAbstract* animation, std::function<void()> change) {
+        if (onUIThread()) {
+            if (change)
+                change();
+            animation->refresh();
+        }
+        else {
+            auto command = new Command{ animation, std::move(change), commands_.load(std::memory_order_relaxed) };
+            while (!commands_.compare_exchange_weak(command->next, command,
+                std::memory_order_release, std::memory_order_relaxed));
+        }
+        Application::requestFrame();
+    }
+    /// @details 一次取走整个栈并反转，以按请求的先后顺序应用
+    void AnimationManager::applyCommands(const AnimationAbstract* skip) {
+        auto command = commands_.exchange(nullptr, std::memory_order_acquire);
+        Command* ordered = nullptr;
+        while (command) {
+            auto next = command->next;
+            command->next = ordered;
+            ordered = command;
+            command = next;
+        }
+        while (ordered) {
+            auto current = std::exchange(ordered, ordered->next);
+            if (current->animation != skip) {
+                if (current->change)
+                    current->change();
+                current->animation->refresh();
+            }
+            delete current;
+        }
+    }
+    /// @details 在 UI 线程上销毁动画时，先应用队列中尚未处理的请求，避免其中留下悬空指针
+    void AnimationManager::release(AnimationAbstract* animation) {
+        if (onUIThread())
+            applyCommands(animation);
+        if (animation->slot_ != AnimationAbstract::npos)
+            animation->detach();
+    }
     void AnimationManager::registerAnimation(AnimationAbstract* animation) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (std::find(animations_.begin(), animations_.end(), animation) == animations_.end())
-            animations_.push_back(animation);
+        animation->registered_ = true;
+        request(animation);
     }
     void AnimationManager::unregisterAnimation(AnimationAbstract* animation) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        using Iter = std::list<AnimationAbstract*>::iterator;
-        Iter it = std::remove_if(animations_.begin(), animations_.end(),
-            [animation](AnimationAbstract* a) { return a == animation; });
-        animations_.erase(it, animations_.end());
+        animation->registered_ = false;
+        request(animation);
     }
     void AnimationManager::updateAll(const TimePoint& now) {
-        for (auto animation : animations_)
-            animation->update(now);
+        uiThread_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        applyCommands();
+        // 按上一帧的间隔估计下一帧的时刻
+        TimePoint next = lastUpdate_ == TimePoint{} ? now : now + (now - lastUpdate_);
+        lastUpdate_ = now;
+        auto async = async_.load() && next > now;
+        // 回调中可能首次使用新的值类型而创建新的动画池
+        bool active = false;
+        for (std::size_t i = 0; i < pools_.size(); ++i) {
+            active = active || !pools_[i]->empty();
+            pools_[i]->update(now, async ? &next : nullptr);
+        }
+        // 仍有动画播放时请求下一帧以继续播放
+        if (active)
+            Application::requestFrame();
     }
+    void AnimationManager::setAsyncEvaluation(bool enable) { async_ = enable; }
+    bool AnimationManager::isAsyncEvaluation() const { return async_; }
+    /// @details 首次更新之前以创建实例的线程作为 UI 线程，使其上的调用立即生效
+    AnimationManager::AnimationManager() : uiThread_(std::this_thread::get_id()) {
+        Application::onEventCall.connect([this] {
+            using namespace std::chrono;
+            updateAll(steady_clock::now());
+            });
+    }
+    /// @details 局部静态变量的初始化保证首次调用来自多个线程时也只构造一次
     AnimationManager& AnimationManager::getInstance() {
         static AnimationManager instance;
-        static bool initialized = false;
-        if (!initialized) {
-            initialized = true;
-            Application::onEventCall.connect([] {
-                using namespace std::chrono;
-                AnimationManager::getInstance().updateAll(steady_clock::now());
-                });
-        }
         return instance;
     }
-}
\ No newline at end of file
+}
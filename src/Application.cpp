@@ -2,14 +2,17 @@
 
 #include <thread>
 #include <mutex>
-#include <ege.h>
 #include <chrono>
+#include <condition_variable>
+#ifdef _WIN32
+#include <windows.h>
+#endif
 
 #include <GraceFt/Geometry.hpp>
 #include <GraceFt/BlockFocus.h>
+#include <GraceFt/Backend.h>
 
 namespace GFt {
-    using namespace ege;
     using namespace std;
     Window* Application::root_ = nullptr;
     double Application::FPS_ = -1.0;
@@ -19,141 +22,168 @@ namespace GFt {
     bool Application::shouldClose_ = false;
     Signal<void> Application::onRenderCall;
     Signal<void> Application::onEventCall;
+    std::mutex Application::postMutex_;
+    std::vector<std::function<void()>> Application::posted_;
+    Application::LoopMode Application::loopMode_ = Application::LoopMode::Continuous;
+    std::atomic<bool> Application::renderRequested_ = true;
+    std::mutex Application::wakeMutex_;
+    std::condition_variable Application::wakeCond_;
+    chrono::steady_clock::time_point Application::nextFrame_ = chrono::steady_clock::time_point::min();
+
     Application::Application(Window* root) {
         if (Application::root_ || !root)
             return;
         Application::root_ = root;
     }
-    void Application::render(Window* window, bool clipO) {
+    /// @details 无论是否完整重绘都会收集重绘区域，以清除标记并记录各对象本帧的绘制区域
+    void Application::render(Window* window, bool clipO, bool full) {
         Application::onRenderCall();
-        cleardevice();
-        window->handleOnDraw(iPoint{}, clipO);
-        flushwindow();
+        auto& backend = Backend::instance();
+        DamageRegion damage;
+        window->collectDamage(damage, iPoint{}, clipO, true, false);
+        if (full) {
+            backend.clear();
+            window->handleOnDraw(iPoint{}, clipO);
+            Block::flushCanvas();
+            backend.present();
+        }
+        else if (!damage.empty()) {
+            for (auto& rect : damage.rects())
+                backend.clear(rect);
+            window->handleOnDraw(iPoint{}, clipO, &damage);
+            Block::flushCanvas();
+            backend.present(&damage);
+        }
+    }
+    void Application::runPosted() {
+        std::vector<std::function<void()>> tasks;
+        {
+            std::lock_guard<std::mutex> lock(postMutex_);
+            tasks.swap(posted_);
+        }
+        for (auto& task : tasks)
+            task();
     }
     void Application::handleEvents(Window* window) {
         Application::onEventCall();
-        constexpr int max_msg_count = 10;
-        int count_mousemsg = 0, count_kbmsg = 0, count_textmsg = 0;
+        Application::runPosted();
+        // 每帧处理输入的时间上限，超出后剩余的消息留到下一帧，避免消息洪泛时帧被拖长
+        constexpr auto input_budget = chrono::milliseconds(2);
+        auto deadline = Clock::now() + input_budget;
+        // 窗口客户区原点在一帧内不变，鼠标的屏幕坐标由它与消息中的客户区坐标得到，无需逐条查询光标
+        auto origin = window->absolutePosition();
+        // 连续的鼠标移动合并为一个事件，在其它鼠标事件之前或处理结束时分发
+        std::vector<iPoint> moves;
+        auto flushMoves = [&] {
+            if (moves.empty())
+                return;
+            auto last = moves.back();
+            MouseMoveEvent event{ last, origin + last, std::move(moves) };
+            moves.clear();
+            window->handleOnMouseMove(&event);
+        };
         // 鼠标事件
-        if (mousemsg()) do {
-            auto msg = getmouse();
-            // 获取鼠标按键
-            MouseButton button;
-            if (msg.is_left())
-                button = MouseButton::Left;
-            else if (msg.is_right())
-                button = MouseButton::Right;
-            else if (msg.is_mid())
-                button = MouseButton::Middle;
-            else
-                button = MouseButton::Unknown;
-            // 处理鼠标事件
-            if (msg.is_move()) {
-                MouseMoveEvent event{ iPoint{ msg.x, msg.y } };
-                window->handleOnMouseMove(&event);
-            }
-            else if (msg.is_down()) {
-                MouseButtonPressEvent event{ iPoint{ msg.x, msg.y }, button, };
+        auto& backend = Backend::instance();
+        MouseMessage msg;
+        while (backend.pollMouse(msg)) {
+            switch (msg.type) {
+            case MouseMessage::Type::Move:
+                moves.push_back(msg.position);
+                break;
+            case MouseMessage::Type::Press:
+            {
+                flushMoves();
+                MouseButtonPressEvent event{ msg.position, msg.button, origin + msg.position };
                 window->handleOnMouseButtonPress(&event);
             }
-            else if (msg.is_up()) {
-                MouseButtonReleaseEvent event{ iPoint{ msg.x, msg.y }, button, };
+            break;
+            case MouseMessage::Type::Release:
+            {
+                flushMoves();
+                MouseButtonReleaseEvent event{ msg.position, msg.button, origin + msg.position };
                 window->handleOnMouseButtonRelease(&event);
             }
-            else if (msg.is_wheel()) {
-                MouseWheel wheels;
-                if (msg.wheel > 0)
-                    wheels = MouseWheel::Up;
-                else if (msg.wheel < 0)
-                    wheels = MouseWheel::Down;
-                else
-                    wheels = MouseWheel::None;
-                MouseWheelEvent event{ iPoint{ msg.x, msg.y }, wheels };
+            break;
+            case MouseMessage::Type::Wheel:
+            {
+                flushMoves();
+                MouseWheelEvent event{ msg.position, msg.wheel, origin + msg.position };
                 window->handleOnMouseWheel(&event);
             }
-            count_mousemsg++;
-            if (count_mousemsg > max_msg_count)
+            break;
+            }
+            if (Clock::now() >= deadline)
                 break;
-        } while (mousemsg());
+        }
+        flushMoves();
+        // 输入引起的外观变化由对象自行标记重绘；未处理完的消息留到下一帧
+        if (backend.hasMouse())
+            requestFrame();
         // 键盘事件
         Block* block = BlockFocusManager::getFocusOn();
         if (!block)
             return;
-        if (kbmsg()) do {
-            auto msg = getkey();
-            switch (msg.msg) {
-            case key_msg_down:
+        KeyMessage key;
+        while (backend.pollKey(key)) {
+            switch (key.type) {
+            case KeyMessage::Type::Press:
             {
-                KeyPressEvent event{
-                        static_cast<Key>(msg.key),
-                        static_cast<bool>(msg.flags & key_flag_shift),
-                        static_cast<bool>(msg.flags & key_flag_ctrl),
-                };
+                KeyPressEvent event{ static_cast<Key>(key.key), key.shift, key.ctrl };
                 block->handleOnKeyPress(&event);
             }
             break;
-            case key_msg_up:
+            case KeyMessage::Type::Release:
             {
-                KeyReleaseEvent event{
-                  static_cast<Key>(msg.key),
-                  static_cast<bool>(msg.flags & key_flag_shift),
-                  static_cast<bool>(msg.flags & key_flag_ctrl),
-                };
+                KeyReleaseEvent event{ static_cast<Key>(key.key), key.shift, key.ctrl };
                 block->handleOnKeyRelease(&event);
             }
             break;
-            case key_msg_char:
+            case KeyMessage::Type::Char:
             {
-                TextInputEvent event{ msg.key };
+                TextInputEvent event{ key.key };
                 block->handleOnTextInput(&event);
             }
             break;
             }
-            count_kbmsg++;
-            if (count_kbmsg > max_msg_count)
-                break;
-        } while (kbmsg());
-        // 文本输入事件
-        if (kbhit()) do {
-            auto ch = getch();
-            TextInputEvent event{ ch };
-            block->handleOnTextInput(&event);
-            count_textmsg++;
-            if (count_textmsg > max_msg_count)
+            if (Clock::now() >= deadline)
                 break;
-        } while (kbhit());
+        }
+        if (backend.hasKey())
+            requestFrame();
     }
     Application::~Application() {}
     void Application::updateBlockHoverState() {
         Block* curr = Application::root_;
+        auto mouse = getAbsoluteMousePosition();
         while (true) {
             if (curr->children_.empty()) {
                 BlockHoverManager::setHoverOn(curr);
                 break;
             }
-            using Iter = std::multiset<Block*, GFt::Block::CompareByZIndex>::iterator;
-            Iter iter = std::find_if(curr->children_.begin(), curr->children_.end(),
-                [](const Block* block) {
-                    return contains({ block->absolutePosition(), block->rect().size() }, getAbsoluteMousePosition());
-                });
-            if (iter == curr->children_.end()) {
+            auto hit = curr->childAt(mouse);
+            if (hit == nullptr) {
                 BlockHoverManager::setHoverOn(curr);
                 break;
             }
-            curr = *iter;
+            curr = hit;
         }
     }
     /// @note 若未检测到窗口被成功创建，此函数不会阻塞，将会立即返回错误码 1(通常此函数返回值直接作为程序的退出码)
     int Application::exec(bool cilpO) {
-        if (ege::getHWnd() == (HWND)0)
+        auto& backend = Backend::instance();
+        if (!backend.isRunning())
             return 1;
+        backend.beginLoop();
         auto lastTime = chrono::steady_clock::now();
-        for (;is_run() && !Application::shouldClose_; Application::FPS_ > 0 ? delay_fps(Application::FPS_) : (void)0) {
+        for (;backend.isRunning() && !Application::shouldClose_; waitForFrame()) {
             auto t1 = chrono::steady_clock::now();
             handleEvents(Application::root_);
 
             auto t2 = chrono::steady_clock::now();
-            render(Application::root_, cilpO);
+            // 先取走重绘请求，绘制期间产生的请求留到下一帧
+            auto full = renderRequested_.exchange(false) || loopMode_ == LoopMode::Continuous;
+            if (full || root_->isDirty())
+                render(Application::root_, cilpO, full);
 
             auto nowTime = chrono::steady_clock::now();
 
@@ -166,28 +196,85 @@ namespace GFt {
         }
         return 0;
     }
+    /// @details 连续模式下只做帧率控制；按需模式下若没有请求帧则休眠，
+    ///          直到最早请求的时刻或被 requestFrame() 唤醒
+    void Application::waitForFrame() {
+        if (Application::FPS_ > 0)
+            Backend::instance().waitFrame(Application::FPS_);
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        if (loopMode_ == LoopMode::OnDemand) {
+            while (nextFrame_ > Clock::now() && !shouldClose_) {
+                if (nextFrame_ == Clock::time_point::max())
+                    wakeCond_.wait(lock);
+                else
+                    wakeCond_.wait_until(lock, nextFrame_);
+            }
+        }
+        // 本帧的工作会重新请求之后所需的帧
+        nextFrame_ = Clock::time_point::max();
+    }
     int Application::run(bool cilpO) { return exec(cilpO); }
-    void Application::shouldClose() { Application::shouldClose_ = true; }
-    void Application::exit() { Application::shouldClose_ = true; }
+    void Application::shouldClose() {
+        Application::shouldClose_ = true;
+        requestFrame();
+    }
+    void Application::exit() { shouldClose(); }
     void Application::setFps(double fps) { Application::FPS_ = fps; }
     double Application::getFps() { return Application::FPS_; }
     float Application::getRealFps() { return Application::realFps_; }
     float Application::getRenderTime() { return Application::renderTime_; }
     float Application::getEventTime() { return Application::eventTime_; }
     Block* Application::getRoot() { return Application::root_; }
-    bool Application::showCursor(bool show) { return ege::showmouse(show); }
-    iPoint Application::getAbsoluteMousePosition() {
-        POINT pos;
-        GetCursorPos(&pos);
-        return iPoint(pos.x, pos.y);
+    bool Application::showCursor(bool show) { return Backend::instance().showCursor(show); }
+    iPoint Application::getAbsoluteMousePosition() { return Backend::instance().cursorPosition(); }
+    void Application::post(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(postMutex_);
+            posted_.push_back(std::move(task));
+        }
+        requestFrame();
+    }
+    void Application::renderFrame(bool full, bool cilpO) {
+        if (root_)
+            render(root_, cilpO, full);
+    }
+    void Application::setLoopMode(LoopMode mode) {
+        loopMode_ = mode;
+        requestRender();
+    }
+    Application::LoopMode Application::getLoopMode() { return loopMode_; }
+    void Application::setRasterMode(Graphics::RasterMode mode) {
+        Block::setCanvasRasterMode(mode);
+        requestRender();
+    }
+    Graphics::RasterMode Application::getRasterMode() { return Block::canvasRasterMode(); }
+    void Application::requestFrame() { requestFrame(Clock::time_point::min()); }
+    void Application::requestFrame(Clock::time_point at) {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        if (at >= nextFrame_)
+            return;
+        nextFrame_ = at;
+        wakeCond_.notify_one();
+    }
+    void Application::requestRender() {
+        renderRequested_ = true;
+        requestFrame();
     }
+    /// @details 非 Windows 平台上通过 /proc/self/exe 获取可执行文件的位置
     std::filesystem::path Application::localPath() {
         static std::filesystem::path localPath;
         if (!localPath.empty())
             return localPath;
+#ifdef _WIN32
         wchar_t path[MAX_PATH];
-        if (GetModuleFileName(NULL, path, MAX_PATH))
+        if (GetModuleFileNameW(NULL, path, MAX_PATH))
             localPath = std::filesystem::path(path).parent_path();
+#else
+        std::error_code error;
+        auto path = std::filesystem::read_symlink("/proc/self/exe", error);
+        if (!error)
+            localPath = path.parent_path();
+#endif
         return localPath;
     }
 }
\ No newline at end of file
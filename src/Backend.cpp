@@ -0,0 +1,23 @@
+#include "GraceFt/Backend.h"
+#include <_private.inl>
+
+#include <GraceFt/Block.h>
+
+namespace GFt {
+    namespace {
+        std::unique_ptr<Backend>& installed() {
+            static std::unique_ptr<Backend> backend;
+            return backend;
+        }
+    }
+    Backend& Backend::instance() {
+        auto& backend = installed();
+        if (!backend)
+            backend = _GFt_private_::_make_default_backend();
+        return *backend;
+    }
+    void Backend::install(std::unique_ptr<Backend> backend) {
+        installed() = std::move(backend);
+        Block::invalidateWindowOrigin();
+    }
+}
@@ -1,30 +1,30 @@
 #include "GraceFt/Block.h"
 
 #include <algorithm>
-#include <ege.h>
-#include <dwmapi.h>
+#include <atomic>
+#include <cmath>
+#include <utility>
+#include <_private_draw.inl>
 #include <GraceFt/Geometry.hpp>
+#include <GraceFt/Backend.h>
 
 #include <GraceFt/Graphics.h>
 #include <GraceFt/BlockFocus.h>
 #include <GraceFt/Window.h>
+#include <GraceFt/Application.h>
 
 #define DEF_MOUSE_HANDEL_FUNC(eventName)                                                \
     void Block::handleOn##eventName(eventName##Event* event, const iPoint& lefttop) {   \
         if (event->isPropagationStopped())                                              \
             return;                                                                     \
-        auto iter = std::find_if(children_.begin(), children_.end(),                    \
-            [&](const Block* child) {                                                   \
-                return contains(iRect{                                                  \
-                    child->absolutePosition(), child->rect().size()                          \
-                    }, event->absolutePosition()); });                                  \
+        auto hit = childAt(event->absolutePosition());                                  \
         do {                                                                            \
-            if (iter == children_.end()){                                               \
+            if (hit == nullptr){                                                        \
                 BlockHoverManager::setHoverOn(this);                                    \
                 break;                                                                  \
             }                                                                           \
             if (!event->isPropagationStopped())                                         \
-                (*iter)->handleOn##eventName(event, lefttop + this->rect().position()); \
+                hit->handleOn##eventName(event, lefttop + this->rect().position());     \
         } while (false);                                                                \
         if (!event->isPropagationStopped())                                             \
             if (!this->hide_)                                                           \
@@ -41,9 +41,146 @@
     }
 
 namespace GFt {
-    using namespace ege;
-    bool Block::CompareByZIndex::operator()(const Block* a, const Block* b) const {
-        return a->zIndex_ > b->zIndex_;
+    using namespace _GFt_private_;
+    namespace {
+        /// @brief 两个矩形的交集，不相交时宽高不大于 0
+        iRect intersection(const iRect& a, const iRect& b) {
+            auto left = std::max(a.left(), b.left());
+            auto top = std::max(a.top(), b.top());
+            return iRect(left, top, std::min(a.right(), b.right()) - left, std::min(a.bottom(), b.bottom()) - top);
+        }
+        /// @brief 所有块对象共用的绘图设备
+        Graphics& canvas() {
+            static Graphics g;
+            return g;
+        }
+        /// @brief 子对象数量达到此值时使用网格进行命中测试
+        constexpr std::size_t hitGridThreshold = 32;
+        bool containsPoint(const iRect& rect, const iPoint& p) {
+            return p.x() >= rect.left() && p.x() < rect.right() && p.y() >= rect.top() && p.y() < rect.bottom();
+        }
+        /// @brief 当前的绘制目标，为空时为后端提供的屏幕
+        PixelMap* drawTarget = nullptr;
+        /// @brief 窗口客户区左上角在屏幕上的位置，失效时在下次使用时重新查询
+        std::atomic<bool> windowOriginValid{ false };
+        iPoint windowOrigin;
+    }
+    /// @brief 当前绘制目标对应的图像，为空时为窗口
+    void* Block::targetImage() {
+        auto target = drawTarget ? drawTarget : Backend::instance().screen();
+        return target ? target->pixmap_ : nullptr;
+    }
+    /// @brief 子对象命中测试用的均匀网格
+    /// @details 网格覆盖所有子对象区域的外接矩形，每个格子按子对象的排列顺序记录与其相交的子对象的下标，
+    ///          因此格子中第一个包含查询点的子对象即为命中的子对象
+    struct Block::HitGrid {
+        static constexpr int maxCells = 64;
+        iRect bounds;
+        int columns = 0, rows = 0;
+        int cellWidth = 1, cellHeight = 1;
+        std::vector<std::uint32_t> offsets;     // 每个格子在 items 中的起始位置
+        std::vector<std::uint32_t> items;
+
+        void cellRange(const iRect& rect, int& x0, int& y0, int& x1, int& y1) const {
+            x0 = std::clamp((rect.left() - bounds.left()) / cellWidth, 0, columns - 1);
+            y0 = std::clamp((rect.top() - bounds.top()) / cellHeight, 0, rows - 1);
+            x1 = std::clamp((rect.right() - 1 - bounds.left()) / cellWidth, 0, columns - 1);
+            y1 = std::clamp((rect.bottom() - 1 - bounds.top()) / cellHeight, 0, rows - 1);
+        }
+        template<typename Func>
+        void forEachCell(const iRect& rect, Func&& func) const {
+            int x0, y0, x1, y1;
+            cellRange(rect, x0, y0, x1, y1);
+            for (int y = y0; y <= y1; ++y)
+                for (int x = x0; x <= x1; ++x)
+                    func(y * columns + x);
+        }
+        void build(const std::vector<Block*>& children) {
+            bool any = false;
+            int left = 0, top = 0, right = 0, bottom = 0;
+            for (auto child : children) {
+                auto& r = child->rect();
+                if (r.width() <= 0 || r.height() <= 0)
+                    continue;
+                left = any ? std::min(left, r.left()) : r.left();
+                top = any ? std::min(top, r.top()) : r.top();
+                right = any ? std::max(right, r.right()) : r.right();
+                bottom = any ? std::max(bottom, r.bottom()) : r.bottom();
+                any = true;
+            }
+            bounds = iRect(left, top, right - left, bottom - top);
+            // 每个格子平均约一个子对象
+            auto side = std::clamp(static_cast<int>(std::sqrt(static_cast<double>(children.size()))), 1, maxCells);
+            columns = any ? side : 0;
+            rows = any ? side : 0;
+            cellWidth = std::max(1, (bounds.width() + side - 1) / side);
+            cellHeight = std::max(1, (bounds.height() + side - 1) / side);
+            offsets.assign(static_cast<std::size_t>(columns * rows) + 1, 0);
+            if (!any)
+                return items.clear();
+            // 先统计每个格子的数量，再按子对象的顺序填入
+            for (auto child : children)
+                if (child->rect().width() > 0 && child->rect().height() > 0)
+                    forEachCell(child->rect(), [this](int cell) { ++offsets[cell + 1]; });
+            for (std::size_t i = 1; i < offsets.size(); ++i)
+                offsets[i] += offsets[i - 1];
+            items.resize(offsets.back());
+            auto cursor = offsets;
+            for (std::uint32_t i = 0; i < children.size(); ++i)
+                if (children[i]->rect().width() > 0 && children[i]->rect().height() > 0)
+                    forEachCell(children[i]->rect(), [&](int cell) { items[cursor[cell]++] = i; });
+        }
+        /// @param p 相对于父对象左上角的坐标
+        Block* find(const std::vector<Block*>& children, const iPoint& p) const {
+            if (columns == 0 || !containsPoint(bounds, p))
+                return nullptr;
+            auto cell = ((p.y() - bounds.top()) / cellHeight) * columns + (p.x() - bounds.left()) / cellWidth;
+            for (auto i = offsets[cell]; i < offsets[cell + 1]; ++i)
+                if (containsPoint(children[items[i]]->rect(), p))
+                    return children[items[i]];
+            return nullptr;
+        }
+    };
+
+    /// @brief 判断 a 是否排在 b 之前：层级高的在前，同层级先加入的在前
+    bool Block::precedes(const Block* a, const Block* b) {
+        return a->zIndex_ != b->zIndex_ ? a->zIndex_ > b->zIndex_ : a->childOrder_ < b->childOrder_;
+    }
+    void Block::reindexChildren(std::size_t first, std::size_t last) {
+        for (auto i = first; i < last; ++i)
+            children_[i]->childIndex_ = i;
+    }
+    void Block::insertChild(Block* child) {
+        child->childOrder_ = nextChildOrder_++;
+        auto pos = std::upper_bound(children_.begin(), children_.end(), child, precedes);
+        auto index = static_cast<std::size_t>(pos - children_.begin());
+        children_.insert(pos, child);
+        reindexChildren(index, children_.size());
+        hitGridValid_ = false;
+    }
+    /// @return 是否为此对象的子对象
+    bool Block::eraseChild(Block* child) {
+        auto index = child->childIndex_;
+        if (index >= children_.size() || children_[index] != child)
+            return false;
+        children_.erase(children_.begin() + index);
+        reindexChildren(index, children_.size());
+        hitGridValid_ = false;
+        return true;
+    }
+    /// @details 层级改变后将子对象旋转到新的位置，只移动两个位置之间的元素
+    void Block::reorderChild(Block* child) {
+        hitGridValid_ = false;
+        auto begin = children_.begin();
+        auto current = begin + child->childIndex_;
+        auto before = std::upper_bound(begin, current, child, precedes);
+        if (before != current) {
+            std::rotate(before, current, current + 1);
+            return reindexChildren(before - begin, current - begin + 1);
+        }
+        auto after = std::upper_bound(current + 1, children_.end(), child, precedes);
+        std::rotate(current, current + 1, after);
+        reindexChildren(current - begin, after - begin);
     }
     /// @note 由于此函数会在每帧渲染时调用，因而应尽量避免过多的计算、创建和销毁临时对象，以提高效率。
     /// @note 渲染帧时长(可通过 Application::getRenderTime() 获取)最好控制在16ms以内，否则会引发较为明显的卡顿
@@ -61,77 +198,69 @@ namespace GFt {
     void Block::onKeyRelease(KeyReleaseEvent* event) {}
     void Block::onTextInput(TextInputEvent* event) {}
     Block::Block(const iRect& rect, Block* parent, int zIndex) :GraphInterface(rect) {
-        parent_ = parent;
+        parent_ = nullptr;
         zIndex_ = zIndex;
+        if (parent != nullptr)
+            parent->addChild(this);
+    }
+    /// @details 从父对象中移除自身，并使子对象脱离对象树，避免父子对象中留下悬空指针
+    Block::~Block() {
         if (parent_ != nullptr)
-            parent_->addChild(this);
+            parent_->removeChild(this);
+        for (auto child : children_)
+            child->parent_ = nullptr;
     }
-    Block::~Block() {}
     void Block::addChild(Block* child) {
         // 若为空指针则忽略
         if (child == nullptr)
             return;
         // 若已存在则忽略
-        using Iter = std::multiset<Block*, CompareByZIndex>::iterator;
-        Iter insert_iter = std::find_if(children_.begin(), children_.end(),
-            [&](const Block* c) { return c == child; });
-        if (insert_iter != children_.end())
+        if (child->parent_ == this && child->childIndex_ < children_.size()
+            && children_[child->childIndex_] == child)
             return;
         // 若该节点存在父节点则先从父节点移除
         if (child->parent_ != nullptr)
             child->parent_->removeChild(child);
         // 更新节点数据
         child->parent_ = this;
-        children_.insert(child);
-        // 引发元素重排
-        this->sortChildren_ = false;
+        child->invalidatePosition();
+        insertChild(child);
+        child->markDirty();
     }
     void Block::removeChild(Block* child) {
-        // 若为空指针则忽略
-        if (child == nullptr)
-            return;
-        // 若不存在则忽略
-        using Iter = std::multiset<Block*, CompareByZIndex>::iterator;
-        Iter remove_iter = std::find_if(children_.begin(), children_.end(),
-            [&](const Block* c) { return c == child; });
-        if (remove_iter == children_.end())
+        // 若为空指针或不存在则忽略
+        if (child == nullptr || child->parent_ != this || !eraseChild(child))
             return;
         // 移除节点
-        children_.erase(remove_iter);
         child->parent_ = nullptr;
-        // 引发元素重排
-        this->sortChildren_ = false;
+        child->invalidatePosition();
+        child->releasePainted(damage_);
+        markTreeDirty();
     }
     void Block::setZIndex(int zIndex) {
         zIndex_ = zIndex;
         if (parent_ != nullptr)
-            parent_->sortChildren_ = false;
+            parent_->reorderChild(this);
+        markDirty();
     }
     void Block::setParent(Block* parent) {
-        if (parent == nullptr) {
-            if (parent_ != nullptr) {
-                parent_->children_.erase(this);
-                parent_->sortChildren_ = false;
-            }
-            parent_ = nullptr;
+        if (parent == parent_)
             return;
-        }
-        if (parent_ != nullptr) {
-            parent_->children_.erase(this);
-            parent_->sortChildren_ = false;
-        }
-        parent_ = parent;
-        parent_->children_.insert(this);
-        parent_->sortChildren_ = false;
+        if (parent_ != nullptr)
+            parent_->removeChild(this);
+        if (parent != nullptr)
+            parent->addChild(this);
     }
     void Block::hide() {
         hide_ = true;
+        markDirty();
         ViewChanged(false);
         for (auto child : children_)
             child->hide();
     }
     void Block::show() {
         hide_ = false;
+        markDirty();
         ViewChanged(true);
         for (auto child : children_)
             child->show();
@@ -139,6 +268,74 @@ namespace GFt {
     bool Block::isHide() const {
         return hide_;
     }
+    void Block::markDirty() {
+        damaged_ = true;
+        markTreeDirty();
+    }
+    /// @details 不在遇到已标记的祖先时提前停止：移入新的父对象的子树可能保留着标记，
+    ///          而其新的祖先尚未被标记
+    /// @details 同时使此对象及其祖先对象的绘制缓存失效
+    void Block::markTreeDirty() {
+        for (auto block = this; block; block = block->parent_) {
+            block->dirty_ = true;
+            block->cacheValid_ = false;
+        }
+    }
+    /// @details 与 handleOnDraw() 中跳过子对象的条件一致
+    bool Block::drawsChild(const Block* child, bool cilpO) const {
+        return !cilpO || static_cast<bool>(child->rect() & this->rect());
+    }
+    /// @details 移出对象树时交出此对象及其子对象上次绘制的区域，重新加入对象树后将完整重绘
+    void Block::releasePainted(std::vector<iRect>& damage) {
+        damage.push_back(painted_);
+        painted_ = iRect();
+        damaged_ = dirty_ = true;
+        for (auto child : children_)
+            child->releasePainted(damage);
+    }
+    /// @details 只进入被标记的子树；对象移动或改变大小时其子对象的绝对位置随之改变，
+    ///          因此整棵子树都需要重新计算绘制区域
+    /// @param visible 父对象是否会绘制此对象
+    /// @param moved 祖先对象的绘制区域是否改变
+    void Block::collectDamage(DamageRegion& region, const iPoint& lefttop, bool cilpO, bool visible, bool moved) {
+        if (!dirty_ && !moved)
+            return;
+        for (auto& rect : damage_)
+            region.add(rect);
+        damage_.clear();
+        iRect area = visible && !hide_ ? iRect(lefttop, rect().size()) : iRect();
+        if (damaged_ || area != painted_) {
+            region.add(painted_);
+            region.add(area);
+        }
+        moved = moved || area != painted_;
+        painted_ = area;
+        dirty_ = damaged_ = false;
+        for (auto child : children_)
+            child->collectDamage(region, lefttop + child->rect().position(), cilpO,
+                visible && drawsChild(child, cilpO), moved);
+    }
+    void Block::update() {
+        markDirty();
+        Application::requestFrame();
+    }
+    bool Block::isDirty() const { return dirty_; }
+    /// @details 仅移动时此对象的缓存内容不变，大小改变时缓存在绘制时重建
+    void Block::rectChanged() {
+        invalidatePosition();
+        if (parent_ != nullptr)
+            parent_->hitGridValid_ = false;
+        auto cacheValid = cacheValid_ && cache_ && cache_->size() == rect().size();
+        markDirty();
+        cacheValid_ = cacheValid;
+    }
+    void Block::setCacheMode(CacheMode mode) {
+        cacheMode_ = mode;
+        if (mode == CacheMode::None)
+            cache_.reset();
+        markDirty();
+    }
+    Block::CacheMode Block::getCacheMode() const { return cacheMode_; }
     int Block::getZIndex() const { return zIndex_; }
     Block* Block::getParent() const { return parent_; }
 
@@ -146,40 +343,112 @@ namespace GFt {
         return this->absolutePosition() - block->absolutePosition();
     }
 
+    /// @details 先置位再查询，查询期间窗口再次移动时标记会被清除，下次使用时重新查询
     iPoint Block::absolutePosition() const {
-        if (parent_ == nullptr) {
-            RECT crect;
-            GetClientRect(getHWnd(), &crect);
-            POINT p = { crect.left, crect.top };
-            ClientToScreen(getHWnd(), &p);
-            return iPoint{ p.x, p.y };
+        if (!windowOriginValid.exchange(true)) {
+            windowOrigin = Backend::instance().clientRect().position();
         }
-        return rect().position() + parent_->absolutePosition();
+        return windowOrigin + rootOffset();
     }
-
-    void Block::handleOnDraw(const iPoint& lefttop, bool cilpO) {
-        static Graphics g;
-        // 设置裁剪区域
-        /// @bug 此函数应裁剪到自身的范围
-        setviewport(lefttop.x(), lefttop.y(), lefttop.x() + rect().width(), lefttop.y() + rect().height(), 0);
-        // 调用自身的绘制函数
-        if (!this->hide_) {
-            this->onDraw(g);
-        }
-        if (!sortChildren_) {
-            // 元素重排
-            std::multiset<Block*, CompareByZIndex> new_set;
+    void Block::invalidateWindowOrigin() { windowOriginValid = false; }
+    Block* Block::childAt(const iPoint& pos) const {
+        if (children_.size() < hitGridThreshold) {
             for (auto child : children_)
-                new_set.insert(child);
-            children_.swap(new_set);
-            sortChildren_ = true;
-        }
-        // 调用子节点的绘制事件处理函数
-        using Iter = std::reverse_iterator<std::multiset<GFt::Block*, GFt::Block::CompareByZIndex>::iterator>;
-        for (Iter riter = children_.rbegin(); riter != children_.rend(); ++riter) {
-            auto child = *riter;
+                if (containsPoint(iRect{ child->absolutePosition(), child->rect().size() }, pos))
+                    return child;
+            return nullptr;
+        }
+        if (!hitGrid_)
+            hitGrid_ = std::make_unique<HitGrid>();
+        if (!hitGridValid_) {
+            hitGrid_->build(children_);
+            hitGridValid_ = true;
+        }
+        return hitGrid_->find(children_, pos - absolutePosition());
+    }
+    iPoint Block::rootOffset() const {
+        if (!rootOffsetValid_) {
+            rootOffset_ = parent_ ? rect().position() + parent_->rootOffset() : iPoint();
+            rootOffsetValid_ = true;
+        }
+        return rootOffset_;
+    }
+    /// @details 有效的缓存只依赖有效的祖先缓存，因此遇到已失效的对象时其子树必然已失效
+    void Block::invalidatePosition() {
+        if (!rootOffsetValid_)
+            return;
+        rootOffsetValid_ = false;
+        for (auto child : children_)
+            child->invalidatePosition();
+    }
+
+    /// @details 给出重绘区域时，只绘制与其相交的对象，并将绘制裁剪到该区域内
+    void Block::handleOnDraw(const iPoint& lefttop, bool cilpO, const DamageRegion* damage) {
+        if (cacheMode_ == CacheMode::Cached)
+            drawCache(lefttop, cilpO, damage);
+        else
+            drawSubtree(lefttop, cilpO, damage);
+    }
+    /// @details 缓存失效或大小改变时先将子树绘制到缓存中，再将缓存复制到当前的绘制目标；
+    ///          子树中的其它缓存对象会被绘制到此缓存中
+    /// @details 缓存在清除并绘制子树之前即被标记为有效，绘制期间子对象再次标记重绘时缓存随之失效，
+    ///          下一帧会重新绘制，而不是复制已过时的内容
+    void Block::drawCache(const iPoint& lefttop, bool cilpO, const DamageRegion* damage) {
+        iRect area(lefttop, rect().size());
+        if (damage && !damage->intersects(area))
+            return;
+        if (!std::exchange(cacheValid_, true)) {
+            if (!cache_ || cache_->size() != rect().size())
+                cache_ = std::make_unique<PixelMap>(rect().size());
+            auto previous = std::exchange(drawTarget, cache_.get());
+            canvas().setTarget(drawTarget);
+            _clear_image(cache_->pixmap_);
+            cache_->setAlpha(0);
+            drawSubtree(iPoint(), cilpO, nullptr);
+            drawTarget = previous;
+            canvas().setTarget(drawTarget);
+        }
+        _set_viewport(targetImage(), area);
+        if (!damage)
+            return canvas().drawAlphaImage(*cache_, fPoint(), fRect(fPoint(), fSize(rect().size())));
+        // 位图复制不受绘图设备的裁剪区域限制，因此逐个复制与重绘区域相交的部分
+        for (auto& damaged : damage->rects()) {
+            auto part = intersection(area, damaged);
+            if (part.width() <= 0 || part.height() <= 0)
+                continue;
+            auto src = fRect(fPoint(part.position() - lefttop), fSize(part.size()));
+            canvas().drawAlphaImage(*cache_, src.position(), src);
+        }
+    }
+    void Block::setCanvasRasterMode(Graphics::RasterMode mode) { canvas().setRasterMode(mode); }
+    Graphics::RasterMode Block::canvasRasterMode() { return canvas().getRasterMode(); }
+    /// @details 在每帧绘制结束时调用；裁剪区域指向的重绘区域只在本帧内有效，因此同时将其清除
+    void Block::flushCanvas() {
+        auto& g = canvas();
+        g.flush();
+        g.setClipRegion(nullptr);
+    }
+    void Block::drawSubtree(const iPoint& lefttop, bool cilpO, const DamageRegion* damage) {
+        auto& g = canvas();
+        if (!damage || damage->intersects(iRect(lefttop, rect().size()))) {
+            // 设置裁剪区域
+            /// @bug 此函数应裁剪到自身的范围
+            _set_viewport(targetImage(), iRect(lefttop, rect().size()));
+            if (damage)
+                Backend::instance().clipToDamage(*damage);
+            g.setClipRegion(damage);
+            // 调用自身的绘制函数
+            if (!this->hide_) {
+                this->onDraw(g);
+            }
+        }
+        // 调用子节点的绘制事件处理函数，绘制期间子对象可能被增删，因此按下标访问
+        for (auto i = children_.size(); i-- > 0;) {
+            if (i >= children_.size())
+                continue;
+            auto child = children_[i];
             if (!cilpO || child->rect() & this->rect()) // 子节点与自身有交集才触发绘制
-                child->handleOnDraw(lefttop + child->rect().position(), cilpO);
+                child->handleOnDraw(lefttop + child->rect().position(), cilpO, damage);
         }
     }
     /// @cond IGNORE
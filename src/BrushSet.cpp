@@ -1,47 +1,69 @@
 #include "GraceFt/BrushSet.h"
 
-#include <_private.inl>
-#include <ege.h>
+#include <_private_draw.inl>
+#include <algorithm>
+#include <utility>
 
 #define BRUSH(x) (static_cast<BrushSetPrivate*>(brush_))
 
 namespace GFt {
     using namespace _GFt_private_;
+    namespace {
+        /// @brief 深复制画刷属性，多边形渐变的顶点与颜色数组被一并复制
+        BrushSetPrivate* cloneBrush(const void* brush) {
+            auto copy = new BrushSetPrivate(*static_cast<const BrushSetPrivate*>(brush));
+            if (copy->mode == static_cast<int>(BrushStyle::PolygonGradient)) {
+                auto& polygon = copy->polygon;
+                auto points = new float[polygon.num_points * 2];
+                auto colors = new unsigned int[polygon.num_colors];
+                std::copy_n(polygon.points, polygon.num_points * 2, points);
+                std::copy_n(polygon.colors, polygon.num_colors, colors);
+                polygon.points = points;
+                polygon.colors = colors;
+            }
+            return copy;
+        }
+    }
     void BrushSet::release() {
-        if (BRUSH(brush_)->mode == static_cast<int>(BrushStyle::PolygonGradient)) {
-            delete BRUSH(brush_)->polygon.points;
-            delete BRUSH(brush_)->polygon.colors;
+        if (brush_ && BRUSH(brush_)->mode == static_cast<int>(BrushStyle::PolygonGradient)) {
+            delete[] BRUSH(brush_)->polygon.points;
+            delete[] BRUSH(brush_)->polygon.colors;
         }
     }
     BrushSet::BrushSet(const Color& color) {
         brush_ = new BrushSetPrivate;
         BRUSH(brush_)->mode = static_cast<int>(BrushStyle::Default);
-        BRUSH(brush_)->def.color = EGERGBA(color.red(), color.green(), color.blue(), color.alpha());
+        BRUSH(brush_)->def.color = _pack_color(color);
         BRUSH(brush_)->def.style = static_cast<int>(FillStyle::Solid);
+        version_ = _next_state_version();
     }
     BrushSet::BrushSet(const BrushSet& other) {
-        brush_ = new BrushSetPrivate;
-        *BRUSH(brush_) = *BRUSH(&other);
+        brush_ = cloneBrush(other.brush_);
+        version_ = _next_state_version();
     }
 
     BrushSet::BrushSet(BrushSet&& other) {
         brush_ = other.brush_;
         other.brush_ = nullptr;
+        version_ = std::exchange(other.version_, _next_state_version());
     }
     BrushSet& BrushSet::operator=(const BrushSet& other) {
         if (this == &other)
             return *this;
+        release();
         delete BRUSH(brush_);
-        brush_ = new BrushSetPrivate;
-        *BRUSH(brush_) = *BRUSH(&other);
+        brush_ = cloneBrush(other.brush_);
+        version_ = _next_state_version();
         return *this;
     }
     BrushSet& BrushSet::operator=(BrushSet&& other) {
         if (this == &other)
             return *this;
+        release();
         delete BRUSH(brush_);
         brush_ = other.brush_;
         other.brush_ = nullptr;
+        version_ = std::exchange(other.version_, _next_state_version());
         return *this;
     }
     BrushSet::~BrushSet() {
@@ -51,38 +73,41 @@ namespace GFt {
 
     void BrushSet::setFillStyle(const Color& color, FillStyle style) {
         release();
+        version_ = _next_state_version();
         BRUSH(brush_)->mode = static_cast<int>(BrushStyle::Default);
         BRUSH(brush_)->def.style = static_cast<int>(style);
-        BRUSH(brush_)->def.color = EGERGBA(color.red(), color.green(), color.blue(), color.alpha());
+        BRUSH(brush_)->def.color = _pack_color(color);
     }
     void BrushSet::setTexture(const Texture& texture, const fRect& rect) {
         release();
+        version_ = _next_state_version();
         BRUSH(brush_)->mode = static_cast<int>(BrushStyle::Texture);
         BRUSH(brush_)->texture.x = rect.x();
         BRUSH(brush_)->texture.y = rect.y();
         BRUSH(brush_)->texture.w = rect.width();
         BRUSH(brush_)->texture.h = rect.height();
         BRUSH(brush_)->texture.data = texture.texture_;
+        BRUSH(brush_)->texture.version = static_cast<TexturePrivate*>(texture.texture_)->version;
     }
 
     void BrushSet::setLinearGradient(
         const fPoint& start, const Color& startColor,
         const fPoint& end, const Color& endColor) {
         release();
+        version_ = _next_state_version();
         BRUSH(brush_)->mode = static_cast<int>(BrushStyle::LinearGradient);
         BRUSH(brush_)->linear.x1 = start.x();
         BRUSH(brush_)->linear.y1 = start.y();
         BRUSH(brush_)->linear.x2 = end.x();
         BRUSH(brush_)->linear.y2 = end.y();
-        BRUSH(brush_)->linear.color1 = EGERGBA(
-            startColor.red(), startColor.green(), startColor.blue(), startColor.alpha());
-        BRUSH(brush_)->linear.color2 = EGERGBA(
-            endColor.red(), endColor.green(), endColor.blue(), endColor.alpha());
+        BRUSH(brush_)->linear.color1 = _pack_color(startColor);
+        BRUSH(brush_)->linear.color2 = _pack_color(endColor);
     }
     void BrushSet::setRadialGradient(
         const fPoint& center, const Color& centerColor,
         const fRect& rect, const Color& outerColor) {
         release();
+        version_ = _next_state_version();
         BRUSH(brush_)->mode = static_cast<int>(BrushStyle::RadialGradient);
         BRUSH(brush_)->radial.cx = center.x();
         BRUSH(brush_)->radial.cy = center.y();
@@ -90,21 +115,19 @@ namespace GFt {
         BRUSH(brush_)->radial.y = rect.y();
         BRUSH(brush_)->radial.w = rect.width();
         BRUSH(brush_)->radial.h = rect.height();
-        BRUSH(brush_)->radial.ccolor = EGERGBA(
-            centerColor.red(), centerColor.green(), centerColor.blue(), centerColor.alpha());
-        BRUSH(brush_)->radial.ocolor = EGERGBA(
-            outerColor.red(), outerColor.green(), outerColor.blue(), outerColor.alpha());
+        BRUSH(brush_)->radial.ccolor = _pack_color(centerColor);
+        BRUSH(brush_)->radial.ocolor = _pack_color(outerColor);
     }
 
     void BrushSet::setPolygonGradient(
         const fPoint& center, const Color& centerColor,
         const std::vector<fPoint>& points, const std::vector<Color>& colors) {
         release();
+        version_ = _next_state_version();
         BRUSH(brush_)->mode = static_cast<int>(BrushStyle::PolygonGradient);
         BRUSH(brush_)->polygon.cx = center.x();
         BRUSH(brush_)->polygon.cy = center.y();
-        BRUSH(brush_)->polygon.ccolor = EGERGBA(
-            centerColor.red(), centerColor.green(), centerColor.blue(), centerColor.alpha());
+        BRUSH(brush_)->polygon.ccolor = _pack_color(centerColor);
         BRUSH(brush_)->polygon.num_points = static_cast<int>(points.size());
         BRUSH(brush_)->polygon.num_colors = static_cast<int>(colors.size());
         BRUSH(brush_)->polygon.points = new float[points.size() * 2];
@@ -114,10 +137,21 @@ namespace GFt {
             BRUSH(brush_)->polygon.points[i * 2 + 1] = points[i].y();
         }
         for (int i = 0; i < colors.size(); i++)
-            BRUSH(brush_)->polygon.colors[i] = EGERGBA(
-                colors[i].red(), colors[i].green(), colors[i].blue(), colors[i].alpha());
+            BRUSH(brush_)->polygon.colors[i] = _pack_color(colors[i]);
     }
     BrushStyle BrushSet::getBrushStyle() const {
         return static_cast<BrushStyle>(BRUSH(brush_)->mode);
     }
+    /// @details 纹理画刷的纹理被重新赋值后，首次获取时更新版本号
+    std::uint64_t BrushSet::version() const {
+        if (brush_ && BRUSH(brush_)->mode == static_cast<int>(BrushStyle::Texture)) {
+            auto& texture = BRUSH(brush_)->texture;
+            auto current = static_cast<TexturePrivate*>(texture.data)->version;
+            if (texture.version != current) {
+                texture.version = current;
+                version_ = _next_state_version();
+            }
+        }
+        return version_;
+    }
 }
\ No newline at end of file
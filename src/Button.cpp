@@ -14,24 +14,26 @@ namespace GFt {
             HoverOn.connect([this](Block*) {
                 if (this->isDisabled()) return;
                 this->brushSet_.setFillStyle(this->hoverColor_);
+                this->markDirty();
                 });
             HoverOff.connect([this](Block*) {
                 if (this->isDisabled()) return;
                 this->brushSet_.setFillStyle(this->backgroundColor_);
+                this->markDirty();
                 });
         }
         Button::Button(const iRect& rect, Block* parent, int zIndex)
             : Button(L"", rect, parent, zIndex) {}
         Button::~Button() {}
 
-        std::wstring& Button::text() { return text_; }
-        Color& Button::textColor() { return textColor_; }
-        Color& Button::backgroundColor() { return backgroundColor_; }
-        Color& Button::hoverColor() { return hoverColor_; }
-        Color& Button::pressedColor() { return pressedColor_; }
-        Color& Button::disabledColor() { return disabledColor_; }
-        BrushSet& Button::brushSet() { return brushSet_; }
-        TextSet& Button::textSet() { return textSet_; }
+        std::wstring& Button::text() { markDirty(); return text_; }
+        Color& Button::textColor() { markDirty(); return textColor_; }
+        Color& Button::backgroundColor() { markDirty(); return backgroundColor_; }
+        Color& Button::hoverColor() { markDirty(); return hoverColor_; }
+        Color& Button::pressedColor() { markDirty(); return pressedColor_; }
+        Color& Button::disabledColor() { markDirty(); return disabledColor_; }
+        BrushSet& Button::brushSet() { markDirty(); return brushSet_; }
+        TextSet& Button::textSet() { markDirty(); return textSet_; }
 
         const std::wstring& Button::text() const { return text_; }
         const Color& Button::textColor() const { return textColor_; }
@@ -52,6 +54,7 @@ namespace GFt {
                 this->brushSet_.setFillStyle(backgroundColor_);
                 this->textSet_.setColor(textColor_);
             }
+            markDirty();
         }
         bool Button::isDisabled() const { return disabled_; }
 
@@ -66,6 +69,7 @@ namespace GFt {
         void Button::onMouseButtonPress(MouseButtonPressEvent* event) {
             if (disabled_) return;
             this->brushSet_.setFillStyle(this->pressedColor_);
+            markDirty();
             if (event->button() == MouseButton::Left)
                 onStatusChanged(true);
             return Block::onMouseButtonPress(event);
@@ -73,6 +77,7 @@ namespace GFt {
         void Button::onMouseButtonRelease(MouseButtonReleaseEvent* event) {
             if (disabled_) return;
             this->brushSet_.setFillStyle(this->hoverColor_);
+            markDirty();
             if (event->button() == MouseButton::Left)
                 onStatusChanged(false);
             return Block::onMouseButtonRelease(event);
@@ -57,6 +57,7 @@ namespace GFt {
         void CheckBox::setChecked(bool checked) {
             if (isChecked() == checked) return;
             checked_ = checked;
+            markDirty();
             onCheckChanged(checked_);
             checked_ ? onChecked() : onUnchecked();
         }
@@ -65,13 +66,13 @@ namespace GFt {
             return checked_;
         }
 
-        std::wstring& CheckBox::text() { return text_; }
-        Font& CheckBox::hoverFont() { return hoverfont_; }
-        Font& CheckBox::normalFont() { return normalfont_; }
-        Font& CheckBox::selectedFont() { return selectedfont_; }
-        BrushSet& CheckBox::hoverBrush() { return hoverbs_; }
-        BrushSet& CheckBox::normalBrush() { return normalbs_; }
-        BrushSet& CheckBox::selectedBrush() { return selectedbs_; }
+        std::wstring& CheckBox::text() { markDirty(); return text_; }
+        Font& CheckBox::hoverFont() { markDirty(); return hoverfont_; }
+        Font& CheckBox::normalFont() { markDirty(); return normalfont_; }
+        Font& CheckBox::selectedFont() { markDirty(); return selectedfont_; }
+        BrushSet& CheckBox::hoverBrush() { markDirty(); return hoverbs_; }
+        BrushSet& CheckBox::normalBrush() { markDirty(); return normalbs_; }
+        BrushSet& CheckBox::selectedBrush() { markDirty(); return selectedbs_; }
 
         const std::wstring& CheckBox::text() const { return text_; }
         const Font& CheckBox::hoverFont() const { return hoverfont_; }
@@ -1,7 +1,65 @@
 #include "GraceFt/Color.h"
+#ifdef GFT_HEADLESS
+#include <algorithm>
+#include <cmath>
+#else
 #include <ege.h>
+#endif
 
 namespace GFt {
+#ifdef GFT_HEADLESS
+    namespace {
+        /// @brief 色相，单位为度；无彩色时为 0
+        float hueOf(float r, float g, float b, float max, float delta) {
+            if (delta <= 0)
+                return 0;
+            float h = max == r ? std::fmod((g - b) / delta, 6.f) : max == g ? (b - r) / delta + 2 : (r - g) / delta + 4;
+            return h < 0 ? h * 60 + 360 : h * 60;
+        }
+        /// @brief 由色相与色度得到颜色，m 为各通道共同的增量
+        Color fromChroma(float h, float c, float m) {
+            h = std::fmod(std::fmod(h, 360.f) + 360, 360.f) / 60;
+            float x = c * (1 - std::abs(std::fmod(h, 2.f) - 1));
+            float rgb[6][3] = { { c, x, 0 }, { x, c, 0 }, { 0, c, x }, { 0, x, c }, { x, 0, c }, { c, 0, x } };
+            auto& p = rgb[std::min(static_cast<int>(h), 5)];
+            auto channel = [m](float v) { return static_cast<byte>(std::lround(std::clamp(v + m, 0.f, 1.f) * 255)); };
+            return Color(channel(p[0]), channel(p[1]), channel(p[2]));
+        }
+    }
+    std::tuple<float, float, float> Color::toHSL() const {
+        float r = red_ / 255.f, g = green_ / 255.f, b = blue_ / 255.f;
+        float max = std::max({ r, g, b }), min = std::min({ r, g, b }), delta = max - min;
+        float l = (max + min) / 2;
+        float s = delta <= 0 ? 0 : delta / (1 - std::abs(2 * l - 1));
+        return { hueOf(r, g, b, max, delta), s, l };
+    }
+    std::tuple<float, float, float> Color::toHSV() const {
+        float r = red_ / 255.f, g = green_ / 255.f, b = blue_ / 255.f;
+        float max = std::max({ r, g, b }), min = std::min({ r, g, b }), delta = max - min;
+        return { hueOf(r, g, b, max, delta), max <= 0 ? 0 : delta / max, max };
+    }
+    /// @details 亮度为 (77R + 150G + 29B) / 256，与 BasicPixelView::setPixel() 相同
+    Color Color::toGray() const {
+        auto gray = static_cast<byte>((red_ * 77 + green_ * 150 + blue_ * 29) >> 8);
+        return Color(gray, gray, gray, alpha_);
+    }
+    /// @details 以 other 的透明度将其混合到此颜色上，结果的透明度与此颜色相同
+    Color Color::blend(const Color& other) const {
+        auto mix = [a = other.alpha_](byte dst, byte src) {
+            return static_cast<byte>(dst + ((src - dst) * a + 127) / 255);
+        };
+        return Color(mix(red_, other.red_), mix(green_, other.green_), mix(blue_, other.blue_), alpha_);
+    }
+
+    Color Color::fromHSL(float h, float s, float l) {
+        float c = (1 - std::abs(2 * l - 1)) * s;
+        return fromChroma(h, c, l - c / 2);
+    }
+    Color Color::fromHSV(float h, float s, float v) {
+        float c = v * s;
+        return fromChroma(h, c, v - c);
+    }
+#else
     std::tuple<float, float, float> Color::toHSL() const {
         using namespace ege;
         float h, s, l;
@@ -38,6 +96,7 @@ namespace GFt {
         auto rgb = HSVtoRGB(h, s, v);
         return Color(EGEGET_R(rgb), EGEGET_G(rgb), EGEGET_B(rgb), EGEGET_A(rgb));
     }
+#endif
     std::ostream& operator<<(std::ostream& os, const Color& color) {
         os << "Color(R: "
             << static_cast<int>(color.red()) << ", G: "
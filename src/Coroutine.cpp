@@ -0,0 +1,57 @@
+#include "GraceFt/Coroutine.hpp"
+#include <GraceFt/Application.h>
+
+namespace GFt {
+    TaskScheduler::TaskScheduler() {
+        Application::onEventCall.connect(this, &TaskScheduler::update);
+    }
+    /// @details 依次恢复上一帧登记的等待下一帧的协程、已到期的定时协程，
+    ///          最后执行其它线程投递的函数；本帧中新登记的等待不会在本帧被恢复
+    /// @details 结束时按剩余的等待请求下一帧或最近的定时器到期时刻
+    void TaskScheduler::update() {
+        std::vector<std::coroutine_handle<>> frame;
+        frame.swap(nextFrame_);
+        for (auto handle : frame)
+            handle.resume();
+        auto now = Clock::now();
+        std::vector<std::coroutine_handle<>> due;
+        while (!timers_.empty() && timers_.top().deadline <= now) {
+            due.push_back(timers_.top().handle);
+            timers_.pop();
+        }
+        for (auto handle : due)
+            handle.resume();
+        std::vector<std::function<void()>> posted;
+        {
+            std::lock_guard<std::mutex> lock(postMutex_);
+            posted.swap(posted_);
+        }
+        for (auto& func : posted)
+            func();
+        if (!nextFrame_.empty())
+            Application::requestFrame();
+        else if (!timers_.empty())
+            Application::requestFrame(timers_.top().deadline);
+    }
+    void TaskScheduler::resumeNextFrame(std::coroutine_handle<> handle) {
+        getInstance().nextFrame_.push_back(handle);
+        Application::requestFrame();
+    }
+    void TaskScheduler::resumeAt(Clock::time_point deadline, std::coroutine_handle<> handle) {
+        getInstance().timers_.push(Timer{ deadline, handle });
+        Application::requestFrame(deadline);
+    }
+    void TaskScheduler::post(std::function<void()> func) {
+        auto& instance = getInstance();
+        {
+            std::lock_guard<std::mutex> lock(instance.postMutex_);
+            instance.posted_.push_back(std::move(func));
+        }
+        Application::requestFrame();
+    }
+    /// @details 首次调用可能来自其它线程的 post()，局部静态变量的初始化保证只构造并连接一次
+    TaskScheduler& TaskScheduler::getInstance() {
+        static TaskScheduler instance;
+        return instance;
+    }
+}
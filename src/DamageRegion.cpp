@@ -0,0 +1,74 @@
+#include "GraceFt/DamageRegion.h"
+#include <algorithm>
+#include <limits>
+
+namespace GFt {
+    namespace {
+        bool isEmpty(const iRect& rect) { return rect.width() <= 0 || rect.height() <= 0; }
+        bool overlaps(const iRect& a, const iRect& b) {
+            return a.left() < b.right() && b.left() < a.right() && a.top() < b.bottom() && b.top() < a.bottom();
+        }
+        iRect bounds(const iRect& a, const iRect& b) {
+            auto left = std::min(a.left(), b.left());
+            auto top = std::min(a.top(), b.top());
+            return iRect(left, top, std::max(a.right(), b.right()) - left, std::max(a.bottom(), b.bottom()) - top);
+        }
+        long long areaOf(const iRect& rect) { return static_cast<long long>(rect.width()) * rect.height(); }
+    }
+
+    DamageRegion::DamageRegion(std::size_t maxRects) : maxRects_(std::max<std::size_t>(maxRects, 1)) {}
+
+    /// @details 从区域中取出使外接矩形面积增加最少的一对矩形，返回其外接矩形
+    iRect DamageRegion::takeClosestPair() {
+        std::size_t first = 0, second = 1;
+        auto best = std::numeric_limits<long long>::max();
+        for (std::size_t i = 0; i < rects_.size(); ++i)
+            for (std::size_t j = i + 1; j < rects_.size(); ++j) {
+                auto waste = areaOf(bounds(rects_[i], rects_[j])) - areaOf(rects_[i]) - areaOf(rects_[j]);
+                if (waste < best) {
+                    best = waste;
+                    first = i;
+                    second = j;
+                }
+            }
+        auto merged = bounds(rects_[first], rects_[second]);
+        rects_[second] = rects_.back();
+        rects_.pop_back();
+        rects_[first] = rects_.back();
+        rects_.pop_back();
+        return merged;
+    }
+    /// @details 合并后的外接矩形可能与其它矩形重叠，因此重复合并直到不再重叠
+    void DamageRegion::add(const iRect& rect) {
+        if (isEmpty(rect))
+            return;
+        auto merged = rect;
+        for (std::size_t i = 0; i < rects_.size();) {
+            if (!overlaps(rects_[i], merged)) {
+                ++i;
+                continue;
+            }
+            merged = bounds(rects_[i], merged);
+            rects_[i] = rects_.back();
+            rects_.pop_back();
+            i = 0;
+        }
+        rects_.push_back(merged);
+        // 合并最近的一对后其外接矩形同样可能与其它矩形重叠
+        if (rects_.size() > maxRects_)
+            add(takeClosestPair());
+    }
+    void DamageRegion::clear() { rects_.clear(); }
+    bool DamageRegion::empty() const { return rects_.empty(); }
+    bool DamageRegion::intersects(const iRect& rect) const {
+        return !isEmpty(rect) && std::any_of(rects_.begin(), rects_.end(),
+            [&rect](const iRect& r) { return overlaps(r, rect); });
+    }
+    const std::vector<iRect>& DamageRegion::rects() const { return rects_; }
+    long long DamageRegion::area() const {
+        long long total = 0;
+        for (auto& rect : rects_)
+            total += areaOf(rect);
+        return total;
+    }
+}
@@ -0,0 +1,434 @@
+#include "GraceFt/DisplayList.h"
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+namespace GFt {
+    enum class DisplayList::Op : std::uint8_t {
+        // 状态命令
+        AntiAliasing, Transform, Background, PenSet, BrushSet, TextSet,
+        // 绘制命令
+        Clear,
+        Line, Rect, RoundRect, Arc, Ellipse, Circle, Pie, Polygon, Bezier, FitCurve, Path,
+        FillRect, FillRoundRect, FillPie, FillPolygon, FillEllipse, FillCircle, FillFitCurve, FillPath,
+        Image, ImageRect, AlphaImage, AlphaImageRect,
+        Text, TextRect,
+    };
+
+    namespace {
+        /// @brief 仿射变换矩阵中有意义的 6 个元素
+        struct Affine {
+            float m[6];
+            bool operator==(const Affine& other) const { return std::memcmp(m, other.m, sizeof(m)) == 0; }
+        };
+        constexpr Affine identity{ { 1, 0, 0, 1, 0, 0 } };
+
+        class Reader {
+            const std::uint8_t* pos_;
+        public:
+            explicit Reader(const std::uint8_t* pos) : pos_(pos) {}
+            const std::uint8_t* position() const { return pos_; }
+            template<typename T>
+            T read() {
+                static_assert(std::is_trivially_copyable_v<T>);
+                // 部分几何类型没有默认构造函数，经由字节数组转换
+                std::array<std::uint8_t, sizeof(T)> bytes;
+                std::memcpy(bytes.data(), pos_, sizeof(T));
+                pos_ += sizeof(T);
+                return std::bit_cast<T>(bytes);
+            }
+        };
+
+        /// @brief 回放时尚未生效的状态
+        template<typename T>
+        struct Pending {
+            T value{};
+            bool pending = false;
+            bool known = false;     // 绘图设备上的状态是否已知
+            T applied{};
+
+            /// @brief 记录新的状态，返回被覆盖而未生效的旧状态的数量
+            std::size_t set(const T& v) {
+                auto overwritten = pending ? 1 : 0;
+                value = v;
+                pending = true;
+                return overwritten;
+            }
+            /// @brief 使状态生效，与已生效的状态相同时返回 false
+            template<typename Apply>
+            bool commit(Apply&& apply) {
+                pending = false;
+                if (known && applied == value)
+                    return false;
+                apply(value);
+                applied = value;
+                known = true;
+                return true;
+            }
+        };
+        /// @brief 配置在快照表中的位置，0 表示默认配置(nullptr)
+        /// @details 按记录时的版本号比较
+        struct StateRef {
+            std::uint32_t index;
+            std::uint64_t version;
+            bool operator==(const StateRef& other) const { return version == other.version; }
+        };
+        struct PackedColor {
+            std::uint8_t r, g, b, a;
+            bool operator==(const PackedColor& other) const {
+                return r == other.r && g == other.g && b == other.b && a == other.a;
+            }
+        };
+    }
+
+    template<typename T>
+    void DisplayList::write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        auto size = stream_.size();
+        stream_.resize(size + sizeof(T));
+        std::memcpy(stream_.data() + size, &value, sizeof(T));
+    }
+    void DisplayList::writeOp(Op op, bool draw) {
+        write(op);
+        commands_++;
+        drawCalls_ += draw;
+    }
+    void DisplayList::writeMatrix(const fMat3x3& m) {
+        write(Affine{ { m[0][0], m[0][1], m[1][0], m[1][1], m[2][0], m[2][1] } });
+    }
+    std::uint32_t DisplayList::addFonts(const std::vector<std::wstring>& fonts) {
+        if (fonts.empty())
+            return 0;
+        fonts_.push_back(fonts);
+        return static_cast<std::uint32_t>(fonts_.size());
+    }
+
+    /// @details 与上一次复制的配置版本相同时复用其快照
+    template<typename Set>
+    void DisplayList::writeState(Op op, Snapshots<Set>& table, const Set* set) {
+        writeOp(op, false);
+        if (!set)
+            return write(StateRef{ 0, 0 });
+        if (table.versions.empty() || table.versions.back() != set->version()) {
+            table.sets.push_back(*set);
+            table.versions.push_back(set->version());
+        }
+        write(StateRef{ static_cast<std::uint32_t>(table.sets.size()), set->version() });
+    }
+
+    void DisplayList::reset() {
+        stream_.clear();
+        polygons_.clear();
+        beziers_.clear();
+        curves_.clear();
+        strings_.clear();
+        fonts_.clear();
+        pens_ = {};
+        brushes_ = {};
+        texts_ = {};
+        commands_ = drawCalls_ = 0;
+    }
+    bool DisplayList::empty() const { return commands_ == 0; }
+    std::size_t DisplayList::size() const { return commands_; }
+    std::size_t DisplayList::drawCalls() const { return drawCalls_; }
+    std::size_t DisplayList::bytes() const { return stream_.size(); }
+
+    void DisplayList::setAntiAliasing(bool enable) {
+        writeOp(Op::AntiAliasing, false);
+        write(enable);
+    }
+    void DisplayList::setTransform(const fMat3x3& matrix) {
+        writeOp(Op::Transform, false);
+        writeMatrix(matrix);
+    }
+    void DisplayList::resetTransform() {
+        writeOp(Op::Transform, false);
+        write(identity);
+    }
+    void DisplayList::clear() { writeOp(Op::Clear, true); }
+    void DisplayList::setBackgroundColor(const Color& color) {
+        writeOp(Op::Background, false);
+        write(PackedColor{ color.red(), color.green(), color.blue(), color.alpha() });
+    }
+    void DisplayList::bindPenSet(PenSet* penSet) { writeState(Op::PenSet, pens_, penSet); }
+    void DisplayList::bindBrushSet(BrushSet* brushSet) { writeState(Op::BrushSet, brushes_, brushSet); }
+    void DisplayList::bindTextSet(TextSet* textSet) { writeState(Op::TextSet, texts_, textSet); }
+
+    void DisplayList::drawLine(const fLine& line) {
+        writeOp(Op::Line, true);
+        write(line);
+    }
+    void DisplayList::drawRect(const fRect& rect) {
+        writeOp(Op::Rect, true);
+        write(rect);
+    }
+    void DisplayList::drawRoundRect(const fRoundRect& rect) {
+        writeOp(Op::RoundRect, true);
+        write(rect);
+    }
+    void DisplayList::drawArc(const fRect& rect, float startAngle, float sweepAngle) {
+        writeOp(Op::Arc, true);
+        write(rect);
+        write(startAngle);
+        write(sweepAngle);
+    }
+    void DisplayList::drawEllipse(const fEllipse& ellipse) {
+        writeOp(Op::Ellipse, true);
+        write(ellipse);
+    }
+    void DisplayList::drawCircle(const fCircle& circle) {
+        writeOp(Op::Circle, true);
+        write(circle);
+    }
+    void DisplayList::drawPie(const fRect& rect, float startAngle, float sweepAngle) {
+        writeOp(Op::Pie, true);
+        write(rect);
+        write(startAngle);
+        write(sweepAngle);
+    }
+    void DisplayList::drawPolygon(const fPolygon& polygon) {
+        writeOp(Op::Polygon, true);
+        write(static_cast<std::uint32_t>(polygons_.size()));
+        polygons_.push_back(polygon);
+    }
+    void DisplayList::drawBezier(const fBezier& curve) {
+        writeOp(Op::Bezier, true);
+        write(static_cast<std::uint32_t>(beziers_.size()));
+        beziers_.push_back(curve);
+    }
+    void DisplayList::drawFitCurve(const fFitCurve& curve) {
+        writeOp(Op::FitCurve, true);
+        write(static_cast<std::uint32_t>(curves_.size()));
+        curves_.push_back(curve);
+    }
+    void DisplayList::drawPath(const Path& path, const fPoint& pos) {
+        writeOp(Op::Path, true);
+        write(&path);
+        write(pos);
+    }
+
+    void DisplayList::drawFillRect(const fRect& rect) {
+        writeOp(Op::FillRect, true);
+        write(rect);
+    }
+    void DisplayList::drawFillRoundRect(const fRoundRect& rect) {
+        writeOp(Op::FillRoundRect, true);
+        write(rect);
+    }
+    void DisplayList::drawFillPie(const fRect& rect, float startAngle, float sweepAngle) {
+        writeOp(Op::FillPie, true);
+        write(rect);
+        write(startAngle);
+        write(sweepAngle);
+    }
+    void DisplayList::drawFillPolygon(const fPolygon& polygon) {
+        writeOp(Op::FillPolygon, true);
+        write(static_cast<std::uint32_t>(polygons_.size()));
+        polygons_.push_back(polygon);
+    }
+    void DisplayList::drawFillEllipse(const fEllipse& ellipse) {
+        writeOp(Op::FillEllipse, true);
+        write(ellipse);
+    }
+    void DisplayList::drawFillCircle(const fCircle& circle) {
+        writeOp(Op::FillCircle, true);
+        write(circle);
+    }
+    void DisplayList::drawFillFitCurve(const fFitCurve& curve) {
+        writeOp(Op::FillFitCurve, true);
+        write(static_cast<std::uint32_t>(curves_.size()));
+        curves_.push_back(curve);
+    }
+    void DisplayList::drawFillPath(const Path& path, const fPoint& pos) {
+        writeOp(Op::FillPath, true);
+        write(&path);
+        write(pos);
+    }
+
+    void DisplayList::drawImage(const fPoint& pos, const PixelMap& pixelMap) {
+        writeOp(Op::Image, true);
+        write(&pixelMap);
+        write(pos);
+    }
+    void DisplayList::drawImage(const fRect& dest, const fRect& src, const PixelMap& pixelMap) {
+        writeOp(Op::ImageRect, true);
+        write(&pixelMap);
+        write(dest);
+        write(src);
+    }
+    void DisplayList::drawAlphaImage(const PixelMap& pixelMap, const fPoint& dest, const fRect& src) {
+        writeOp(Op::AlphaImage, true);
+        write(&pixelMap);
+        write(dest);
+        write(src);
+    }
+    void DisplayList::drawAlphaImage(const PixelMap& pixelMap, const fRect& dest, const fRect& src, bool smooth) {
+        writeOp(Op::AlphaImageRect, true);
+        write(&pixelMap);
+        write(dest);
+        write(src);
+        write(smooth);
+    }
+
+    void DisplayList::drawText(const std::wstring& text, const fPoint& pos, const std::vector<std::wstring>& fonts) {
+        writeOp(Op::Text, true);
+        write(static_cast<std::uint32_t>(strings_.size()));
+        write(addFonts(fonts));
+        write(pos);
+        strings_.push_back(text);
+    }
+    void DisplayList::drawText(const std::wstring& text, const fRect& rect, int flags, const std::vector<std::wstring>& fonts) {
+        writeOp(Op::TextRect, true);
+        write(static_cast<std::uint32_t>(strings_.size()));
+        write(addFonts(fonts));
+        write(rect);
+        write(flags);
+        strings_.push_back(text);
+    }
+
+    /// @details 绘图设备在回放开始时的状态未知，因此每种状态的首次设置总会执行
+    DisplayList::Statistics DisplayList::replay(Graphics& g) const {
+        Statistics stats;
+        stats.commands = commands_;
+        Pending<bool> antiAliasing;
+        Pending<Affine> transform;
+        Pending<PackedColor> background;
+        Pending<StateRef> pen;
+        Pending<StateRef> brush;
+        Pending<StateRef> text;
+        // Graphics 只读取绑定的配置，不会修改快照
+        auto snapshotAt = [](const auto& table, const StateRef& ref) {
+            using Set = typename std::decay_t<decltype(table.sets)>::value_type;
+            return ref.index ? const_cast<Set*>(&table.sets[ref.index - 1]) : nullptr;
+        };
+        auto commit = [&](auto& state, auto&& apply) {
+            if (!state.pending)
+                return;
+            if (state.commit(apply))
+                stats.stateChanges++;
+            else
+                stats.elided++;
+        };
+        auto applyState = [&] {
+            commit(antiAliasing, [&](bool enable) { g.setAntiAliasing(enable); });
+            commit(transform, [&](const Affine& a) {
+                if (a == identity)
+                    return g.resetTransform();
+                fMat3x3 m = fMat3x3::I();
+                m[0][0] = a.m[0], m[0][1] = a.m[1], m[1][0] = a.m[2], m[1][1] = a.m[3], m[2][0] = a.m[4], m[2][1] = a.m[5];
+                g.setTransform(m);
+            });
+            commit(background, [&](const PackedColor& c) { g.setBackgroundColor(Color(c.r, c.g, c.b, c.a)); });
+            commit(pen, [&](const StateRef& p) { g.bindPenSet(snapshotAt(pens_, p)); });
+            commit(brush, [&](const StateRef& b) { g.bindBrushSet(snapshotAt(brushes_, b)); });
+            commit(text, [&](const StateRef& t) { g.bindTextSet(snapshotAt(texts_, t)); });
+        };
+        auto fontsAt = [&](std::uint32_t index) -> const std::vector<std::wstring>& {
+            static const std::vector<std::wstring> none;
+            return index ? fonts_[index - 1] : none;
+        };
+
+        Reader in(stream_.data());
+        auto end = stream_.data() + stream_.size();
+        while (in.position() < end) {
+            auto op = in.read<Op>();
+            if (op > Op::TextSet) {
+                applyState();
+                stats.drawCalls++;
+            }
+            switch (op) {
+            case Op::AntiAliasing: stats.elided += antiAliasing.set(in.read<bool>()); break;
+            case Op::Transform: stats.elided += transform.set(in.read<Affine>()); break;
+            case Op::Background: stats.elided += background.set(in.read<PackedColor>()); break;
+            case Op::PenSet: stats.elided += pen.set(in.read<StateRef>()); break;
+            case Op::BrushSet: stats.elided += brush.set(in.read<StateRef>()); break;
+            case Op::TextSet: stats.elided += text.set(in.read<StateRef>()); break;
+            case Op::Clear: g.clear(); break;
+            case Op::Line: g.drawLine(in.read<fLine>()); break;
+            case Op::Rect: g.drawRect(in.read<fRect>()); break;
+            case Op::RoundRect: g.drawRoundRect(in.read<fRoundRect>()); break;
+            case Op::Arc: {
+                auto rect = in.read<fRect>();
+                auto start = in.read<float>();
+                g.drawArc(rect, start, in.read<float>());
+                break;
+            }
+            case Op::Ellipse: g.drawEllipse(in.read<fEllipse>()); break;
+            case Op::Circle: g.drawCircle(in.read<fCircle>()); break;
+            case Op::Pie: {
+                auto rect = in.read<fRect>();
+                auto start = in.read<float>();
+                g.drawPie(rect, start, in.read<float>());
+                break;
+            }
+            case Op::Polygon: g.drawPolygon(polygons_[in.read<std::uint32_t>()]); break;
+            case Op::Bezier: g.drawBezier(beziers_[in.read<std::uint32_t>()]); break;
+            case Op::FitCurve: g.drawFitCurve(curves_[in.read<std::uint32_t>()]); break;
+            case Op::Path: {
+                auto path = in.read<const Path*>();
+                g.drawPath(*path, in.read<fPoint>());
+                break;
+            }
+            case Op::FillRect: g.drawFillRect(in.read<fRect>()); break;
+            case Op::FillRoundRect: g.drawFillRoundRect(in.read<fRoundRect>()); break;
+            case Op::FillPie: {
+                auto rect = in.read<fRect>();
+                auto start = in.read<float>();
+                g.drawFillPie(rect, start, in.read<float>());
+                break;
+            }
+            case Op::FillPolygon: g.drawFillPolygon(polygons_[in.read<std::uint32_t>()]); break;
+            case Op::FillEllipse: g.drawFillEllipse(in.read<fEllipse>()); break;
+            case Op::FillCircle: g.drawFillCircle(in.read<fCircle>()); break;
+            case Op::FillFitCurve: g.drawFillFitCurve(curves_[in.read<std::uint32_t>()]); break;
+            case Op::FillPath: {
+                auto path = in.read<const Path*>();
+                g.drawFillPath(*path, in.read<fPoint>());
+                break;
+            }
+            case Op::Image: {
+                auto pixelMap = in.read<const PixelMap*>();
+                g.drawImage(in.read<fPoint>(), *pixelMap);
+                break;
+            }
+            case Op::ImageRect: {
+                auto pixelMap = in.read<const PixelMap*>();
+                auto dest = in.read<fRect>();
+                g.drawImage(dest, in.read<fRect>(), *pixelMap);
+                break;
+            }
+            case Op::AlphaImage: {
+                auto pixelMap = in.read<const PixelMap*>();
+                auto dest = in.read<fPoint>();
+                g.drawAlphaImage(*pixelMap, dest, in.read<fRect>());
+                break;
+            }
+            case Op::AlphaImageRect: {
+                auto pixelMap = in.read<const PixelMap*>();
+                auto dest = in.read<fRect>();
+                auto src = in.read<fRect>();
+                g.drawAlphaImage(*pixelMap, dest, src, in.read<bool>());
+                break;
+            }
+            case Op::Text: {
+                auto& string = strings_[in.read<std::uint32_t>()];
+                auto& fonts = fontsAt(in.read<std::uint32_t>());
+                g.drawText(string, in.read<fPoint>(), fonts);
+                break;
+            }
+            case Op::TextRect: {
+                auto& string = strings_[in.read<std::uint32_t>()];
+                auto& fonts = fontsAt(in.read<std::uint32_t>());
+                auto rect = in.read<fRect>();
+                g.drawText(string, rect, in.read<int>(), fonts);
+                break;
+            }
+            }
+        }
+        // 末尾的状态命令仍需生效，使回放后绘图设备的状态与直接绘制时相同
+        applyState();
+        return stats;
+    }
+}
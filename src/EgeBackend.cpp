@@ -0,0 +1,196 @@
+#ifndef GFT_HEADLESS
+
+#include "GraceFt/Backend.h"
+#include <_private.inl>
+#include <ege.h>
+
+#include <GraceFt/Application.h>
+#include <GraceFt/Block.h>
+
+static inline auto _ = SetProcessDPIAware();
+
+namespace GFt {
+    using namespace ege;
+    namespace {
+        WNDPROC egeWndProc = nullptr;
+        /// @brief 替换窗口过程，在窗口收到输入或窗口状态改变的消息后唤醒主循环
+        /// @details 窗口过程运行在 EGE 的窗口线程上，消息先交给原窗口过程放入输入队列，
+        ///          因此主循环被唤醒时一定能读到该消息；窗口状态改变时重绘整个窗口
+        LRESULT CALLBACK wakeWndProc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam) {
+            auto result = CallWindowProc(egeWndProc, hwnd, msg, wparam, lparam);
+            if ((msg >= WM_MOUSEFIRST && msg <= WM_MOUSELAST) || (msg >= WM_KEYFIRST && msg <= WM_KEYLAST)
+                || msg == WM_MOUSELEAVE || msg == WM_CLOSE || msg == WM_DESTROY)
+                Application::requestFrame();
+            else if (msg == WM_SIZE || msg == WM_MOVE || msg == WM_ACTIVATE
+                || msg == WM_SETFOCUS || msg == WM_KILLFOCUS) {
+                if (msg == WM_SIZE || msg == WM_MOVE)
+                    Block::invalidateWindowOrigin();
+                Application::requestRender();
+            }
+            return result;
+        }
+        iRect fromRECT(const RECT& rect) {
+            return iRect(rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top);
+        }
+
+        /// @brief 基于 EGE 的窗口后端
+        class EgeBackend final : public Backend {
+        public:
+            bool createWindow(const iSize& size, int flags) override {
+                int initFlags = INIT_UNICODE | INIT_ANIMATION | INIT_NOFORCEEXIT | INIT_HIDE;
+                if (flags & NoBorder)
+                    initFlags |= INIT_NOBORDER;
+                if (flags & TopMost)
+                    initFlags |= INIT_TOPMOST;
+                initgraph(size.width(), size.height(), initFlags);
+                if (getHWnd() == (HWND)0)
+                    return false;
+                setcaption(L"GraceFt v2.0.0");
+                setbkcolor(WHITE);
+                setcolor(BLACK);
+                setfillcolor(EGERGBA(195, 198, 220, 230));
+                cleardevice();
+                return true;
+            }
+            void closeWindow() override { closegraph(); }
+            bool isRunning() override { return getHWnd() != (HWND)0 && is_run(); }
+            void beginLoop() override {
+                if (!egeWndProc)
+                    egeWndProc = reinterpret_cast<WNDPROC>(SetWindowLongPtr(
+                        getHWnd(), GWLP_WNDPROC, reinterpret_cast<LONG_PTR>(&wakeWndProc)));
+            }
+            void waitFrame(double fps) override { delay_fps(fps); }
+
+            void showWindow(bool show) override { show ? showwindow() : hidewindow(); }
+            void resizeWindow(const iSize& size) override { resizewindow(size.width(), size.height()); }
+            void moveWindow(const iPoint& pos) override { movewindow(pos.x(), pos.y()); }
+            void minimizeWindow() override { ::ShowWindow(getHWnd(), SW_MINIMIZE); }
+            void setWindowTitle(const std::wstring& title) override { setcaption(title.c_str()); }
+            void setWindowTopMost(bool topMost) override {
+                ::SetWindowPos(getHWnd(), topMost ? HWND_TOPMOST : HWND_NOTOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE);
+            }
+            void setWindowFrameless(bool frameless) override {
+                auto style = ::GetWindowLong(getHWnd(), GWL_STYLE);
+                frameless ? style &= ~WS_CAPTION : style |= WS_CAPTION;
+                ::SetWindowLong(getHWnd(), GWL_STYLE, style);
+            }
+            void setWindowAlpha(float alpha) override {
+                auto style = ::GetWindowLong(getHWnd(), GWL_EXSTYLE);
+                style |= WS_EX_LAYERED;
+                ::SetWindowLong(getHWnd(), GWL_EXSTYLE, style);
+                ::SetLayeredWindowAttributes(getHWnd(), 0, alpha * 255, LWA_ALPHA);
+            }
+            void setWindowColorKey(const std::optional<Color>& color) override {
+                auto style = ::GetWindowLong(getHWnd(), GWL_EXSTYLE);
+                color ? style |= WS_EX_LAYERED : style &= ~WS_EX_LAYERED;
+                ::SetWindowLong(getHWnd(), GWL_EXSTYLE, style);
+                if (!color) return;
+                ::SetLayeredWindowAttributes(getHWnd(),
+                    RGB(color->red(), color->green(), color->blue()), 0, LWA_COLORKEY);
+            }
+            iRect windowRect() override {
+                RECT rect;
+                ::GetWindowRect(getHWnd(), &rect);
+                return fromRECT(rect);
+            }
+            iRect clientRect() override {
+                RECT rect;
+                GetClientRect(getHWnd(), &rect);
+                POINT p = { rect.left, rect.top };
+                ClientToScreen(getHWnd(), &p);
+                return iRect(p.x, p.y, rect.right - rect.left, rect.bottom - rect.top);
+            }
+
+            iSize screenSize() override {
+                return iSize(GetSystemMetrics(SM_CXSCREEN), GetSystemMetrics(SM_CYSCREEN));
+            }
+            iRect workArea() override {
+                RECT rect;
+                SystemParametersInfoW(SPI_GETWORKAREA, 0, &rect, 0);
+                return fromRECT(rect);
+            }
+            int dpi() override { return GetDpiForSystem(); }
+            iPoint cursorPosition() override {
+                POINT pos;
+                GetCursorPos(&pos);
+                return iPoint(pos.x, pos.y);
+            }
+            bool showCursor(bool show) override { return showmouse(show); }
+
+            bool pollMouse(MouseMessage& msg) override {
+                if (!mousemsg())
+                    return false;
+                auto m = getmouse();
+                msg.position = iPoint{ m.x, m.y };
+                if (m.is_left())
+                    msg.button = MouseButton::Left;
+                else if (m.is_right())
+                    msg.button = MouseButton::Right;
+                else if (m.is_mid())
+                    msg.button = MouseButton::Middle;
+                else
+                    msg.button = MouseButton::Unknown;
+                msg.wheel = MouseWheel::None;
+                if (m.is_move())
+                    msg.type = MouseMessage::Type::Move;
+                else if (m.is_down())
+                    msg.type = MouseMessage::Type::Press;
+                else if (m.is_up())
+                    msg.type = MouseMessage::Type::Release;
+                else {
+                    msg.type = MouseMessage::Type::Wheel;
+                    if (m.wheel > 0)
+                        msg.wheel = MouseWheel::Up;
+                    else if (m.wheel < 0)
+                        msg.wheel = MouseWheel::Down;
+                }
+                return true;
+            }
+            /// @details 先取出按键消息，再取出 kbhit() 缓冲中的字符
+            bool pollKey(KeyMessage& msg) override {
+                if (kbmsg()) {
+                    auto k = getkey();
+                    msg.key = k.key;
+                    msg.shift = k.flags & key_flag_shift;
+                    msg.ctrl = k.flags & key_flag_ctrl;
+                    switch (k.msg) {
+                    case key_msg_down: msg.type = KeyMessage::Type::Press; return true;
+                    case key_msg_up: msg.type = KeyMessage::Type::Release; return true;
+                    case key_msg_char: msg.type = KeyMessage::Type::Char; return true;
+                    default: return pollKey(msg);
+                    }
+                }
+                if (kbhit()) {
+                    msg = KeyMessage{ KeyMessage::Type::Char, getch() };
+                    return true;
+                }
+                return false;
+            }
+            bool hasMouse() override { return mousemsg(); }
+            bool hasKey() override { return kbmsg() || kbhit(); }
+
+            PixelMap* screen() override { return nullptr; }
+            void clear() override { cleardevice(); }
+            void clear(const iRect& rect) override {
+                setviewport(rect.left(), rect.top(), rect.right(), rect.bottom(), 1);
+                clearviewport();
+            }
+            void clipToDamage(const DamageRegion& damage) override {
+                HRGN region = CreateRectRgn(0, 0, 0, 0);
+                for (auto& rect : damage.rects()) {
+                    HRGN part = CreateRectRgn(rect.left(), rect.top(), rect.right(), rect.bottom());
+                    CombineRgn(region, region, part, RGN_OR);
+                    DeleteObject(part);
+                }
+                ExtSelectClipRgn(getHDC(), region, RGN_AND);
+                DeleteObject(region);
+            }
+            void present(const DamageRegion*) override { flushwindow(); }
+        };
+    }
+}
+namespace _GFt_private_ {
+    std::unique_ptr<GFt::Backend> _make_default_backend() { return std::make_unique<GFt::EgeBackend>(); }
+}
+
+#endif
@@ -1,33 +1,47 @@
 #include "GraceFt/Event.h"
 
-#include <ege.h>
+#include <GraceFt/Backend.h>
+#include <utility>
 namespace GFt {
     bool Event::isPropagationStopped() const { return stopPropagation_; }
     void Event::stopPropagation() { stopPropagation_ = true; }
     void Event::accept() { return stopPropagation(); }
     bool Event::isAccepted() const { return isPropagationStopped(); }
-    MouseEvent::MouseEvent(const iPoint& position) : position_(position) {
-        POINT pos;
-        GetCursorPos(&pos);
-        absolutePosition_ = iPoint(pos.x, pos.y);
-    }
+    MouseEvent::MouseEvent(const iPoint& position)
+        : position_(position), absolutePosition_(Backend::instance().cursorPosition()) {}
+    MouseEvent::MouseEvent(const iPoint& position, const iPoint& absolutePosition)
+        : position_(position), absolutePosition_(absolutePosition) {}
     const iPoint& MouseEvent::position() const { return position_; }
     const iPoint& MouseEvent::absolutePosition() const { return absolutePosition_; }
     KeyboardEvent::KeyboardEvent(Key key, bool shift, bool ctrl) : key_(key), shift_(shift), ctrl_(ctrl) {}
     Key KeyboardEvent::key() const { return key_; }
     MouseButtonEvent::MouseButtonEvent(const iPoint& position, MouseButton button)
         : MouseEvent(position), button_(button) {}
+    MouseButtonEvent::MouseButtonEvent(const iPoint& position, MouseButton button, const iPoint& absolutePosition)
+        : MouseEvent(position, absolutePosition), button_(button) {}
     MouseButton MouseButtonEvent::button() const { return button_; }
     MouseWheelEvent::MouseWheelEvent(const iPoint& position, MouseWheel wheel)
         : MouseEvent(position), wheel_(wheel) {}
+    MouseWheelEvent::MouseWheelEvent(const iPoint& position, MouseWheel wheel, const iPoint& absolutePosition)
+        : MouseEvent(position, absolutePosition), wheel_(wheel) {}
     MouseWheel MouseWheelEvent::wheel() const { return wheel_; }
-    MouseMoveEvent::MouseMoveEvent(const iPoint& position) : MouseEvent(position) {}
+    MouseMoveEvent::MouseMoveEvent(const iPoint& position) : MouseEvent(position), history_{ position } {}
+    MouseMoveEvent::MouseMoveEvent(const iPoint& position, const iPoint& absolutePosition, std::vector<iPoint> history)
+        : MouseEvent(position, absolutePosition), history_(std::move(history)) {
+        if (history_.empty())
+            history_.push_back(position);
+    }
+    const std::vector<iPoint>& MouseMoveEvent::history() const { return history_; }
     KeyPressEvent::KeyPressEvent(Key key, bool shift, bool ctrl) : KeyboardEvent(key, shift, ctrl) {}
     KeyReleaseEvent::KeyReleaseEvent(Key key, bool shift, bool ctrl) : KeyboardEvent(key, shift, ctrl) {}
     MouseButtonPressEvent::MouseButtonPressEvent(const iPoint& position, MouseButton button)
         : MouseButtonEvent(position, button) {}
+    MouseButtonPressEvent::MouseButtonPressEvent(const iPoint& position, MouseButton button, const iPoint& absolutePosition)
+        : MouseButtonEvent(position, button, absolutePosition) {}
     MouseButtonReleaseEvent::MouseButtonReleaseEvent(const iPoint& position, MouseButton button)
         : MouseButtonEvent(position, button) {}
+    MouseButtonReleaseEvent::MouseButtonReleaseEvent(const iPoint& position, MouseButton button, const iPoint& absolutePosition)
+        : MouseButtonEvent(position, button, absolutePosition) {}
     TextInputEvent::TextInputEvent(int character) : character_(character) {}
     int TextInputEvent::character() const { return character_; }
 }
\ No newline at end of file
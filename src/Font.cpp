@@ -1,10 +1,63 @@
 #include "GraceFt/Font.h"
 
+#ifdef GFT_HEADLESS
+#include <utility>
+#else
 #include <ege.h>
+#endif
 
+#ifndef GFT_HEADLESS
 #define FONT(x) (static_cast<LOGFONTW*>(x))
+#endif
 
 namespace GFt {
+#ifdef GFT_HEADLESS
+    namespace {
+        /// @brief 无窗口构建中的字体属性，字段与 LOGFONTW 中对应的字段含义相同
+        struct FontPrivate {
+            long height;
+            long weight = static_cast<long>(FontWeight::Default);
+            bool italic = false;
+            bool underline = false;
+            bool strikeOut = false;
+            std::wstring family;
+        };
+        FontPrivate* data(void* font) { return static_cast<FontPrivate*>(font); }
+    }
+    Font::Font(const std::wstring& fontFamily, long size) {
+        font_ = new FontPrivate{ -size, static_cast<long>(FontWeight::Default), false, false, false, fontFamily };
+    }
+    Font::Font(const Font& other) { font_ = new FontPrivate(*data(other.font_)); }
+    Font::Font(Font&& other) { font_ = std::exchange(other.font_, nullptr); }
+    Font& Font::operator=(const Font& other) {
+        if (this != &other)
+            *data(font_) = *data(other.font_);
+        return *this;
+    }
+    Font& Font::operator=(Font&& other) {
+        if (this == &other)
+            return *this;
+        delete data(font_);
+        font_ = std::exchange(other.font_, nullptr);
+        return *this;
+    }
+    Font::~Font() {
+        delete data(font_);
+        font_ = nullptr;
+    }
+    void Font::setSize(long size) { data(font_)->height = size; }
+    long Font::size() const { return -data(font_)->height; }
+    void Font::setWeight(FontWeight weight) { data(font_)->weight = static_cast<long>(weight); }
+    FontWeight Font::weight() const { return static_cast<FontWeight>(data(font_)->weight); }
+    void Font::setItalic(bool italic) { data(font_)->italic = italic; }
+    bool Font::italic() const { return data(font_)->italic; }
+    void Font::setUnderline(bool underline) { data(font_)->underline = underline; }
+    bool Font::underline() const { return data(font_)->underline; }
+    void Font::setStrikeOut(bool strikeOut) { data(font_)->strikeOut = strikeOut; }
+    bool Font::strikeOut() const { return data(font_)->strikeOut; }
+    void Font::setFontFamily(const std::wstring& fontFamily) { data(font_)->family = fontFamily; }
+    std::wstring Font::fontFamily() const { return data(font_)->family; }
+#else
     Font::Font(const std::wstring& fontFamily, long size) {
         auto* font = new LOGFONTW();
         FONT(font)->lfHeight = -size;
@@ -67,6 +120,7 @@ namespace GFt {
     bool Font::strikeOut() const { return FONT(font_)->lfStrikeOut; }
     void Font::setFontFamily(const std::wstring& fontFamily) { wcscpy_s(FONT(font_)->lfFaceName, fontFamily.c_str()); }
     std::wstring Font::fontFamily() const { return FONT(font_)->lfFaceName; }
+#endif
     std::ostream& operator<<(std::ostream& os, const Font& font) {
         os << "Font{ " << &font << ": " << font.font_ << " }";
         return os;
@@ -6,31 +6,37 @@ namespace GFt {
     void GraphInterface::setX(int x) {
         if (x == rect_.x()) return;
         rect_.x() = x;
+        rectChanged();
         onPositionChanged(rect_.position());
     }
     void GraphInterface::setY(int y) {
         if (y == rect_.y()) return;
         rect_.y() = y;
+        rectChanged();
         onPositionChanged(rect_.position());
     }
     void GraphInterface::setWidth(int width) {
         if (width == rect_.width()) return;
         rect_.width() = width;
+        rectChanged();
         onSizeChanged(rect_.size());
     }
     void GraphInterface::setHeight(int height) {
         if (height == rect_.height()) return;
         rect_.height() = height;
+        rectChanged();
         onSizeChanged(rect_.size());
     }
     void GraphInterface::setPosition(const iPoint& pos) {
         if (pos == rect_.position()) return;
         rect_.position() = pos;
+        rectChanged();
         onPositionChanged(pos);
     }
     void GraphInterface::setSize(const iSize& size) {
         if (size == rect_.size()) return;
         rect_.size() = size;
+        rectChanged();
         onSizeChanged(size);
     }
     void GraphInterface::setRect(const iRect& rect) {
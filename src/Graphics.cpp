@@ -1,10 +1,27 @@
 #include "GraceFt/Graphics.h"
-#include <_private.inl>
+#include <_private_draw.inl>
+#ifndef GFT_HEADLESS
 #include <ege.h>
+#endif
 
+#include <GraceFt/Backend.h>
+#include <GraceFt/DamageRegion.h>
+#include <GraceFt/DisplayList.h>
+#include <GraceFt/Rasterizer.h>
+#include <GraceFt/TileRenderer.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+
+#ifdef GFT_HEADLESS
+#define IMG(x) (static_cast<_Image*>(x))
+#define PATH(x) (static_cast<_PathData*>(x))
+#else
 #define FONT(x) (static_cast<LOGFONTW*>(x))
 #define IMG(x) (static_cast<PIMAGE>(x))
 #define PATH(x) (static_cast<ege_path*>(x))
+#endif
 #define INIT_GRAPH                  \
         this->bindBrushSet(nullptr);\
         this->bindPenSet(nullptr);  \
@@ -13,51 +30,302 @@
         this->setAntiAliasing(false)
 
 namespace GFt {
+#ifndef GFT_HEADLESS
     using namespace ege;
+#endif
     using namespace _GFt_private_;
     using namespace literals;
 
+    namespace {
+        /// @brief 绘图目标的像素与视口
+        struct Surface {
+            std::uint32_t* pixels = nullptr;
+            int width = 0;
+            int height = 0;
+            iRect viewport;
+            bool clip = false;
+            /// @brief 绘制被限制在的区域：启用裁剪时为视口，否则为整个目标
+            iRect bounds() const { return clip ? viewport : iRect(0, 0, width, height); }
+        };
+        Surface surfaceOf(void* image) {
+            Surface surface;
+#ifdef GFT_HEADLESS
+            if (!image)
+                return surface;
+            surface.pixels = IMG(image)->pixels.data();
+            surface.width = IMG(image)->width;
+            surface.height = IMG(image)->height;
+            surface.viewport = IMG(image)->viewport;
+            surface.clip = IMG(image)->clip;
+#else
+            surface.pixels = reinterpret_cast<std::uint32_t*>(getbuffer(IMG(image)));
+            surface.width = getwidth(IMG(image));
+            surface.height = getheight(IMG(image));
+            int left, top, right, bottom, clip;
+            getviewport(&left, &top, &right, &bottom, &clip, IMG(image));
+            surface.viewport = iRect(left, top, right - left, bottom - top);
+            surface.clip = clip;
+#endif
+            return surface;
+        }
+        /// @brief 两个矩形的交集，不相交时宽高不大于 0
+        iRect intersection(const iRect& a, const iRect& b) {
+            auto left = std::max(a.left(), b.left()), top = std::max(a.top(), b.top());
+            return iRect(left, top, std::min(a.right(), b.right()) - left, std::min(a.bottom(), b.bottom()) - top);
+        }
+#ifdef GFT_HEADLESS
+        /// @brief 估算文字的宽度：ASCII 字符为字号的一半，其余字符与字号相同
+        int estimateWidth(wchar_t c, long size) { return c < 0x80 ? static_cast<int>((size + 1) / 2) : static_cast<int>(size); }
+        int estimateWidth(const std::wstring& text, long size) {
+            int width = 0;
+            for (auto c : text)
+                width += estimateWidth(c, size);
+            return width;
+        }
+        /// @brief 将位图的 src 区域绘制到目标的 dest 区域，只写入 clip 以内的像素
+        /// @details 尺寸不同时按最近邻采样缩放；blend 为 true 时按与 Rasterizer 相同的方式混合，否则直接复制
+        void blitImage(const Surface& target, const iRect& clip, const _Image& image,
+            const fRect& dest, const fRect& src, bool blend) {
+            if (dest.width() <= 0 || dest.height() <= 0)
+                return;
+            auto area = intersection(clip, iRect(static_cast<int>(std::floor(dest.left())), static_cast<int>(std::floor(dest.top())),
+                static_cast<int>(std::ceil(dest.width())), static_cast<int>(std::ceil(dest.height()))));
+            float sx = src.width() / dest.width(), sy = src.height() / dest.height();
+            for (int y = area.top(); y < area.bottom(); y++) {
+                auto v = static_cast<int>(std::floor(src.top() + (y + 0.5f - dest.top()) * sy));
+                if (v < 0 || v >= image.height)
+                    continue;
+                auto row = target.pixels + static_cast<std::ptrdiff_t>(y) * target.width;
+                for (int x = area.left(); x < area.right(); x++) {
+                    auto u = static_cast<int>(std::floor(src.left() + (x + 0.5f - dest.left()) * sx));
+                    if (u < 0 || u >= image.width)
+                        continue;
+                    auto color = image.pixels[static_cast<std::size_t>(v) * image.width + u];
+                    if (!blend) {
+                        row[x] = color;
+                        continue;
+                    }
+                    // 透明度映射到 0~256，源像素的透明度通道视为 255
+                    std::uint32_t a = (color >> 24) + (color >> 31), src = color | 0xff000000u, dst = row[x], result = 0;
+                    for (int shift = 0; shift < 32; shift += 8)
+                        result |= ((((dst >> shift) & 0xff) * (256 - a) + ((src >> shift) & 0xff) * a) >> 8) << shift;
+                    row[x] = result;
+                }
+            }
+        }
+#endif
+    }
+
     PenSet Graphics::defaultPenSet_{ 0x0_rgb };
     BrushSet Graphics::defaultBrushSet_{ 0xCFD1EFEC_rgba };
     TextSet Graphics::defaultTextSet_{ 0x0_rgb };
 
     Graphics::Graphics() {
-        target_ = nullptr;
         targetPixelMap_ = nullptr;
 
         INIT_GRAPH;
     }
     Graphics::Graphics(Graphics&& other) {
-        target_ = other.target_;
         targetPixelMap_ = other.targetPixelMap_;
-        other.target_ = nullptr;
         other.targetPixelMap_ = nullptr;
+        rasterMode_ = other.rasterMode_;
+        antiAliasing_ = other.antiAliasing_;
+        transform_ = other.transform_;
+        fillColor_ = other.fillColor_;
+        solidFill_ = other.solidFill_;
+        clipRegion_ = other.clipRegion_;
+        rasterizer_ = std::move(other.rasterizer_);
+        tiles_ = std::move(other.tiles_);
+        recorder_ = std::exchange(other.recorder_, nullptr);
+        bindStatistics_ = other.bindStatistics_;
     }
     Graphics& Graphics::operator=(Graphics&& other) {
         if (this == &other)
             return *this;
-            target_ = other.target_;
+            if (targetPixelMap_)
+                targetPixelMap_->painters_--;
             targetPixelMap_ = other.targetPixelMap_;
-            other.target_ = nullptr;
             other.targetPixelMap_ = nullptr;
+            rasterMode_ = other.rasterMode_;
+            antiAliasing_ = other.antiAliasing_;
+            transform_ = other.transform_;
+            fillColor_ = other.fillColor_;
+            solidFill_ = other.solidFill_;
+            clipRegion_ = other.clipRegion_;
+            rasterizer_ = std::move(other.rasterizer_);
+            flush();
+            tiles_ = std::move(other.tiles_);
+            recorder_ = std::exchange(other.recorder_, nullptr);
+            bindStatistics_ = other.bindStatistics_;
         return *this;
     }
     Graphics::~Graphics() {
+        flush();
         INIT_GRAPH;
+        if (targetPixelMap_)
+            targetPixelMap_->painters_--;
     }
     void Graphics::reset() {
         INIT_GRAPH;
     }
     /// @note 若设置目标不为 nullptr, 则应保证后续调用此类的其它成员函数时, 目标对象未被析构
     /// @note 否则会引发段错误(指针越界访问)
+    /// @note 目标的像素与其它位图共享时会先复制一份，之后目标的副本总是立即复制像素
     void Graphics::setTarget(PixelMap* target) {
+        flush();
+        if (targetPixelMap_)
+            targetPixelMap_->painters_--;
         targetPixelMap_ = target;
-        target_ = target->pixmap_;
+        if (target) {
+            target->detach();
+            target->painters_++;
+        }
         INIT_GRAPH;
     }
+    /// @details 未设置目标时使用后端提供的屏幕，后端的屏幕可能随窗口大小改变而重建，因此每次使用时获取；
+    ///          屏幕总会被继续绘制，第一次使用时即标记为绘图目标，不再与副本共享像素
+    void* Graphics::resolveTarget() const {
+        if (targetPixelMap_)
+            return targetPixelMap_->pixmap_;
+        auto screen = Backend::instance().screen();
+        if (!screen)
+            return nullptr;
+        if (screen->painters_ == 0) {
+            screen->detach();
+            screen->painters_ = 1;
+        }
+        return screen->pixmap_;
+    }
+    /// @details 绘制前先绘制已记录的填充，以保持与 EGE 绘制的图形之间的先后顺序；
+    ///          只改变绘图状态的函数使用 resolveTarget()，不会打断记录
+    void* Graphics::target() const {
+        if (tiles_ && !tiles_->empty())
+            tiles_->flush();
+        return resolveTarget();
+    }
     void Graphics::setAntiAliasing(bool enable) {
-        ege_enable_aa(enable, IMG(target_));
+        if (recorder_)
+            return recorder_->setAntiAliasing(enable);
+        antiAliasing_ = enable;
+#ifndef GFT_HEADLESS
+        ege_enable_aa(enable, IMG(resolveTarget()));
+#endif
+    }
+    void Graphics::setRasterMode(RasterMode mode) {
+        if (mode != RasterMode::Tiled)
+            flush();
+        rasterMode_ = mode;
+    }
+    Graphics::RasterMode Graphics::getRasterMode() const { return rasterMode_; }
+    void Graphics::setClipRegion(const DamageRegion* region) { clipRegion_ = region; }
+    void Graphics::beginRecording(DisplayList* list) { recorder_ = list; }
+    void Graphics::endRecording() { recorder_ = nullptr; }
+    DisplayList* Graphics::recorder() const { return recorder_; }
+    void Graphics::flush() {
+        if (tiles_)
+            tiles_->flush();
     }
+    /// @details 软件光栅化时当前画刷为纯色画刷才会返回 true，此时 points_ 已被清空，
+    ///          由调用者将图形按逻辑坐标展开为多边形顶点写入 points_ 后调用 endSoftwareFill()
+    /// @details 无窗口构建中没有 EGE 可用，原生模式同样由软件光栅化器绘制
+    bool Graphics::beginSoftwareFill() {
+#ifdef GFT_HEADLESS
+        if (!solidFill_)
+            return false;
+#else
+        if (rasterMode_ == RasterMode::Native || !solidFill_)
+            return false;
+#endif
+        if (rasterMode_ != RasterMode::Tiled && !rasterizer_)
+            rasterizer_ = std::make_unique<Rasterizer>();
+        if (rasterMode_ == RasterMode::Tiled && !tiles_)
+            tiles_ = std::make_unique<TileRenderer>();
+        points_.clear();
+        return true;
+    }
+    /// @details 依次应用变换矩阵与视口偏移得到目标上的坐标，
+    ///          再在视口(若其启用了裁剪)与裁剪区域的每个矩形内分别填充；
+    ///          分块模式下只记录填充，视口与裁剪区域在记录时确定
+    void Graphics::endSoftwareFill() {
+        auto surface = surfaceOf(resolveTarget());
+        auto pixels = surface.pixels;
+        if (!pixels || points_.size() < 3)
+            return;
+        int width = surface.width, height = surface.height;
+        int left = surface.viewport.left(), top = surface.viewport.top();
+        auto& m = transform_;
+        for (auto& p : points_)
+            p = fPoint(p.x() * m[0][0] + p.y() * m[1][0] + m[2][0] + left,
+                p.x() * m[0][1] + p.y() * m[1][1] + m[2][1] + top);
+        Color color((fillColor_ >> 16) & 0xff, (fillColor_ >> 8) & 0xff, fillColor_ & 0xff, fillColor_ >> 24);
+        std::function<void(const iRect&)> fill;
+        if (rasterMode_ == RasterMode::Tiled) {
+            tiles_->setTarget(pixels, width, height, width);
+            fill = [&](const iRect& area) {
+                tiles_->addFill(points_.data(), points_.size(), area, color, Rasterizer::FillRule::NonZero, antiAliasing_);
+            };
+        }
+        else {
+            auto& r = *rasterizer_;
+            r.setTarget(pixels, width, height, width);
+            r.setAntiAliasing(antiAliasing_);
+            r.reset();
+            r.addPolygon(points_.data(), points_.size());
+            fill = [&](const iRect& area) {
+                r.setClip(area);
+                r.fill(color);
+            };
+        }
+        auto view = surface.bounds();
+        if (!clipRegion_)
+            return fill(view);
+        for (auto& rect : clipRegion_->rects()) {
+            auto l = std::max(rect.left(), view.left()), t = std::max(rect.top(), view.top());
+            auto w = std::min(rect.right(), view.right()) - l, h = std::min(rect.bottom(), view.bottom()) - t;
+            if (w > 0 && h > 0)
+                fill(iRect(l, t, w, h));
+        }
+    }
+#ifdef GFT_HEADLESS
+    /// @details 无窗口构建中线条由软件光栅化器逐段填充为宽为画笔宽度的矩形，线段之间不做连接处理；
+    ///          调用前 points_ 中为按逻辑坐标排列的折线顶点
+    void Graphics::strokeSoftware(bool closed) {
+        auto img = IMG(target());
+        std::vector<fPoint> line;
+        line.swap(points_);
+        if (!img || img->lineWidth <= 0 || line.size() < 2)
+            return;
+        if (closed)
+            line.push_back(line.front());
+        auto solid = std::exchange(solidFill_, true);
+        auto fill = std::exchange(fillColor_, img->lineColor);
+        float half = img->lineWidth / 2;
+        for (std::size_t i = 0; i + 1 < line.size(); i++) {
+            auto d = line[i + 1] - line[i];
+            float length = std::hypot(d.x(), d.y());
+            if (length <= 0 || !beginSoftwareFill())
+                continue;
+            auto n = fPoint(-d.y(), d.x()) * (half / length);
+            points_.assign({ line[i] + n, line[i + 1] + n, line[i + 1] - n, line[i] - n });
+            endSoftwareFill();
+        }
+        solidFill_ = solid;
+        fillColor_ = fill;
+    }
+    /// @details 无窗口构建中位置与大小按变换矩阵的缩放与平移部分变换，混合时绘制到视口中
+    void Graphics::drawPixels(const PixelMap& pixelMap, fRect dest, const fRect& src, bool blend) {
+        auto surface = surfaceOf(target());
+        auto image = IMG(pixelMap.pixmap_);
+        if (!surface.pixels || !image)
+            return;
+        dest = fRect(dest.x() + surface.viewport.left(), dest.y() + surface.viewport.top(), dest.width(), dest.height());
+        auto bounds = intersection(surface.bounds(), iRect(0, 0, surface.width, surface.height));
+        if (!clipRegion_)
+            return blitImage(surface, bounds, *image, dest, src, blend);
+        for (auto& rect : clipRegion_->rects())
+            blitImage(surface, intersection(bounds, rect), *image, dest, src, blend);
+    }
+#endif
     /// @details 对于传入的矩阵, 默认其已经过齐次变换, 即矩阵的最后一列为 (0, 0, 1)
     /// @code
     /// // 例如：将当前坐标系绕点 (100, 100) 逆时针旋转 45 度
@@ -69,6 +337,10 @@ namespace GFt {
     ///     scale(makeVec2(200, 200), makeVec2(2, 2));
     /// @endcode
     void Graphics::setTransform(const fMat3x3& matrix) {
+        if (recorder_)
+            return recorder_->setTransform(matrix);
+        transform_ = matrix;
+#ifndef GFT_HEADLESS
         ege_transform_matrix mat;
         mat.m11 = matrix[0][0];
         mat.m12 = matrix[0][1];
@@ -76,17 +348,26 @@ namespace GFt {
         mat.m22 = matrix[1][1];
         mat.m31 = matrix[2][0];
         mat.m32 = matrix[2][1];
-        ege_set_transform(&mat, IMG(target_));
+        ege_set_transform(&mat, IMG(resolveTarget()));
+#endif
     }
     void Graphics::resetTransform() {
-        ege_transform_reset(IMG(target_));
+        if (recorder_)
+            return recorder_->resetTransform();
+        transform_ = fMat3x3::I();
+#ifndef GFT_HEADLESS
+        ege_transform_reset(IMG(resolveTarget()));
+#endif
     }
     PixelMap* Graphics::getTarget() const {
         return targetPixelMap_;
     }
     fMat3x3 Graphics::getTransform() const {
+#ifdef GFT_HEADLESS
+        return transform_;
+#else
         ege_transform_matrix mat;
-        ege_get_transform(&mat, IMG(target_));
+        ege_get_transform(&mat, IMG(resolveTarget()));
         fMat3x3 result = fMat3x3::I();
         result[0][0] = mat.m11;
         result[0][1] = mat.m12;
@@ -95,176 +376,356 @@ namespace GFt {
         result[2][0] = mat.m31;
         result[2][1] = mat.m32;
         return result;
+#endif
     }
     void Graphics::clear() {
-        clearviewport(IMG(target_));
+        if (recorder_)
+            return recorder_->clear();
+#ifdef GFT_HEADLESS
+        auto surface = surfaceOf(target());
+        auto area = intersection(surface.viewport, iRect(0, 0, surface.width, surface.height));
+        for (int y = area.top(); y < area.bottom(); y++)
+            std::fill_n(surface.pixels + static_cast<std::ptrdiff_t>(y) * surface.width + area.left(),
+                area.width(), IMG(resolveTarget())->background);
+#else
+        clearviewport(IMG(target()));
+#endif
     }
 
-    int Graphics::textWidth(wchar_t c, const std::vector<std::wstring>& fonts) {
+    /// @details 无窗口构建中不加载字体，文字的宽高按字号估算：ASCII 字符宽为字号的一半，其余字符宽为字号，
+    ///          高为字号；回滚字体集合被忽略
+    int Graphics::textWidth(wchar_t c, [[maybe_unused]] const std::vector<std::wstring>& fonts) {
+#ifdef GFT_HEADLESS
+        auto img = IMG(resolveTarget());
+        return img ? estimateWidth(c, img->fontSize) : 0;
+#else
         if (fonts.empty())
-            return ege::textwidth(c, IMG(target_));
+            return ege::textwidth(c, IMG(resolveTarget()));
         LOGFONTW font_buf, font_env;
         int ret = 0;
-        getfont(&font_env, IMG(target_));
-        getfont(&font_buf, IMG(target_));
+        getfont(&font_env, IMG(resolveTarget()));
+        getfont(&font_buf, IMG(resolveTarget()));
         for (auto& font : fonts) {
             wcscpy_s(font_buf.lfFaceName, LF_FACESIZE, font.c_str());
-            setfont(&font_buf, IMG(target_));
+            setfont(&font_buf, IMG(resolveTarget()));
             WORD index = 0;
             GetGlyphIndicesW(
-                getHDC(IMG(target_)), &c, 1,
+                getHDC(IMG(resolveTarget())), &c, 1,
                 &index, GGI_MARK_NONEXISTING_GLYPHS);
             if (index != 0xFFFF) {
-                ret = ege::textwidth(c, IMG(target_));
+                ret = ege::textwidth(c, IMG(resolveTarget()));
                 break;
             }
         }
-        setfont(&font_env, IMG(target_));
+        setfont(&font_env, IMG(resolveTarget()));
         return ret;
+#endif
     }
-    int Graphics::textHeight(wchar_t c, const std::vector<std::wstring>& fonts) {
+    int Graphics::textHeight([[maybe_unused]] wchar_t c, [[maybe_unused]] const std::vector<std::wstring>& fonts) {
+#ifdef GFT_HEADLESS
+        auto img = IMG(resolveTarget());
+        return img ? static_cast<int>(img->fontSize) : 0;
+#else
         if (fonts.empty())
-            return ege::textheight(c, IMG(target_));
+            return ege::textheight(c, IMG(resolveTarget()));
         LOGFONTW font_buf, font_env;
         int ret = 0;
-        getfont(&font_env, IMG(target_));
-        getfont(&font_buf, IMG(target_));
+        getfont(&font_env, IMG(resolveTarget()));
+        getfont(&font_buf, IMG(resolveTarget()));
         for (auto& font : fonts) {
             wcscpy_s(font_buf.lfFaceName, LF_FACESIZE, font.c_str());
-            setfont(&font_buf, IMG(target_));
+            setfont(&font_buf, IMG(resolveTarget()));
             WORD index = 0;
             GetGlyphIndicesW(
-                getHDC(IMG(target_)), &c, 1,
+                getHDC(IMG(resolveTarget())), &c, 1,
                 &index, GGI_MARK_NONEXISTING_GLYPHS);
             if (index != 0xFFFF) {
-                ret = ege::textheight(c, IMG(target_));
+                ret = ege::textheight(c, IMG(resolveTarget()));
                 break;
             }
         }
-        setfont(&font_env, IMG(target_));
+        setfont(&font_env, IMG(resolveTarget()));
         return ret;
+#endif
     }
 
-    int Graphics::textWidth(const std::wstring& text, const std::vector<std::wstring>& fonts) {
+    int Graphics::textWidth(const std::wstring& text, [[maybe_unused]] const std::vector<std::wstring>& fonts) {
+#ifdef GFT_HEADLESS
+        auto img = IMG(resolveTarget());
+        return img ? estimateWidth(text, img->fontSize) : 0;
+#else
         if (fonts.empty())
-            return ege::textwidth(text.c_str(), IMG(target_));
+            return ege::textwidth(text.c_str(), IMG(resolveTarget()));
         int ret = 0;
         for (auto& c : text)
             ret += textWidth(c, fonts);
         return ret;
+#endif
     }
-    int Graphics::textHeight(const std::wstring& text, const std::vector<std::wstring>& fonts) {
+    int Graphics::textHeight(const std::wstring& text, [[maybe_unused]] const std::vector<std::wstring>& fonts) {
+#ifdef GFT_HEADLESS
+        auto img = IMG(resolveTarget());
+        return img ? text.empty() ? 0 : static_cast<int>(img->fontSize) : 0;
+#else
         if (fonts.empty())
-            return ege::textheight(text.c_str(), IMG(target_));
+            return ege::textheight(text.c_str(), IMG(resolveTarget()));
         int ret = 0;
         using namespace std;
         for (auto& c : text)
             ret = max(ret, textHeight(c, fonts));
         return ret;
+#endif
     }
 
     void Graphics::setBackgroundColor(const Color& color) {
-        setbkcolor(EGERGBA(color.red(), color.green(), color.blue(), color.alpha()), IMG(target_));
+        if (recorder_)
+            return recorder_->setBackgroundColor(color);
+#ifdef GFT_HEADLESS
+        if (auto img = IMG(resolveTarget()))
+            img->background = _pack_color(color);
+#else
+        setbkcolor(_pack_color(color), IMG(resolveTarget()));
+#endif
     }
+    /// @details EGE 窗口没有对应的位图对象，其状态记录在静态变量中
+    bool Graphics::shouldBind(int slot, std::uint64_t version) {
+        static std::uint64_t window[3] = {};
+        auto pixelMap = targetPixelMap_ ? targetPixelMap_ : Backend::instance().screen();
+        auto& bound = (pixelMap ? pixelMap->bound_ : window)[slot];
+        if (bound == version)
+            return false;
+        bound = version;
+        return true;
+    }
+    const Graphics::BindStatistics& Graphics::getBindStatistics() const { return bindStatistics_; }
+    void Graphics::resetBindStatistics() { bindStatistics_ = BindStatistics(); }
     void Graphics::bindPenSet(PenSet* penSet) {
+        if (recorder_)
+            return recorder_->bindPenSet(penSet);
         if (penSet == nullptr) {
             bindPenSet(&defaultPenSet_);
             return;
         }
+        if (!shouldBind(0, penSet->version_)) {
+            bindStatistics_.penElided++;
+            return;
+        }
+        bindStatistics_.penBinds++;
         PenSetPrivate* pPS = static_cast<PenSetPrivate*>(penSet->pen_);
-        setlinecolor(pPS->color, IMG(target_));
-        setlinestyle(pPS->line_type, pPS->userdef, pPS->width, IMG(target_));
-        setlinecap((line_cap_type)pPS->startcap_type, (line_cap_type)pPS->endcap_type, IMG(target_));
-        setlinejoin((line_join_type)pPS->join_type, pPS->miterlimit, IMG(target_));
+#ifdef GFT_HEADLESS
+        if (auto img = IMG(resolveTarget())) {
+            img->lineColor = pPS->color;
+            img->lineWidth = pPS->line_type == NULL_PEN ? 0.f : static_cast<float>(pPS->width);
+        }
+#else
+        setlinecolor(pPS->color, IMG(resolveTarget()));
+        setlinestyle(pPS->line_type, pPS->userdef, pPS->width, IMG(resolveTarget()));
+        setlinecap((line_cap_type)pPS->startcap_type, (line_cap_type)pPS->endcap_type, IMG(resolveTarget()));
+        setlinejoin((line_join_type)pPS->join_type, pPS->miterlimit, IMG(resolveTarget()));
+#endif
     }
     void Graphics::bindBrushSet(BrushSet* brushSet) {
+        if (recorder_)
+            return recorder_->bindBrushSet(brushSet);
         if (brushSet == nullptr) {
             bindBrushSet(&defaultBrushSet_);
             return;
         }
         BrushSetPrivate* pBS = static_cast<BrushSetPrivate*>(brushSet->brush_);
+#ifdef GFT_HEADLESS
+        // 无窗口构建中渐变画刷以起始颜色纯色填充，图案与纹理不被绘制
+        switch (static_cast<BrushStyle>(pBS->mode)) {
+        case BrushStyle::Default: fillColor_ = pBS->def.color; break;
+        case BrushStyle::LinearGradient: fillColor_ = pBS->linear.color1; break;
+        case BrushStyle::RadialGradient: fillColor_ = pBS->radial.ccolor; break;
+        case BrushStyle::PolygonGradient: fillColor_ = pBS->polygon.ccolor; break;
+        default: break;
+        }
+        solidFill_ = static_cast<BrushStyle>(pBS->mode) == BrushStyle::Default
+            ? static_cast<FillStyle>(pBS->def.style) == FillStyle::Solid
+            : static_cast<BrushStyle>(pBS->mode) != BrushStyle::Texture;
+#else
+        solidFill_ = static_cast<BrushStyle>(pBS->mode) == BrushStyle::Default
+            && static_cast<FillStyle>(pBS->def.style) == FillStyle::Solid;
+        fillColor_ = pBS->def.color;
+#endif
+        if (!shouldBind(1, brushSet->version())) {
+            bindStatistics_.brushElided++;
+            return;
+        }
+        bindStatistics_.brushBinds++;
+#ifndef GFT_HEADLESS
         switch (static_cast<BrushStyle>(pBS->mode)) {
         case BrushStyle::Default:
-            setfillstyle(pBS->def.style, pBS->def.color, IMG(target_));
+            setfillstyle(pBS->def.style, pBS->def.color, IMG(resolveTarget()));
             break;
         case BrushStyle::LinearGradient:
             ege_setpattern_lineargradient(
                 pBS->linear.x1, pBS->linear.y1, pBS->linear.color1,
                 pBS->linear.x2, pBS->linear.y2, pBS->linear.color2,
-                IMG(target_)
+                IMG(resolveTarget())
             );
             break;
         case BrushStyle::RadialGradient:
             ege_setpattern_ellipsegradient(
                 { pBS->radial.cx, pBS->radial.cy }, pBS->radial.ccolor,
                 pBS->radial.x, pBS->radial.y, pBS->radial.w, pBS->radial.h,
-                pBS->radial.ocolor, IMG(target_)
+                pBS->radial.ocolor, IMG(resolveTarget())
             );
             break;
         case BrushStyle::Texture:
             ege_setpattern_texture(
-                IMG(pBS->texture.data),
+                IMG(static_cast<TexturePrivate*>(pBS->texture.data)->image),
                 pBS->texture.x, pBS->texture.y,
                 pBS->texture.w, pBS->texture.h,
-                IMG(target_));
+                IMG(resolveTarget()));
             break;
         case BrushStyle::PolygonGradient:
             ege_setpattern_pathgradient(
                 { pBS->polygon.cx, pBS->polygon.cy }, pBS->polygon.ccolor,
                 pBS->polygon.num_points, (ege_point*)pBS->polygon.points,
                 pBS->polygon.num_colors, (color_t*)pBS->polygon.colors,
-                IMG(target_)
+                IMG(resolveTarget())
             );
             break;
         }
+#endif
     }
+    /// @details 录制期间文字配置同时作用于绘图目标，使录制时文字的测量结果与回放时一致
     void Graphics::bindTextSet(TextSet* textSet) {
+        if (recorder_) {
+            recorder_->bindTextSet(textSet);
+            auto recorder = std::exchange(recorder_, nullptr);
+            bindTextSet(textSet);
+            recorder_ = recorder;
+            return;
+        }
         if (textSet == nullptr) {
             bindTextSet(&defaultTextSet_);
             return;
         }
-        settextcolor(textSet->color_, IMG(target_));
-        setfont(FONT(textSet->font_.font_), IMG(target_));
-        setbkmode(textSet->transparent_ ? TRANSPARENT : OPAQUE, IMG(target_));
+        if (!shouldBind(2, textSet->version_)) {
+            bindStatistics_.textElided++;
+            return;
+        }
+        bindStatistics_.textBinds++;
+#ifdef GFT_HEADLESS
+        if (auto img = IMG(resolveTarget()))
+            img->fontSize = std::abs(textSet->font_.size());
+#else
+        settextcolor(textSet->color_, IMG(resolveTarget()));
+        setfont(FONT(textSet->font_.font_), IMG(resolveTarget()));
+        setbkmode(textSet->transparent_ ? TRANSPARENT : OPAQUE, IMG(resolveTarget()));
+#endif
     }
 
     void Graphics::drawLine(const fLine& line) {
-        ege_line(line.P1().x(), line.P1().y(), line.P2().x(), line.P2().y(), IMG(target_));
+        if (recorder_)
+            return recorder_->drawLine(line);
+#ifdef GFT_HEADLESS
+        points_.assign({ line.P1(), line.P2() });
+        strokeSoftware(false);
+#else
+        ege_line(line.P1().x(), line.P1().y(), line.P2().x(), line.P2().y(), IMG(target()));
+#endif
     }
     void Graphics::drawRect(const fRect& rect) {
-        ege_rectangle(rect.x(), rect.y(), rect.width(), rect.height(), IMG(target_));
+        if (recorder_)
+            return recorder_->drawRect(rect);
+#ifdef GFT_HEADLESS
+        points_.assign({ rect.position(), fPoint(rect.right(), rect.top()),
+            fPoint(rect.right(), rect.bottom()), fPoint(rect.left(), rect.bottom()) });
+        strokeSoftware(true);
+#else
+        ege_rectangle(rect.x(), rect.y(), rect.width(), rect.height(), IMG(target()));
+#endif
     }
     void Graphics::drawRoundRect(const fRoundRect& rect) {
+        if (recorder_)
+            return recorder_->drawRoundRect(rect);
+#ifdef GFT_HEADLESS
+        auto& r = rect.rect();
+        float lt = rect.radiusTopLeft(), rt = rect.radiusTopRight();
+        float rb = rect.radiusBottomRight(), lb = rect.radiusBottomLeft();
+        points_.clear();
+        _append_arc(points_, fPoint(r.left() + lt, r.top() + lt), lt, lt, 180, 90);
+        _append_arc(points_, fPoint(r.right() - rt, r.top() + rt), rt, rt, 270, 90);
+        _append_arc(points_, fPoint(r.right() - rb, r.bottom() - rb), rb, rb, 0, 90);
+        _append_arc(points_, fPoint(r.left() + lb, r.bottom() - lb), lb, lb, 90, 90);
+        strokeSoftware(true);
+#else
         ege_roundrect(
             rect.rect().x(), rect.rect().y(), rect.rect().width(), rect.rect().height(),
             rect.radiusTopLeft(), rect.radiusTopRight(),
             rect.radiusBottomLeft(), rect.radiusBottomRight(),
-            IMG(target_)
+            IMG(target())
         );
+#endif
     }
     void Graphics::drawArc(const fRect& rect, float startAngle, float sweepAngle) {
+        if (recorder_)
+            return recorder_->drawArc(rect, startAngle, sweepAngle);
+#ifdef GFT_HEADLESS
+        points_.clear();
+        _append_arc(points_, fPoint(rect.x() + rect.width() / 2, rect.y() + rect.height() / 2),
+            rect.width() / 2, rect.height() / 2, startAngle, sweepAngle);
+        strokeSoftware(false);
+#else
         ege_arc(
             rect.x(), rect.y(), rect.width(), rect.height(),
-            startAngle, sweepAngle, IMG(target_)
+            startAngle, sweepAngle, IMG(target())
         );
+#endif
     }
     void Graphics::drawEllipse(const fEllipse& ellipse) {
+        if (recorder_)
+            return recorder_->drawEllipse(ellipse);
+#ifdef GFT_HEADLESS
+        auto& r = ellipse.rect();
+        points_.clear();
+        _append_arc(points_, fPoint(r.x() + r.width() / 2, r.y() + r.height() / 2), r.width() / 2, r.height() / 2, 0, 360);
+        strokeSoftware(true);
+#else
         ege_ellipse(
             ellipse.rect().x(), ellipse.rect().y(),
             ellipse.rect().width(), ellipse.rect().height(),
-            IMG(target_)
+            IMG(target())
         );
+#endif
     }
     void Graphics::drawCircle(const fCircle& circle) {
-        ege_circle(circle.origin().x(), circle.origin().y(), circle.radius(), IMG(target_));
+        if (recorder_)
+            return recorder_->drawCircle(circle);
+#ifdef GFT_HEADLESS
+        points_.clear();
+        _append_arc(points_, circle.origin(), circle.radius(), circle.radius(), 0, 360);
+        strokeSoftware(true);
+#else
+        ege_circle(circle.origin().x(), circle.origin().y(), circle.radius(), IMG(target()));
+#endif
     }
     void Graphics::drawPie(const fRect& rect, float startAngle, float sweepAngle) {
+        if (recorder_)
+            return recorder_->drawPie(rect, startAngle, sweepAngle);
+#ifdef GFT_HEADLESS
+        fPoint center(rect.x() + rect.width() / 2, rect.y() + rect.height() / 2);
+        points_.assign({ center });
+        _append_arc(points_, center, rect.width() / 2, rect.height() / 2, startAngle, sweepAngle);
+        strokeSoftware(true);
+#else
         ege_pie(
             rect.x(), rect.y(), rect.width(), rect.height(),
-            startAngle, sweepAngle, IMG(target_)
+            startAngle, sweepAngle, IMG(target())
         );
+#endif
     }
     void Graphics::drawPolygon(const fPolygon& polygon) {
+        if (recorder_)
+            return recorder_->drawPolygon(polygon);
+#ifdef GFT_HEADLESS
+        points_.assign(polygon.points.begin(), polygon.points.end());
+        strokeSoftware(polygon.isClosed());
+#else
         bool closed = polygon.isClosed();
         auto count = polygon.count();
         if (count < 2)
@@ -278,20 +739,36 @@ namespace GFt {
             points[count].x = polygon.points[0].x();
             points[count].y = polygon.points[0].y();
         }
-        ege_drawpoly(count + (closed ? 1 : 0), points, IMG(target_));
+        ege_drawpoly(count + (closed ? 1 : 0), points, IMG(target()));
         delete[] points;
+#endif
     }
     void Graphics::drawBezier(const fBezier& curve) {
+        if (recorder_)
+            return recorder_->drawBezier(curve);
+#ifdef GFT_HEADLESS
+        points_.clear();
+        _append_bezier(points_, curve.points.data(), curve.points.size());
+        strokeSoftware(false);
+#else
         auto count = curve.count();
         ege_point* points = new ege_point[count];
         for (int i = 0; i < count; ++i) {
             points[i].x = curve.points[i].x();
             points[i].y = curve.points[i].y();
         }
-        ege_drawbezier(count, points, IMG(target_));
+        ege_drawbezier(count, points, IMG(target()));
         delete[] points;
+#endif
     }
     void Graphics::drawFitCurve(const fFitCurve& curve) {
+        if (recorder_)
+            return recorder_->drawFitCurve(curve);
+#ifdef GFT_HEADLESS
+        points_.clear();
+        _append_curve(points_, curve.points.data(), curve.points.size(), curve.tension, curve.isClosed());
+        strokeSoftware(curve.isClosed());
+#else
         auto count = curve.count();
         ege_point* points = new ege_point[count];
         for (int i = 0; i < count; ++i) {
@@ -299,119 +776,254 @@ namespace GFt {
             points[i].y = curve.points[i].y();
         }
         curve.isClosed()
-            ? ege_drawcurve(count, points, curve.tension, IMG(target_))
-            : ege_drawclosedcurve(count, points, curve.tension, IMG(target_));
+            ? ege_drawcurve(count, points, curve.tension, IMG(target()))
+            : ege_drawclosedcurve(count, points, curve.tension, IMG(target()));
         delete[] points;
+#endif
     }
     void Graphics::drawPath(const Path& path, const fPoint& pos) {
-        ege_drawpath(PATH(path.data_), pos.x(), pos.y(), IMG(target_));
+        if (recorder_)
+            return recorder_->drawPath(path, pos);
+#ifdef GFT_HEADLESS
+        for (auto& figure : PATH(path.data_)->figures) {
+            points_.clear();
+            for (auto& point : figure.points)
+                points_.push_back(point + pos);
+            strokeSoftware(figure.closed);
+        }
+#else
+        ege_drawpath(PATH(path.data_), pos.x(), pos.y(), IMG(target()));
+#endif
     }
     void Graphics::drawFillRect(const fRect& rect) {
-        ege_fillrect(rect.x(), rect.y(), rect.width(), rect.height(), IMG(target_));
+        if (recorder_)
+            return recorder_->drawFillRect(rect);
+        if (beginSoftwareFill()) {
+            points_.assign({ rect.position(), fPoint(rect.right(), rect.top()),
+                fPoint(rect.right(), rect.bottom()), fPoint(rect.left(), rect.bottom()) });
+            endSoftwareFill();
+            return;
+        }
+#ifndef GFT_HEADLESS
+        ege_fillrect(rect.x(), rect.y(), rect.width(), rect.height(), IMG(target()));
+#endif
     }
+    /// @details 各个圆角的半径被限制在宽高的一半以内
     void Graphics::drawFillRoundRect(const fRoundRect& rect) {
+        if (recorder_)
+            return recorder_->drawFillRoundRect(rect);
+        if (beginSoftwareFill()) {
+            auto& r = rect.rect();
+            float limit = std::min(r.width(), r.height()) / 2;
+            auto radius = [&](float v) { return std::max(0.0f, std::min(v, limit)); };
+            float lt = radius(rect.radiusTopLeft()), rt = radius(rect.radiusTopRight());
+            float rb = radius(rect.radiusBottomRight()), lb = radius(rect.radiusBottomLeft());
+            _append_arc(points_, fPoint(r.left() + lt, r.top() + lt), lt, lt, 180, 90);
+            _append_arc(points_, fPoint(r.right() - rt, r.top() + rt), rt, rt, 270, 90);
+            _append_arc(points_, fPoint(r.right() - rb, r.bottom() - rb), rb, rb, 0, 90);
+            _append_arc(points_, fPoint(r.left() + lb, r.bottom() - lb), lb, lb, 90, 90);
+            endSoftwareFill();
+            return;
+        }
+#ifndef GFT_HEADLESS
         ege_fillroundrect(
             rect.rect().x(), rect.rect().y(), rect.rect().width(), rect.rect().height(),
             rect.radiusTopLeft(), rect.radiusTopRight(),
             rect.radiusBottomLeft(), rect.radiusBottomRight(),
-            IMG(target_)
+            IMG(target())
         );
+#endif
     }
     void Graphics::drawFillPie(const fRect& rect, float startAngle, float sweepAngle) {
+        if (recorder_)
+            return recorder_->drawFillPie(rect, startAngle, sweepAngle);
+        if (beginSoftwareFill()) {
+            fPoint center(rect.x() + rect.width() / 2, rect.y() + rect.height() / 2);
+            points_.push_back(center);
+            _append_arc(points_, center, rect.width() / 2, rect.height() / 2, startAngle, sweepAngle);
+            endSoftwareFill();
+            return;
+        }
+#ifndef GFT_HEADLESS
         ege_fillpie(
             rect.x(), rect.y(), rect.width(), rect.height(),
-            startAngle, sweepAngle, IMG(target_)
+            startAngle, sweepAngle, IMG(target())
         );
+#endif
     }
     /// @details 如果传入的多边形不是闭合的, 则此函数无效果
     void Graphics::drawFillPolygon(const fPolygon& polygon) {
+        if (recorder_)
+            return recorder_->drawFillPolygon(polygon);
         if (!polygon.isClosed() || polygon.count() < 2)
             return;
+        if (beginSoftwareFill()) {
+            points_.assign(polygon.points.begin(), polygon.points.end());
+            endSoftwareFill();
+            return;
+        }
+#ifndef GFT_HEADLESS
         auto count = polygon.count();
         ege_point* points = new ege_point[count];
         for (int i = 0; i < count; ++i) {
             points[i].x = polygon.points[i].x();
             points[i].y = polygon.points[i].y();
         }
-        ege_fillpoly(count, points, IMG(target_));
+        ege_fillpoly(count, points, IMG(target()));
         delete[] points;
+#endif
     }
     void Graphics::drawFillEllipse(const fEllipse& rect) {
+        if (recorder_)
+            return recorder_->drawFillEllipse(rect);
+        if (beginSoftwareFill()) {
+            auto& r = rect.rect();
+            _append_arc(points_, fPoint(r.x() + r.width() / 2, r.y() + r.height() / 2), r.width() / 2, r.height() / 2, 0, 360);
+            endSoftwareFill();
+            return;
+        }
+#ifndef GFT_HEADLESS
         ege_fillellipse(
             rect.rect().x(), rect.rect().y(),
             rect.rect().width(), rect.rect().height(),
-            IMG(target_)
+            IMG(target())
         );
+#endif
     }
     void Graphics::drawFillCircle(const fCircle& circle) {
-        ege_fillcircle(circle.origin().x(), circle.origin().y(), circle.radius(), IMG(target_));
+        if (recorder_)
+            return recorder_->drawFillCircle(circle);
+        if (beginSoftwareFill()) {
+            _append_arc(points_, circle.origin(), circle.radius(), circle.radius(), 0, 360);
+            endSoftwareFill();
+            return;
+        }
+#ifndef GFT_HEADLESS
+        ege_fillcircle(circle.origin().x(), circle.origin().y(), circle.radius(), IMG(target()));
+#endif
     }
     /// @details 如果传入的曲线不是闭合的, 则此函数无效果
     void Graphics::drawFillFitCurve(const fFitCurve& curve) {
+        if (recorder_)
+            return recorder_->drawFillFitCurve(curve);
         if (!curve.isClosed())
             return;
+#ifdef GFT_HEADLESS
+        if (beginSoftwareFill()) {
+            _append_curve(points_, curve.points.data(), curve.points.size(), curve.tension, true);
+            endSoftwareFill();
+        }
+#else
         auto count = curve.count();
         ege_point* points = new ege_point[count];
         for (int i = 0; i < count; ++i) {
             points[i].x = curve.points[i].x();
             points[i].y = curve.points[i].y();
         }
-        ege_fillclosedcurve(count, points, curve.tension, IMG(target_));
+        ege_fillclosedcurve(count, points, curve.tension, IMG(target()));
         delete[] points;
+#endif
     }
     void Graphics::drawFillPath(const Path& path, const fPoint& pos) {
-        ege_fillpath(PATH(path.data_), pos.x(), pos.y(), IMG(target_));
+        if (recorder_)
+            return recorder_->drawFillPath(path, pos);
+#ifdef GFT_HEADLESS
+        for (auto& figure : PATH(path.data_)->figures) {
+            if (!beginSoftwareFill())
+                return;
+            for (auto& point : figure.points)
+                points_.push_back(point + pos);
+            endSoftwareFill();
+        }
+#else
+        ege_fillpath(PATH(path.data_), pos.x(), pos.y(), IMG(target()));
+#endif
     }
     void Graphics::drawImage(const fPoint& pos, const PixelMap& pixelMap) {
-        ege_drawimage(IMG(pixelMap.pixmap_), pos.x(), pos.y(), IMG(target_));
+        if (recorder_)
+            return recorder_->drawImage(pos, pixelMap);
+#ifdef GFT_HEADLESS
+        fSize size(pixelMap.size());
+        drawImage(fRect(pos, size), fRect(fPoint(), size), pixelMap);
+#else
+        ege_drawimage(IMG(pixelMap.pixmap_), pos.x(), pos.y(), IMG(target()));
+#endif
     }
     void Graphics::drawImage(const fRect& dest, const fRect& src, const PixelMap& pixelMap) {
+        if (recorder_)
+            return recorder_->drawImage(dest, src, pixelMap);
+#ifdef GFT_HEADLESS
+        auto& m = transform_;
+        drawPixels(pixelMap, fRect(dest.x() * m[0][0] + m[2][0], dest.y() * m[1][1] + m[2][1],
+            dest.width() * m[0][0], dest.height() * m[1][1]), src, false);
+#else
         ege_drawimage(
             IMG(pixelMap.pixmap_),
             dest.x(), dest.y(), dest.width(), dest.height(),
             src.x(), src.y(), src.width(), src.height(),
-            IMG(target_)
+            IMG(target())
         );
+#endif
     }
     void Graphics::drawAlphaImage(const PixelMap& pixelMap, const fPoint& dest, const fRect& src) {
+        if (recorder_)
+            return recorder_->drawAlphaImage(pixelMap, dest, src);
+#ifdef GFT_HEADLESS
+        drawPixels(pixelMap, fRect(dest, src.size()), src, true);
+#else
         putimage_withalpha(
-            IMG(target_),
+            IMG(target()),
             IMG(pixelMap.pixmap_),
             dest.x(), dest.y(),
             src.x(), src.y(), src.width(), src.height()
         );
+#endif
     }
-    void Graphics::drawAlphaImage(const PixelMap& pixelMap, const fRect& dest, const fRect& src, bool smooth) {
+    void Graphics::drawAlphaImage(const PixelMap& pixelMap, const fRect& dest, const fRect& src, [[maybe_unused]] bool smooth) {
+        if (recorder_)
+            return recorder_->drawAlphaImage(pixelMap, dest, src, smooth);
+#ifdef GFT_HEADLESS
+        drawPixels(pixelMap, dest, src, true);
+#else
         putimage_withalpha(
-            IMG(target_),
+            IMG(target()),
             IMG(pixelMap.pixmap_),
             dest.x(), dest.y(), dest.width(), dest.height(),
             src.x(), src.y(), src.width(), src.height(),
             smooth
         );
+#endif
     }
     int Graphics::drawText(
         const std::wstring& text, const fPoint& pos,
         const std::vector<std::wstring>& fonts, bool show) {
+        if (recorder_) {
+            if (show)
+                recorder_->drawText(text, pos, fonts);
+            return textWidth(text, fonts);
+        }
+#ifdef GFT_HEADLESS
+        return textWidth(text, fonts);
+#else
         // 若没有指定字体, 则使用当前配置字体
         if (fonts.empty()) {
-            ege_outtextxy(pos.x(), pos.y(), text.c_str(), IMG(target_));
-            return textwidth(text.c_str(), IMG(target_));
+            ege_outtextxy(pos.x(), pos.y(), text.c_str(), IMG(target()));
+            return textwidth(text.c_str(), IMG(target()));
         }
         // 否则, 尝试使用指定的字体
         std::size_t* count = new size_t[text.length()]{ 0 };
         int width = 0;
         LOGFONTW fs, fset;
         // 保存当前字体环境
-        getfont(&fs, IMG(target_));
-        getfont(&fset, IMG(target_));
+        getfont(&fs, IMG(target()));
+        getfont(&fset, IMG(target()));
         // 查找字体的支持情况
         for (std::size_t i = 0; i < fonts.size(); ++i) {
             WORD* indices = new WORD[text.length()]{ 0 };
             wcscpy_s(fset.lfFaceName, LF_FACESIZE, fonts[i].c_str());
-            setfont(&fset, IMG(target_));
+            setfont(&fset, IMG(target()));
             GetGlyphIndicesW(
-                getHDC(IMG(target_)), text.c_str(), text.length(),
+                getHDC(IMG(target())), text.c_str(), text.length(),
                 indices, GGI_MARK_NONEXISTING_GLYPHS);
             for (std::size_t j = 0; j < text.length(); ++j)
                 if (indices[j] != 0xFFFF && count[j] == 0)
@@ -423,29 +1035,37 @@ namespace GFt {
             if (count[i])
                 wcscpy_s(fset.lfFaceName, LF_FACESIZE, fonts[count[i] - 1].c_str());
             LOGFONTW* pfs = count == 0 ? &fs : &fset;
-            setfont(pfs, IMG(target_));
+            setfont(pfs, IMG(target()));
             if (show)
-                ege_outtextxy(pos.x() + width, pos.y(), text[i], IMG(target_));
+                ege_outtextxy(pos.x() + width, pos.y(), text[i], IMG(target()));
             // 统计宽度
-            width += textwidth(text[i], IMG(target_));
+            width += textwidth(text[i], IMG(target()));
         }
         // 还原字体环境
-        setfont(&fs, IMG(target_));
+        setfont(&fs, IMG(target()));
         delete[] count;
         return width;
+#endif
     }
     /// @details 若传入了无效的 flags, 则此函数将会忽略它们, 并使用默认的对齐方式(左上对齐)
     int Graphics::drawText(const std::wstring& text, const fRect& rect, int flags, const std::vector<std::wstring>& fonts) {
+        if (recorder_) {
+            recorder_->drawText(text, rect, flags, fonts);
+            return textWidth(text, fonts);
+        }
+#ifdef GFT_HEADLESS
+        return drawText(text, rect.position(), fonts);
+#else
         TextAlign halign = static_cast<TextAlign>(flags & 0x0F);
         TextAlign valign = static_cast<TextAlign>((flags >> 4) & 0x0F);
         float x = rect.x();
         float y = rect.y();
         switch (halign) {
         case TextAlign::Center:
-            x += rect.width() / 2.f - textwidth(text.c_str(), IMG(target_)) / 2.f;
+            x += rect.width() / 2.f - textwidth(text.c_str(), IMG(target())) / 2.f;
             break;
         case TextAlign::Right:
-            x += rect.width() - textwidth(text.c_str(), IMG(target_));
+            x += rect.width() - textwidth(text.c_str(), IMG(target()));
             break;
         case TextAlign::Left:
             [[fallthrough]];
@@ -454,10 +1074,10 @@ namespace GFt {
         }
         switch (valign) {
         case TextAlign::Center:
-            y += rect.height() / 2.f - textheight(text.c_str(), IMG(target_)) / 2.f;
+            y += rect.height() / 2.f - textheight(text.c_str(), IMG(target())) / 2.f;
             break;
         case TextAlign::Bottom:
-            y += rect.height() - textheight(text.c_str(), IMG(target_));
+            y += rect.height() - textheight(text.c_str(), IMG(target()));
             break;
         case TextAlign::Top:
             [[fallthrough]];
@@ -465,5 +1085,6 @@ namespace GFt {
             break;
         }
         return drawText(text, fPoint{ x, y }, fonts);
+#endif
     }
 }
\ No newline at end of file
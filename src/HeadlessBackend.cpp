@@ -0,0 +1,148 @@
+#include "GraceFt/HeadlessBackend.h"
+#include <_private_draw.inl>
+
+#include <GraceFt/Application.h>
+#include <algorithm>
+#include <utility>
+
+namespace GFt {
+    using namespace literals;
+    namespace {
+        constexpr Color background = 0xffffff_rgb;
+    }
+    HeadlessBackend::HeadlessBackend(const iSize& screenSize, int dpi)
+        : screenSize_(screenSize), dpi_(dpi) {}
+
+    const PixelMap& HeadlessBackend::framebuffer() const { return screen_; }
+    std::size_t HeadlessBackend::presentedFrames() const { return frames_; }
+    long long HeadlessBackend::presentedArea() const { return presentedArea_; }
+    const std::wstring& HeadlessBackend::title() const { return title_; }
+    bool HeadlessBackend::isVisible() const { return visible_; }
+
+    /// @details 与窗口过程一样，收到输入后请求一帧以唤醒按需模式下的主循环
+    void HeadlessBackend::pushMouse(const MouseMessage& msg) {
+        {
+            std::lock_guard<std::mutex> lock(inputMutex_);
+            mouse_.push_back(msg);
+            cursor_ = origin_ + msg.position;
+        }
+        Application::requestFrame();
+    }
+    void HeadlessBackend::pushKey(const KeyMessage& msg) {
+        {
+            std::lock_guard<std::mutex> lock(inputMutex_);
+            keys_.push_back(msg);
+        }
+        Application::requestFrame();
+    }
+    void HeadlessBackend::moveMouse(const iPoint& pos) {
+        pushMouse(MouseMessage{ MouseMessage::Type::Move, pos });
+    }
+    void HeadlessBackend::pressMouse(const iPoint& pos, MouseButton button) {
+        pushMouse(MouseMessage{ MouseMessage::Type::Press, pos, button });
+    }
+    void HeadlessBackend::releaseMouse(const iPoint& pos, MouseButton button) {
+        pushMouse(MouseMessage{ MouseMessage::Type::Release, pos, button });
+    }
+    void HeadlessBackend::click(const iPoint& pos, MouseButton button) {
+        pressMouse(pos, button);
+        releaseMouse(pos, button);
+    }
+    void HeadlessBackend::scrollMouse(const iPoint& pos, MouseWheel wheel) {
+        pushMouse(MouseMessage{ MouseMessage::Type::Wheel, pos, MouseButton::Unknown, wheel });
+    }
+    void HeadlessBackend::pressKey(Key key, bool shift, bool ctrl) {
+        pushKey(KeyMessage{ KeyMessage::Type::Press, static_cast<int>(key), shift, ctrl });
+    }
+    void HeadlessBackend::releaseKey(Key key, bool shift, bool ctrl) {
+        pushKey(KeyMessage{ KeyMessage::Type::Release, static_cast<int>(key), shift, ctrl });
+    }
+    void HeadlessBackend::typeText(const std::wstring& text) {
+        for (auto c : text)
+            pushKey(KeyMessage{ KeyMessage::Type::Char, static_cast<int>(c) });
+    }
+
+    bool HeadlessBackend::createWindow(const iSize& size, int flags) {
+        screen_ = PixelMap(size);
+        clear();
+        running_ = true;
+        visible_ = !(flags & Hidden);
+        return true;
+    }
+    void HeadlessBackend::closeWindow() { running_ = false; }
+    bool HeadlessBackend::isRunning() { return running_; }
+    void HeadlessBackend::waitFrame(double) {}
+
+    void HeadlessBackend::showWindow(bool show) { visible_ = show; }
+    void HeadlessBackend::resizeWindow(const iSize& size) {
+        screen_ = PixelMap(size);
+        clear();
+    }
+    void HeadlessBackend::moveWindow(const iPoint& pos) {
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        cursor_ = cursor_ - origin_ + pos;
+        origin_ = pos;
+    }
+    void HeadlessBackend::minimizeWindow() {}
+    void HeadlessBackend::setWindowTitle(const std::wstring& title) { title_ = title; }
+    void HeadlessBackend::setWindowTopMost(bool) {}
+    void HeadlessBackend::setWindowFrameless(bool) {}
+    void HeadlessBackend::setWindowAlpha(float) {}
+    void HeadlessBackend::setWindowColorKey(const std::optional<Color>&) {}
+    /// @details 模拟的窗口没有边框，窗口区域与客户区相同
+    iRect HeadlessBackend::windowRect() { return clientRect(); }
+    iRect HeadlessBackend::clientRect() { return iRect(origin_, screen_.size()); }
+
+    iSize HeadlessBackend::screenSize() { return screenSize_; }
+    iRect HeadlessBackend::workArea() { return iRect(iPoint(), screenSize_); }
+    int HeadlessBackend::dpi() { return dpi_; }
+    iPoint HeadlessBackend::cursorPosition() {
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        return cursor_;
+    }
+    bool HeadlessBackend::showCursor(bool show) { return std::exchange(cursorVisible_, show); }
+
+    bool HeadlessBackend::pollMouse(MouseMessage& msg) {
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        if (mouse_.empty())
+            return false;
+        msg = mouse_.front();
+        mouse_.pop_front();
+        return true;
+    }
+    bool HeadlessBackend::pollKey(KeyMessage& msg) {
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        if (keys_.empty())
+            return false;
+        msg = keys_.front();
+        keys_.pop_front();
+        return true;
+    }
+    bool HeadlessBackend::hasMouse() {
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        return !mouse_.empty();
+    }
+    bool HeadlessBackend::hasKey() {
+        std::lock_guard<std::mutex> lock(inputMutex_);
+        return !keys_.empty();
+    }
+
+    PixelMap* HeadlessBackend::screen() { return &screen_; }
+    void HeadlessBackend::clear() { clear(iRect(iPoint(), screen_.size())); }
+    /// @details 直接写入像素，不经过 Graphics，也不改变屏幕上的绘图状态
+    void HeadlessBackend::clear(const iRect& rect) {
+        auto view = screen_.view(rect);
+        for (int y = 0; y < view.height(); y++)
+            std::fill_n(view.pixels(y), view.width(), _GFt_private_::_pack_color(background));
+    }
+    void HeadlessBackend::present(const DamageRegion* damage) {
+        frames_++;
+        presentedArea_ += damage ? damage->area()
+            : static_cast<long long>(screen_.size().width()) * screen_.size().height();
+    }
+}
+#ifdef GFT_HEADLESS
+namespace _GFt_private_ {
+    std::unique_ptr<GFt::Backend> _make_default_backend() { return std::make_unique<GFt::HeadlessBackend>(); }
+}
+#endif
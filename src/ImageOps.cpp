@@ -0,0 +1,437 @@
+#include "GraceFt/ImageOps.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GFT_IMAGE_SSE2
+#endif
+
+namespace GFt {
+    namespace ImageOps {
+        namespace {
+            template<typename View>
+            void requireColor(const View& view) {
+                if (view.bytesPerPixel() != 4)
+                    throw std::invalid_argument("Image must have 4 bytes per pixel");
+            }
+            void requireSameSize(const ConstPixelView& a, const ConstPixelView& b) {
+                if (a.width() != b.width() || a.height() != b.height())
+                    throw std::invalid_argument("Image sizes do not match");
+            }
+            /// @brief 按行并行处理
+            template<typename F>
+            void forRows(int height, ThreadPool& pool, F&& body) {
+                pool.parallelFor(0, static_cast<std::size_t>(std::max(height, 0)), [&](std::size_t y) {
+                    body(static_cast<int>(y));
+                });
+            }
+            /// @brief x / 255 并四舍五入，x 不超过 255 * 255
+            /// @details 与 SSE2 版本逐位一致
+            inline std::uint32_t div255(std::uint32_t x) { return ((x + 128) * 257) >> 16; }
+            inline std::uint32_t channel(std::uint32_t p, int i) { return (p >> (i * 8)) & 0xff; }
+
+#ifdef GFT_IMAGE_SSE2
+            /// @brief 16 位通道的 x / 255 并四舍五入
+            inline __m128i div255(__m128i x) {
+                return _mm_mulhi_epu16(_mm_add_epi16(x, _mm_set1_epi16(128)), _mm_set1_epi16(257));
+            }
+            /// @brief 将每个像素的透明度复制到该像素的 4 个 16 位通道
+            inline __m128i alphas(__m128i p) {
+                return _mm_shufflehi_epi16(_mm_shufflelo_epi16(p, 0xff), 0xff);
+            }
+            inline __m128i load(const std::uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+            inline void store(std::uint8_t* p, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+#endif
+
+            void premultiplyRow(std::uint8_t* row, int width) {
+                int x = 0;
+#ifdef GFT_IMAGE_SSE2
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i colorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+                const __m128i alphaOne = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+                auto scale = [&](__m128i p) {
+                    auto k = _mm_or_si128(_mm_and_si128(alphas(p), colorMask), alphaOne);
+                    return div255(_mm_mullo_epi16(p, k));
+                };
+                for (; x + 4 <= width; x += 4) {
+                    auto p = load(row + x * 4);
+                    store(row + x * 4, _mm_packus_epi16(
+                        scale(_mm_unpacklo_epi8(p, zero)), scale(_mm_unpackhi_epi8(p, zero))));
+                }
+#endif
+                for (; x < width; x++) {
+                    auto p = row + x * 4;
+                    for (int i = 0; i < 3; i++)
+                        p[i] = static_cast<std::uint8_t>(div255(p[i] * p[3]));
+                }
+            }
+            /// @details 没有整数除法指令可用，使用倒数表逐像素计算
+            void unpremultiplyRow(std::uint8_t* row, int width) {
+                static const auto reciprocal = [] {
+                    std::vector<std::uint32_t> table(256, 0);
+                    for (std::uint32_t a = 1; a < 256; a++)
+                        table[a] = ((255u << 16) + a / 2) / a;
+                    return table;
+                }();
+                for (int x = 0; x < width; x++) {
+                    auto p = row + x * 4;
+                    auto r = reciprocal[p[3]];
+                    for (int i = 0; i < 3; i++)
+                        p[i] = static_cast<std::uint8_t>(std::min<std::uint32_t>(255, (p[i] * r + 0x8000) >> 16));
+                }
+            }
+            void blendRow(std::uint8_t* dst, const std::uint8_t* src, int width, int opacity) {
+                int x = 0;
+#ifdef GFT_IMAGE_SSE2
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i k = _mm_set1_epi16(static_cast<short>(opacity));
+                const __m128i full = _mm_set1_epi16(255);
+                auto over = [&](__m128i s, __m128i d) {
+                    if (opacity < 255)
+                        s = div255(_mm_mullo_epi16(s, k));
+                    d = div255(_mm_mullo_epi16(d, _mm_sub_epi16(full, alphas(s))));
+                    return _mm_add_epi16(s, d);
+                };
+                for (; x + 4 <= width; x += 4) {
+                    auto s = load(src + x * 4), d = load(dst + x * 4);
+                    store(dst + x * 4, _mm_packus_epi16(
+                        over(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero)),
+                        over(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero))));
+                }
+#endif
+                for (; x < width; x++) {
+                    std::uint32_t s[4];
+                    for (int i = 0; i < 4; i++)
+                        s[i] = opacity < 255 ? div255(src[x * 4 + i] * opacity) : src[x * 4 + i];
+                    for (int i = 0; i < 4; i++) {
+                        auto d = dst + x * 4 + i;
+                        *d = static_cast<std::uint8_t>(std::min<std::uint32_t>(255, s[i] + div255(*d * (255 - s[3]))));
+                    }
+                }
+            }
+            void colorKeyRow(std::uint8_t* row, int width, std::uint32_t key, int tolerance) {
+                int x = 0;
+#ifdef GFT_IMAGE_SSE2
+                const __m128i k = _mm_set1_epi32(static_cast<int>(key));
+                // 透明度通道的容差为 255，总是视为匹配
+                const __m128i t = _mm_set1_epi32(static_cast<int>(0xff000000u | 0x010101u * tolerance));
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i ones = _mm_set1_epi32(-1);
+                for (; x + 4 <= width; x += 4) {
+                    auto p = load(row + x * 4);
+                    auto diff = _mm_or_si128(_mm_subs_epu8(p, k), _mm_subs_epu8(k, p));
+                    auto match = _mm_cmpeq_epi32(_mm_cmpeq_epi8(_mm_subs_epu8(diff, t), zero), ones);
+                    store(row + x * 4, _mm_andnot_si128(match, p));
+                }
+#endif
+                for (; x < width; x++) {
+                    std::uint32_t p;
+                    std::memcpy(&p, row + x * 4, 4);
+                    bool match = true;
+                    for (int i = 0; i < 3; i++)
+                        match = match && std::abs(static_cast<int>(channel(p, i)) - static_cast<int>(channel(key, i))) <= tolerance;
+                    if (match)
+                        std::memset(row + x * 4, 0, 4);
+                }
+            }
+            /// @brief 交换每个像素的第 0 与第 2 个字节，用于 BGRA8 与 RGBA8 互相转换
+            void swapRow(const std::uint8_t* src, std::uint8_t* dst, int width) {
+                int x = 0;
+#ifdef GFT_IMAGE_SSE2
+                const __m128i keep = _mm_set1_epi32(static_cast<int>(0xff00ff00u));
+                const __m128i low = _mm_set1_epi32(0xff);
+                for (; x + 4 <= width; x += 4) {
+                    auto p = load(src + x * 4);
+                    store(dst + x * 4, _mm_or_si128(_mm_and_si128(p, keep), _mm_or_si128(
+                        _mm_and_si128(_mm_srli_epi32(p, 16), low), _mm_slli_epi32(_mm_and_si128(p, low), 16))));
+                }
+#endif
+                for (; x < width; x++) {
+                    auto s = src + x * 4;
+                    auto d = dst + x * 4;
+                    std::uint8_t b0 = s[0], b1 = s[1], b2 = s[2], b3 = s[3];
+                    d[0] = b2, d[1] = b1, d[2] = b0, d[3] = b3;
+                }
+            }
+            /// @param w 每个字节位置的权重，和为 256
+            void grayRow(const std::uint8_t* src, std::uint8_t* dst, int width, const int (&w)[3]) {
+                int x = 0;
+#ifdef GFT_IMAGE_SSE2
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i weights = _mm_set_epi16(0, static_cast<short>(w[2]), static_cast<short>(w[1]), static_cast<short>(w[0]),
+                    0, static_cast<short>(w[2]), static_cast<short>(w[1]), static_cast<short>(w[0]));
+                // 两个像素的加权和分别位于第 0 与第 1 个 32 位通道
+                auto sums = [&](__m128i p) {
+                    auto m = _mm_madd_epi16(p, weights);
+                    m = _mm_add_epi32(m, _mm_srli_epi64(m, 32));
+                    return _mm_shuffle_epi32(m, _MM_SHUFFLE(3, 1, 2, 0));
+                };
+                for (; x + 4 <= width; x += 4) {
+                    auto p = load(src + x * 4);
+                    auto g = _mm_srli_epi32(_mm_unpacklo_epi64(
+                        sums(_mm_unpacklo_epi8(p, zero)), sums(_mm_unpackhi_epi8(p, zero))), 8);
+                    g = _mm_packus_epi16(_mm_packs_epi32(g, g), zero);
+                    auto bytes = _mm_cvtsi128_si32(g);
+                    std::memcpy(dst + x, &bytes, 4);
+                }
+#endif
+                for (; x < width; x++) {
+                    auto s = src + x * 4;
+                    dst[x] = static_cast<std::uint8_t>((s[0] * w[0] + s[1] * w[1] + s[2] * w[2]) >> 8);
+                }
+            }
+            void expandGrayRow(const std::uint8_t* src, std::uint8_t* dst, int width) {
+                for (int x = 0; x < width; x++) {
+                    auto p = 0xff000000u | 0x010101u * src[x];
+                    std::memcpy(dst + x * 4, &p, 4);
+                }
+            }
+
+            /// @brief 权重的定点数位数
+            constexpr int weightBits = 14;
+            /// @brief 纵向累加结果的定点数位数
+            constexpr int accBits = 7;
+
+            /// @brief 一维重采样的权重表
+            /// @details 每个输出下标使用固定数量的采样，数量补齐为偶数以便两两乘加；
+            ///          采样下标已限制在源图像范围内，权重为定点数，每个输出下标的权重和恰为 1
+            struct Kernel {
+                int taps = 0;
+                std::vector<int> index;
+                std::vector<std::int16_t> weight;
+
+                Kernel(int outputs, int taps)
+                    : taps(taps + taps % 2), index(std::size_t(outputs) * this->taps), weight(index.size()) {}
+                /// @brief 设置一个输出下标的采样，舍入误差计入最大的权重
+                void set(int output, const int* indices, const float* weights, int count) {
+                    auto i = index.data() + output * taps;
+                    auto w = weight.data() + output * taps;
+                    int sum = 0, largest = 0;
+                    for (int t = 0; t < taps; t++) {
+                        i[t] = indices[std::min(t, count - 1)];
+                        w[t] = t < count ? static_cast<std::int16_t>(std::lround(weights[t] * (1 << weightBits))) : 0;
+                        sum += w[t];
+                        if (w[t] > w[largest])
+                            largest = t;
+                    }
+                    w[largest] = static_cast<std::int16_t>(w[largest] + (1 << weightBits) - sum);
+                }
+            };
+            Kernel bilinearKernel(int from, int to) {
+                Kernel k(to, 2);
+                auto scale = static_cast<double>(from) / to;
+                for (int o = 0; o < to; o++) {
+                    auto center = (o + 0.5) * scale - 0.5;
+                    auto i = static_cast<int>(std::floor(center));
+                    auto f = static_cast<float>(center - i);
+                    int indices[2] = { std::clamp(i, 0, from - 1), std::clamp(i + 1, 0, from - 1) };
+                    float weights[2] = { 1 - f, f };
+                    k.set(o, indices, weights, 2);
+                }
+                return k;
+            }
+            /// @details 输出像素对应源图像中长度为 scale 的区间，权重为每个源像素与区间重叠的长度
+            Kernel boxKernel(int from, int to) {
+                auto scale = static_cast<double>(from) / to;
+                auto taps = static_cast<int>(std::ceil(scale)) + 1;
+                Kernel k(to, taps);
+                std::vector<int> indices(taps);
+                std::vector<float> weights(taps);
+                for (int o = 0; o < to; o++) {
+                    auto begin = o * scale, end = (o + 1) * scale;
+                    auto first = static_cast<int>(std::floor(begin));
+                    for (int t = 0; t < taps; t++) {
+                        auto i = first + t;
+                        auto overlap = std::min<double>(i + 1, end) - std::max<double>(i, begin);
+                        indices[t] = std::clamp(i, 0, from - 1);
+                        weights[t] = overlap > 0 ? static_cast<float>(overlap / scale) : 0.0f;
+                    }
+                    k.set(o, indices.data(), weights.data(), taps);
+                }
+                return k;
+            }
+            Kernel gaussianKernel(int size, float sigma) {
+                auto radius = static_cast<int>(std::ceil(sigma * 3));
+                std::vector<float> weights(radius * 2 + 1);
+                float sum = 0;
+                for (int t = -radius; t <= radius; t++)
+                    sum += weights[t + radius] = std::exp(-0.5f * t * t / (sigma * sigma));
+                for (auto& w : weights)
+                    w /= sum;
+                Kernel k(size, radius * 2 + 1);
+                std::vector<int> indices(weights.size());
+                for (int o = 0; o < size; o++) {
+                    for (int t = 0; t < static_cast<int>(indices.size()); t++)
+                        indices[t] = std::clamp(o + t - radius, 0, size - 1);
+                    k.set(o, indices.data(), weights.data(), static_cast<int>(indices.size()));
+                }
+                return k;
+            }
+
+            /// @brief 纵向累加：将若干源行按权重求和，结果以 accBits 位小数的定点数写入 acc
+            /// @details 每两行的像素交错后由一次 16 位乘加处理；
+            ///          每 4 个像素在寄存器中累加完所有源行后再写回，acc 只被写入一次
+            void accumulateRows(std::int16_t* acc, const std::uint8_t* const* rows, const std::int16_t* weights,
+                int count, int width) {
+                constexpr int shift = weightBits - accBits;
+                int x = 0;
+#ifdef GFT_IMAGE_SSE2
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i half = _mm_set1_epi32(1 << (shift - 1));
+                for (; x + 4 <= width; x += 4) {
+                    __m128i sum[4] = { half, half, half, half };
+                    for (int t = 0; t < count; t += 2) {
+                        auto a = load(rows[t] + x * 4), b = load(rows[t + 1] + x * 4);
+                        std::int32_t pair;
+                        std::memcpy(&pair, weights + t, 4);
+                        auto w = _mm_set1_epi32(pair);
+                        auto lo = _mm_unpacklo_epi8(a, b), hi = _mm_unpackhi_epi8(a, b);
+                        sum[0] = _mm_add_epi32(sum[0], _mm_madd_epi16(_mm_unpacklo_epi8(lo, zero), w));
+                        sum[1] = _mm_add_epi32(sum[1], _mm_madd_epi16(_mm_unpackhi_epi8(lo, zero), w));
+                        sum[2] = _mm_add_epi32(sum[2], _mm_madd_epi16(_mm_unpacklo_epi8(hi, zero), w));
+                        sum[3] = _mm_add_epi32(sum[3], _mm_madd_epi16(_mm_unpackhi_epi8(hi, zero), w));
+                    }
+                    for (int i = 0; i < 4; i++)
+                        sum[i] = _mm_srai_epi32(sum[i], shift);
+                    store(reinterpret_cast<std::uint8_t*>(acc + x * 4), _mm_packs_epi32(sum[0], sum[1]));
+                    store(reinterpret_cast<std::uint8_t*>(acc + x * 4 + 8), _mm_packs_epi32(sum[2], sum[3]));
+                }
+#endif
+                for (x *= 4; x < width * 4; x++) {
+                    std::int32_t sum = 1 << (shift - 1);
+                    for (int t = 0; t < count; t++)
+                        sum += rows[t][x] * weights[t];
+                    acc[x] = static_cast<std::int16_t>(std::min(sum >> shift, 32767));
+                }
+            }
+            /// @brief 横向采样：对纵向累加的结果按权重表求和并写入目标行
+            /// @details 每两个采样的通道交错后由一次 16 位乘加处理
+            void resampleRow(const std::int16_t* acc, std::uint8_t* dst, int width, const Kernel& k) {
+                constexpr int shift = weightBits + accBits;
+                for (int x = 0; x < width; x++) {
+                    auto index = k.index.data() + x * k.taps;
+                    auto weight = k.weight.data() + x * k.taps;
+#ifdef GFT_IMAGE_SSE2
+                    auto sum = _mm_set1_epi32(1 << (shift - 1));
+                    for (int t = 0; t < k.taps; t += 2) {
+                        auto a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(acc + index[t] * 4));
+                        auto b = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(acc + index[t + 1] * 4));
+                        std::int32_t pair;
+                        std::memcpy(&pair, weight + t, 4);
+                        sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), _mm_set1_epi32(pair)));
+                    }
+                    sum = _mm_srai_epi32(sum, shift);
+                    sum = _mm_packus_epi16(_mm_packs_epi32(sum, sum), sum);
+                    auto pixel = _mm_cvtsi128_si32(sum);
+                    std::memcpy(dst + x * 4, &pixel, 4);
+#else
+                    for (int i = 0; i < 4; i++) {
+                        std::int32_t sum = 1 << (shift - 1);
+                        for (int t = 0; t < k.taps; t++)
+                            sum += acc[index[t] * 4 + i] * weight[t];
+                        dst[x * 4 + i] = static_cast<std::uint8_t>(std::clamp(sum >> shift, 0, 255));
+                    }
+#endif
+                }
+            }
+            /// @brief 可分离的二维重采样
+            /// @details 每个目标行先纵向累加所需的源行，再横向采样，不需要整幅的中间图像，各行可以独立计算
+            void separable(ConstPixelView src, PixelView dst, const Kernel& horizontal, const Kernel& vertical,
+                ThreadPool& pool) {
+                forRows(dst.height(), pool, [&](int y) {
+                    thread_local std::vector<std::int16_t> acc;
+                    thread_local std::vector<const std::uint8_t*> rows;
+                    acc.resize(std::size_t(src.width()) * 4);
+                    rows.clear();
+                    for (int t = 0; t < vertical.taps; t++)
+                        rows.push_back(src.row(vertical.index[y * vertical.taps + t]));
+                    accumulateRows(acc.data(), rows.data(), vertical.weight.data() + y * vertical.taps,
+                        vertical.taps, src.width());
+                    resampleRow(acc.data(), dst.row(y), dst.width(), horizontal);
+                });
+            }
+        }
+
+        void premultiply(PixelView image, ThreadPool& pool) {
+            requireColor(image);
+            forRows(image.height(), pool, [&](int y) { premultiplyRow(image.row(y), image.width()); });
+        }
+        void unpremultiply(PixelView image, ThreadPool& pool) {
+            requireColor(image);
+            forRows(image.height(), pool, [&](int y) { unpremultiplyRow(image.row(y), image.width()); });
+        }
+        void blend(PixelView dst, ConstPixelView src, int opacity, ThreadPool& pool) {
+            requireColor(dst);
+            requireSameSize(dst, src);
+            if (src.format() != dst.format())
+                throw std::invalid_argument("Image formats do not match");
+            opacity = std::clamp(opacity, 0, 255);
+            if (opacity == 0)
+                return;
+            forRows(dst.height(), pool, [&](int y) { blendRow(dst.row(y), src.row(y), dst.width(), opacity); });
+        }
+        void removeColorKey(PixelView image, const Color& key, int tolerance, ThreadPool& pool) {
+            requireColor(image);
+            std::uint32_t k = image.format() == PixelFormat::BGRA8
+                ? key.blue() | key.green() << 8 | key.red() << 16
+                : key.red() | key.green() << 8 | key.blue() << 16;
+            tolerance = std::clamp(tolerance, 0, 255);
+            forRows(image.height(), pool, [&](int y) { colorKeyRow(image.row(y), image.width(), k, tolerance); });
+        }
+        void convert(ConstPixelView src, PixelView dst, ThreadPool& pool) {
+            requireSameSize(src, dst);
+            if (src.format() == dst.format()) {
+                auto bytes = static_cast<std::size_t>(src.width()) * src.bytesPerPixel();
+                forRows(src.height(), pool, [&](int y) { std::memmove(dst.row(y), src.row(y), bytes); });
+            }
+            else if (src.format() == PixelFormat::Gray8)
+                forRows(src.height(), pool, [&](int y) { expandGrayRow(src.row(y), dst.row(y), src.width()); });
+            else if (dst.format() == PixelFormat::Gray8) {
+                static constexpr int bgra[3] = { 29, 150, 77 }, rgba[3] = { 77, 150, 29 };
+                auto& w = src.format() == PixelFormat::BGRA8 ? bgra : rgba;
+                forRows(src.height(), pool, [&](int y) { grayRow(src.row(y), dst.row(y), src.width(), w); });
+            }
+            else
+                forRows(src.height(), pool, [&](int y) { swapRow(src.row(y), dst.row(y), src.width()); });
+        }
+        void resize(ConstPixelView src, PixelView dst, Filter filter, ThreadPool& pool) {
+            requireColor(dst);
+            if (src.format() != dst.format())
+                throw std::invalid_argument("Image formats do not match");
+            if (dst.empty())
+                return;
+            if (src.empty())
+                throw std::invalid_argument("Source image is empty");
+            auto make = filter == Filter::Box ? boxKernel : bilinearKernel;
+            separable(src, dst, make(src.width(), dst.width()), make(src.height(), dst.height()), pool);
+        }
+        void gaussianBlur(ConstPixelView src, PixelView dst, float sigma, ThreadPool& pool) {
+            requireColor(dst);
+            requireSameSize(src, dst);
+            if (src.format() != dst.format())
+                throw std::invalid_argument("Image formats do not match");
+            if (sigma <= 0) {
+                convert(src, dst, pool);
+                return;
+            }
+            if (dst.empty())
+                return;
+            separable(src, dst, gaussianKernel(src.width(), sigma), gaussianKernel(src.height(), sigma), pool);
+        }
+        void gaussianBlur(PixelView image, float sigma, ThreadPool& pool) {
+            requireColor(image);
+            if (sigma <= 0 || image.empty())
+                return;
+            auto bytes = static_cast<std::size_t>(image.width()) * 4;
+            std::vector<std::uint8_t> copy(bytes * image.height());
+            ConstPixelView source(copy.data(), image.width(), image.height(), static_cast<std::ptrdiff_t>(bytes), image.format());
+            forRows(image.height(), pool, [&](int y) { std::memcpy(copy.data() + bytes * y, image.row(y), bytes); });
+            gaussianBlur(source, image, sigma, pool);
+        }
+    }
+}
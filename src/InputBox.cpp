@@ -12,12 +12,14 @@ namespace GFt {
         InputBox::~InputBox() = default;
         void InputBox::setPlaceholder(const std::wstring& placeholder) {
             this->placeholder_ = placeholder;
+            markDirty();
         }
         void InputBox::setMaxInputLength(unsigned int max_length) {
             this->max_length_ = max_length;
         }
         void InputBox::setContent(const std::wstring& content) {
             this->content_ = content;
+            markDirty();
         }
         const std::wstring& InputBox::getContent() const {
             return this->content_;
@@ -30,6 +32,7 @@ namespace GFt {
         }
         void InputBox::clearContent() {
             this->content_.clear();
+            markDirty();
         }
         void InputBox::onDraw(Graphics& g) {
             static PenSet border{ Color{230,230,230} };
@@ -57,6 +60,7 @@ namespace GFt {
         }
         void InputBox::onTextInput(TextInputEvent* event) {
             if (!event) return;
+            markDirty();
             wchar_t ch = (wchar_t)event->character();
             switch (ch) {
             case L'\b':
@@ -22,14 +22,14 @@ namespace GFt {
         Label::Label(const iRect& rect, Block* parent, int zIndex) 
             : Label(L"", rect, parent, zIndex) {}
 
-        std::wstring& Label::text() { return text_; }
-        BrushSet& Label::brushSet() { return brushSet_; }
-        TextSet& Label::textSet() { return textSet_; }
-        int& Label::leftPadding() { return leftPadding_; }
-        int& Label::topPadding() { return topPadding_; }
-        int& Label::rightPadding() { return rightPadding_; }
-        int& Label::bottomPadding() { return bottomPadding_; }
-        int& Label::textAlignment() { return textAlignment_; }
+        std::wstring& Label::text() { markDirty(); return text_; }
+        BrushSet& Label::brushSet() { markDirty(); return brushSet_; }
+        TextSet& Label::textSet() { markDirty(); return textSet_; }
+        int& Label::leftPadding() { markDirty(); return leftPadding_; }
+        int& Label::topPadding() { markDirty(); return topPadding_; }
+        int& Label::rightPadding() { markDirty(); return rightPadding_; }
+        int& Label::bottomPadding() { markDirty(); return bottomPadding_; }
+        int& Label::textAlignment() { markDirty(); return textAlignment_; }
 
         const std::wstring& Label::text() const { return text_; }
         const BrushSet& Label::brushSet() const { return brushSet_; }
@@ -45,18 +45,21 @@ namespace GFt {
             topPadding_ = padding;
             rightPadding_ = padding;
             bottomPadding_ = padding;
+            markDirty();
         }
         void Label::setPadding(int leftRight, int topBottom) {
             leftPadding_ = leftRight;
             topPadding_ = topBottom;
             rightPadding_ = leftRight;
             bottomPadding_ = topBottom;
+            markDirty();
         }
         void Label::setPadding(int left, int right, int top, int bottom) {
             leftPadding_ = left;
             topPadding_ = top;
             rightPadding_ = right;
             bottomPadding_ = bottom;
+            markDirty();
         }
     }
 }
\ No newline at end of file
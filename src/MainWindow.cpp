@@ -30,7 +30,12 @@ namespace GFt {
             onToggled(state);
         }
     public:
-        CtrlBtn(const iRect& rect, Block* parent) : Block(rect, parent) {}
+        CtrlBtn(const iRect& rect, Block* parent) : Block(rect, parent) {
+            // 悬停与按下状态影响绘制结果
+            HoverOn.connect([this](Block*) { markDirty(); });
+            HoverOff.connect([this](Block*) { markDirty(); });
+            onToggled.connect([this](bool) { markDirty(); });
+        }
         Signal<bool> onToggled;
     };
     // 最小化按钮
@@ -197,6 +202,7 @@ namespace GFt {
                 Window::window()->moveTo(
                     current_ + (Sys::getCursorPosition() - drag_pos_)
                 );
+                Application::requestFrame();
             }
             else {
                 current_ = iPoint{};
@@ -234,6 +240,7 @@ namespace GFt {
 
         void setTitle(const std::wstring& title) {
             title_ = title;
+            markDirty();
         }
     };
     /// @endcond
@@ -266,6 +273,8 @@ namespace GFt {
             layout->addItem(miniBtn, Layout::Fixed);
             layout->addItem(maxiBtn, Layout::Fixed);
             layout->addItem(closeBtn, Layout::Fixed);
+            // 标题栏只在悬停、按下或修改标题时改变，缓存后平时只需复制一次位图
+            layout->setCacheMode(CacheMode::Cached);
             // 保存指针
             layout_ = layout;
             label_ = titleLabel;
@@ -1,10 +1,162 @@
 #include "GraceFt/Path.h"
 
+#ifdef GFT_HEADLESS
+#include <_private_draw.inl>
+#include <algorithm>
+#include <limits>
+#else
 #include <ege.h>
+#endif
 
+#ifdef GFT_HEADLESS
+#define PATH(x) (static_cast<_GFt_private_::_PathData*>(x))
+#else
 #define PATH(x) (static_cast<ege::ege_path*>(x))
+#endif
 
 namespace GFt {
+#ifdef GFT_HEADLESS
+    using namespace _GFt_private_;
+    namespace {
+        /// @brief 获取可以继续追加的子路径，没有时开始新的子路径
+        std::vector<fPoint>& openFigure(_PathData* path) {
+            if (!path->open || path->figures.empty())
+                path->figures.emplace_back();
+            path->open = true;
+            return path->figures.back().points;
+        }
+        /// @brief 添加一个闭合的子路径，之后的图元开始新的子路径
+        std::vector<fPoint>& closedFigure(_PathData* path) {
+            path->figures.emplace_back().closed = true;
+            path->open = false;
+            return path->figures.back().points;
+        }
+        fPoint transformed(const fPoint& p, const fMat3x3& m) {
+            return fPoint(p.x() * m[0][0] + p.y() * m[1][0] + m[2][0], p.x() * m[0][1] + p.y() * m[1][1] + m[2][1]);
+        }
+    }
+    /// @details 无窗口构建中曲线在加入时即被展开为折线，文字不会被加入路径
+    Path::Path() { data_ = new _PathData; }
+    Path::Path(const Path& other) { data_ = new _PathData(*PATH(other.data_)); }
+    Path::Path(Path&& other) {
+        data_ = other.data_;
+        other.data_ = nullptr;
+    }
+    Path& Path::operator=(const Path& other) {
+        if (this != &other)
+            *PATH(data_) = *PATH(other.data_);
+        return *this;
+    }
+    Path& Path::operator=(Path&& other) {
+        if (this == &other)
+            return *this;
+        delete PATH(data_);
+        data_ = other.data_;
+        other.data_ = nullptr;
+        return *this;
+    }
+    Path::~Path() {
+        delete PATH(data_);
+        data_ = nullptr;
+    }
+    void Path::start() { PATH(data_)->open = false; }
+    void Path::close() {
+        if (PATH(data_)->open && !PATH(data_)->figures.empty())
+            PATH(data_)->figures.back().closed = true;
+        PATH(data_)->open = false;
+    }
+    void Path::closeAll() {
+        for (auto& figure : PATH(data_)->figures)
+            figure.closed = true;
+        PATH(data_)->open = false;
+    }
+    void Path::reset() { *PATH(data_) = _PathData(); }
+    void Path::reverse() {
+        auto& figures = PATH(data_)->figures;
+        std::reverse(figures.begin(), figures.end());
+        for (auto& figure : figures)
+            std::reverse(figure.points.begin(), figure.points.end());
+    }
+    void Path::outline() {}
+    fPoint Path::getLastPoint() const {
+        for (auto figure = PATH(data_)->figures.rbegin(); figure != PATH(data_)->figures.rend(); ++figure)
+            if (!figure->points.empty())
+                return figure->points.back();
+        return fPoint();
+    }
+    int Path::count() const {
+        int count = 0;
+        for (auto& figure : PATH(data_)->figures)
+            count += static_cast<int>(figure.points.size());
+        return count;
+    }
+    fRect Path::getBounds(const fMat3x3& transform) const {
+        float left = std::numeric_limits<float>::max(), top = left;
+        float right = std::numeric_limits<float>::lowest(), bottom = right;
+        for (auto& figure : PATH(data_)->figures)
+            for (auto& point : figure.points) {
+                auto p = transformed(point, transform);
+                left = std::min(left, p.x()), top = std::min(top, p.y());
+                right = std::max(right, p.x()), bottom = std::max(bottom, p.y());
+            }
+        return left > right ? fRect() : fRect(left, top, right - left, bottom - top);
+    }
+    void Path::transformBy(const fMat3x3& transform) {
+        for (auto& figure : PATH(data_)->figures)
+            for (auto& point : figure.points)
+                point = transformed(point, transform);
+    }
+    void Path::addPath(const Path& other, bool connect) {
+        auto& figures = PATH(other.data_)->figures;
+        auto first = figures.begin();
+        if (connect && PATH(data_)->open && first != figures.end() && !first->closed) {
+            auto& points = openFigure(PATH(data_));
+            points.insert(points.end(), first->points.begin(), first->points.end());
+            ++first;
+        }
+        PATH(data_)->figures.insert(PATH(data_)->figures.end(), first, figures.end());
+        PATH(data_)->open = PATH(other.data_)->open;
+    }
+    void Path::addLine(const fLine& line) {
+        auto& points = openFigure(PATH(data_));
+        points.push_back(line.P1());
+        points.push_back(line.P2());
+    }
+    void Path::addArc(const fRect& rect, float startAngle, float sweepAngle) {
+        _append_arc(openFigure(PATH(data_)), fPoint(rect.x() + rect.width() / 2, rect.y() + rect.height() / 2),
+            rect.width() / 2, rect.height() / 2, startAngle, sweepAngle);
+    }
+    void Path::addCircle(const fCircle& circle) {
+        _append_arc(closedFigure(PATH(data_)), circle.origin(), circle.radius(), circle.radius(), 0, 360);
+    }
+    void Path::addRect(const fRect& rect) {
+        closedFigure(PATH(data_)).assign({ rect.position(), fPoint(rect.right(), rect.top()),
+            fPoint(rect.right(), rect.bottom()), fPoint(rect.left(), rect.bottom()) });
+    }
+    void Path::addEllipse(const fEllipse& ellipse) {
+        auto& r = ellipse.rect();
+        _append_arc(closedFigure(PATH(data_)), fPoint(r.x() + r.width() / 2, r.y() + r.height() / 2),
+            r.width() / 2, r.height() / 2, 0, 360);
+    }
+    void Path::addPie(const fRect& rect, float startAngle, float sweepAngle) {
+        fPoint center(rect.x() + rect.width() / 2, rect.y() + rect.height() / 2);
+        auto& points = closedFigure(PATH(data_));
+        points.push_back(center);
+        _append_arc(points, center, rect.width() / 2, rect.height() / 2, startAngle, sweepAngle);
+    }
+    void Path::addBezier(const fBezier& bezier) {
+        _append_bezier(openFigure(PATH(data_)), bezier.points.data(), bezier.points.size());
+    }
+    void Path::addFitCurve(const fFitCurve& fitCurve) {
+        auto& points = fitCurve.closed ? closedFigure(PATH(data_)) : openFigure(PATH(data_));
+        _append_curve(points, fitCurve.points.data(), fitCurve.points.size(), fitCurve.tension, fitCurve.closed);
+    }
+    void Path::addPolygon(const fPolygon& points) {
+        auto& figure = points.closed ? closedFigure(PATH(data_)) : openFigure(PATH(data_));
+        figure.insert(figure.end(), points.points.begin(), points.points.end());
+    }
+    void Path::addText(const std::wstring&, const fPoint&, const Font&) {}
+#else
     using namespace ege;
     Path::Path() {
         data_ = ege_path_create();
@@ -147,4 +299,5 @@ namespace GFt {
             text.c_str(), font.size(),
             text.length(), font.fontFamily().c_str(), fontstyle);
     }
-}
\ No newline at end of file
+#endif
+}
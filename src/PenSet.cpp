@@ -1,45 +1,53 @@
 #include "GraceFt/PenSet.h"
 
+#include <_private_draw.inl>
+#ifndef GFT_HEADLESS
 #include <ege.h>
-#include <_private.inl>
+#endif
+#include <utility>
 
 #define PEN(x) (static_cast<_GFt_private_::PenSetPrivate*>(x))
 
 namespace GFt {
+#ifdef GFT_HEADLESS
+    using namespace _GFt_private_;
+#else
     using namespace ege;
+#endif
     PenSet::PenSet(const Color& color, int width) {
         pen_ = new _GFt_private_::PenSetPrivate;
-        PEN(pen_)->color = EGERGBA(color.red(), color.green(), color.blue(), color.alpha());
+        PEN(pen_)->color = _GFt_private_::_pack_color(color);
         PEN(pen_)->width = width;
         PEN(pen_)->line_type = SOLID_LINE;
         PEN(pen_)->startcap_type = LINECAP_ROUND;
         PEN(pen_)->endcap_type = LINECAP_ROUND;
         PEN(pen_)->join_type = LINEJOIN_ROUND;
         PEN(pen_)->userdef = 0;
+        version_ = _GFt_private_::_next_state_version();
     }
     PenSet::PenSet(const PenSet& other) {
-        pen_ = new _GFt_private_::PenSetPrivate;
-        PEN(pen_)->width = PEN(other.pen_)->width;
-        PEN(pen_)->line_type = PEN(other.pen_)->line_type;
-        PEN(pen_)->userdef = PEN(other.pen_)->userdef;
+        pen_ = new _GFt_private_::PenSetPrivate(*PEN(other.pen_));
+        version_ = _GFt_private_::_next_state_version();
     }
     PenSet::PenSet(PenSet&& other) {
         pen_ = other.pen_;
         other.pen_ = nullptr;
+        version_ = std::exchange(other.version_, _GFt_private_::_next_state_version());
     }
     PenSet& PenSet::operator=(const PenSet& other) {
         if (this == &other)
             return *this;
-        PEN(pen_)->width = PEN(other.pen_)->width;
-        PEN(pen_)->line_type = PEN(other.pen_)->line_type;
-        PEN(pen_)->userdef = PEN(other.pen_)->userdef;
+        *PEN(pen_) = *PEN(other.pen_);
+        version_ = _GFt_private_::_next_state_version();
         return *this;
     }
     PenSet& PenSet::operator=(PenSet&& other) {
         if (this == &other)
-            delete PEN(pen_);
+            return *this;
+        delete PEN(pen_);
         pen_ = other.pen_;
         other.pen_ = nullptr;
+        version_ = std::exchange(other.version_, _GFt_private_::_next_state_version());
         return *this;
     }
     PenSet::~PenSet() {
@@ -48,12 +56,17 @@ namespace GFt {
     }
 
     void PenSet::setColor(const Color& color) {
-        PEN(pen_)->color = EGERGBA(color.red(), color.green(), color.blue(), color.alpha());
+        version_ = _GFt_private_::_next_state_version();
+        PEN(pen_)->color = _GFt_private_::_pack_color(color);
     }
 
-    void PenSet::setLineWidth(int width) { PEN(pen_)->width = width; }
+    void PenSet::setLineWidth(int width) {
+        PEN(pen_)->width = width;
+        version_ = _GFt_private_::_next_state_version();
+    }
     /// @details 此函数指定 LineStyle::UserDefined 是无效的
     void PenSet::setLineStyle(LineStyle style) {
+        version_ = _GFt_private_::_next_state_version();
         switch (style) {
         case LineStyle::Solid:
             PEN(pen_)->line_type = SOLID_LINE;
@@ -76,6 +89,7 @@ namespace GFt {
     }
     /// @details 调用此函数时, 会自动设置 LineStyle::UserDefined
     void PenSet::setLineStyle(short style) {
+        version_ = _GFt_private_::_next_state_version();
         PEN(pen_)->line_type = USERBIT_LINE;
         PEN(pen_)->userdef = style;
     }
@@ -84,6 +98,7 @@ namespace GFt {
         setEndCap(style);
     }
     void PenSet::setStartCap(CapStyle style) {
+        version_ = _GFt_private_::_next_state_version();
         switch (style) {
         case CapStyle::Flat:
             PEN(pen_)->startcap_type = LINECAP_FLAT;
@@ -99,6 +114,7 @@ namespace GFt {
         }
     }
     void GFt::PenSet::setEndCap(CapStyle style) {
+        version_ = _GFt_private_::_next_state_version();
         switch (style) {
         case CapStyle::Flat:
             PEN(pen_)->endcap_type = LINECAP_FLAT;
@@ -114,6 +130,7 @@ namespace GFt {
         }
     }
     void PenSet::setJoinStyle(JoinStyle style, float miterLimit) {
+        version_ = _GFt_private_::_next_state_version();
         switch (style) {
         case JoinStyle::Miter:
             PEN(pen_)->join_type = LINEJOIN_MITER;
@@ -130,12 +147,7 @@ namespace GFt {
         PEN(pen_)->miterlimit = miterLimit;
     }
     Color PenSet::getColor() const {
-        return Color(
-            EGEGET_R(PEN(pen_)->color),
-            EGEGET_G(PEN(pen_)->color),
-            EGEGET_B(PEN(pen_)->color),
-            EGEGET_A(PEN(pen_)->color)
-        );
+        return _GFt_private_::_unpack_color(PEN(pen_)->color);
     }
     int PenSet::getPenWidth() const {
         return PEN(pen_)->width;
@@ -189,6 +201,7 @@ namespace GFt {
         }
         return CapStyle::Round;
     }
+    std::uint64_t PenSet::version() const { return version_; }
     JoinStyle PenSet::getJoinStyle() const {
         switch (PEN(pen_)->join_type) {
         case LINEJOIN_MITER:
@@ -1,58 +1,257 @@
 #include "GraceFt/PixelMap.h"
+#include <_private_draw.inl>
 
+#include <algorithm>
+#include <stdexcept>
+#include <iterator>
+#include <utility>
+#ifdef GFT_HEADLESS
+#include <filesystem>
+#include <fstream>
+#include <GraceFt/Backend.h>
+#else
 #include <ege.h>
-#include <exception>
+#endif
 
-#define IMG(x) (static_cast<PIMAGE>(x))
+#ifdef GFT_HEADLESS
+#define IMG(x) (static_cast<_GFt_private_::_Image*>(x))
+#else
+#define IMG(x) (static_cast<ege::PIMAGE>(x))
+#endif
 
 namespace GFt {
+#ifndef GFT_HEADLESS
     using namespace ege;
+#endif
+    namespace {
+#ifdef GFT_HEADLESS
+        void* newImage(int width = 0, int height = 0) {
+            auto img = new _GFt_private_::_Image;
+            img->width = width;
+            img->height = height;
+            img->pixels.assign(static_cast<std::size_t>(width) * height, img->background);
+            img->viewport = iRect(0, 0, width, height);
+            return img;
+        }
+        void deleteImage(void* image) { delete IMG(image); }
+        int widthOf(const void* image) { return IMG(const_cast<void*>(image))->width; }
+        int heightOf(const void* image) { return IMG(const_cast<void*>(image))->height; }
+        std::uint32_t* bufferOf(const void* image) { return IMG(const_cast<void*>(image))->pixels.data(); }
+        void putPixels(void* dst, int x, int y, int width, int height, const void* src, int srcX, int srcY) {
+            auto w = std::min({ width, widthOf(dst) - x, widthOf(src) - srcX });
+            auto h = std::min({ height, heightOf(dst) - y, heightOf(src) - srcY });
+            for (int row = 0; row < h; row++)
+                std::copy_n(bufferOf(src) + (srcY + row) * widthOf(src) + srcX, std::max(w, 0),
+                    bufferOf(dst) + (y + row) * widthOf(dst) + x);
+        }
+        /// @brief 读写 BMP 文件时使用的小端整数
+        template<typename T>
+        void writeLE(std::ostream& out, T value) {
+            for (std::size_t i = 0; i < sizeof(T); i++)
+                out.put(static_cast<char>((static_cast<std::uint64_t>(value) >> (i * 8)) & 0xff));
+        }
+        template<typename T>
+        T readLE(std::istream& in) {
+            std::uint64_t value = 0;
+            for (std::size_t i = 0; i < sizeof(T); i++)
+                value |= static_cast<std::uint64_t>(static_cast<unsigned char>(in.get())) << (i * 8);
+            return static_cast<T>(value);
+        }
+#else
+        void* newImage() { return newimage(); }
+        void* newImage(int width, int height) { return newimage(width, height); }
+        void deleteImage(void* image) { delimage(IMG(image)); }
+        int widthOf(const void* image) { return getwidth(IMG(const_cast<void*>(image))); }
+        int heightOf(const void* image) { return getheight(IMG(const_cast<void*>(image))); }
+        std::uint32_t* bufferOf(const void* image) {
+            return reinterpret_cast<std::uint32_t*>(getbuffer(IMG(const_cast<void*>(image))));
+        }
+#endif
+        void* copyImage(const void* source) {
+            auto img = newImage(widthOf(source), heightOf(source));
+            std::copy_n(bufferOf(source), widthOf(source) * heightOf(source), bufferOf(img));
+            return img;
+        }
+    }
+}
+namespace _GFt_private_ {
+#ifdef GFT_HEADLESS
+    void _set_viewport(void* image, const GFt::iRect& viewport) {
+        if (!image)
+            return;
+        IMG(image)->viewport = viewport;
+        IMG(image)->clip = false;
+    }
+    void _clear_image(void* image) {
+        if (image)
+            std::fill(IMG(image)->pixels.begin(), IMG(image)->pixels.end(), IMG(image)->background);
+    }
+#else
+    void _set_viewport(void* image, const GFt::iRect& viewport) {
+        ege::setviewport(viewport.left(), viewport.top(), viewport.right(), viewport.bottom(), 0, IMG(image));
+    }
+    void _clear_image(void* image) { ege::cleardevice(IMG(image)); }
+#endif
+}
+namespace GFt {
     PixelMap::PixelMap(const iSize& size) {
-        if (!size)
-            pixmap_ = newimage();
-        else
-            pixmap_ = newimage(size.width(), size.height());
+        adopt(size ? newImage(size.width(), size.height()) : newImage());
     }
+    /// @details 作为绘图目标或交出过可写视图的位图之后还会被写入，不能共享像素
     PixelMap::PixelMap(const PixelMap& other) {
-        auto img = newimage();
-        resize(img, getwidth(IMG(other.pixmap_)), getheight(IMG(other.pixmap_)));
-        putimage(img, 0, 0, IMG(other.pixmap_));
-        pixmap_ = img;
+        if (other.painters_ > 0 || other.viewed_) {
+            adopt(copyImage(other.pixmap_));
+            return;
+        }
+        pixmap_ = other.pixmap_;
+        image_ = other.image_;
+        std::copy(std::begin(other.bound_), std::end(other.bound_), bound_);
     }
     PixelMap& PixelMap::operator=(const PixelMap& other) {
         if (this == &other)
             return *this;
-        auto img = newimage();
-        resize(img, getwidth(IMG(other.pixmap_)), getheight(IMG(other.pixmap_)));
-        putimage(img, 0, 0, IMG(other.pixmap_));
-        pixmap_ = img;
+        if (other.painters_ > 0 || other.viewed_)
+            adopt(copyImage(other.pixmap_));
+        else {
+            pixmap_ = other.pixmap_;
+            image_ = other.image_;
+            viewed_ = false;
+            std::copy(std::begin(other.bound_), std::end(other.bound_), bound_);
+        }
+        if (painters_ > 0)
+            detach();
         return *this;
     }
+    /// @details 以此位图为目标的 Graphics 仍指向此对象，因此 painters_ 不随像素转移
     PixelMap::PixelMap(PixelMap&& other) {
         pixmap_ = other.pixmap_;
         other.pixmap_ = nullptr;
+        image_ = std::move(other.image_);
+        viewed_ = std::exchange(other.viewed_, false);
+        std::copy(std::begin(other.bound_), std::end(other.bound_), bound_);
     }
     PixelMap& PixelMap::operator=(PixelMap&& other) {
         if (this == &other)
             return *this;
         pixmap_ = other.pixmap_;
         other.pixmap_ = nullptr;
+        image_ = std::move(other.image_);
+        viewed_ = std::exchange(other.viewed_, false);
+        std::copy(std::begin(other.bound_), std::end(other.bound_), bound_);
+        if (painters_ > 0)
+            detach();
         return *this;
     }
     PixelMap::~PixelMap() {
-        if (pixmap_)
-            delimage(IMG(pixmap_));
         pixmap_ = nullptr;
     }
+    void PixelMap::adopt(void* image) {
+        pixmap_ = image;
+        image_ = std::shared_ptr<void>(image, deleteImage);
+        viewed_ = false;
+        std::fill(std::begin(bound_), std::end(bound_), 0);
+    }
+    /// @details 复制出的图像不带有 EGE 的绘图状态，因此同时清除记录的绑定版本
+    void PixelMap::detach() {
+        if (image_.use_count() > 1)
+            adopt(copyImage(pixmap_));
+    }
+    bool PixelMap::isShared() const { return image_.use_count() > 1; }
     PixelMap PixelMap::clip(const iRect& rect) const {
         PixelMap result(rect.size());
+#ifdef GFT_HEADLESS
+        auto left = std::max(rect.x(), 0), top = std::max(rect.y(), 0);
+        putPixels(result.pixmap_, left - rect.x(), top - rect.y(), rect.right() - left, rect.bottom() - top,
+            pixmap_, left, top);
+#else
         putimage(IMG(result.pixmap_), 0, 0, rect.width(), rect.height(), IMG(pixmap_), rect.x(), rect.y());
+#endif
         return result;
     }
     iSize PixelMap::size() const {
-        return iSize(getwidth(IMG(pixmap_)), getheight(IMG(pixmap_)));
+        return iSize(widthOf(pixmap_), heightOf(pixmap_));
+    }
+    PixelView PixelMap::view() {
+        detach();
+        viewed_ = true;
+        return PixelView(reinterpret_cast<std::uint8_t*>(bufferOf(pixmap_)), widthOf(pixmap_), heightOf(pixmap_),
+            static_cast<std::ptrdiff_t>(widthOf(pixmap_)) * 4);
+    }
+    ConstPixelView PixelMap::view() const {
+        return ConstPixelView(reinterpret_cast<const std::uint8_t*>(bufferOf(pixmap_)), widthOf(pixmap_),
+            heightOf(pixmap_), static_cast<std::ptrdiff_t>(widthOf(pixmap_)) * 4);
+    }
+    PixelView PixelMap::view(const iRect& rect) { return view().sub(rect); }
+    ConstPixelView PixelMap::view(const iRect& rect) const { return view().sub(rect); }
+#ifdef GFT_HEADLESS
+    void PixelMap::setAlpha(int alpha) {
+        detach();
+        for (auto& pixel : IMG(pixmap_)->pixels)
+            pixel = (pixel & 0xffffff) | static_cast<std::uint32_t>(alpha & 0xff) << 24;
+    }
+    /// @details 无窗口构建中总是保存为 32 位 BMP 文件，不保存 Alpha 通道时透明度被置为 255
+    void PixelMap::saveToFile(const std::wstring& filename, bool withAlpha) const {
+        std::ofstream out(std::filesystem::path(filename), std::ios::binary);
+        int width = widthOf(pixmap_), height = heightOf(pixmap_);
+        std::uint32_t bytes = static_cast<std::uint32_t>(width) * height * 4;
+        out.put('B').put('M');
+        writeLE<std::uint32_t>(out, 54 + bytes);
+        writeLE<std::uint32_t>(out, 0);
+        writeLE<std::uint32_t>(out, 54);
+        writeLE<std::uint32_t>(out, 40);
+        writeLE<std::int32_t>(out, width);
+        writeLE<std::int32_t>(out, -height);    // 自上而下存储
+        writeLE<std::uint16_t>(out, 1);
+        writeLE<std::uint16_t>(out, 32);
+        for (int i = 0; i < 6; i++)
+            writeLE<std::uint32_t>(out, i == 1 ? bytes : 0);
+        for (int i = 0; i < width * height; i++)
+            writeLE<std::uint32_t>(out, bufferOf(pixmap_)[i] | (withAlpha ? 0 : 0xff000000));
+        if (!out)
+            throw std::runtime_error("Failed to save image");
+    }
+    /// @details 无窗口构建中只支持未压缩的 24 位与 32 位 BMP 文件
+    PixelMap PixelMap::loadFromFile(const std::wstring& filename) {
+        std::ifstream in(std::filesystem::path(filename), std::ios::binary);
+        if (!in)
+            throw std::runtime_error("File not found");
+        if (in.get() != 'B' || in.get() != 'M')
+            throw std::runtime_error("Unknown error");
+        in.ignore(8);
+        auto offset = readLE<std::uint32_t>(in);
+        in.ignore(4);
+        auto width = readLE<std::int32_t>(in), height = readLE<std::int32_t>(in);
+        in.ignore(2);
+        auto bits = readLE<std::uint16_t>(in);
+        auto compression = readLE<std::uint32_t>(in);
+        if (!in || width <= 0 || height == 0 || (bits != 24 && bits != 32) || compression != 0)
+            throw std::runtime_error("Unknown error");
+        PixelMap result(iSize(width, std::abs(height)));
+        auto pixels = bufferOf(result.pixmap_);
+        auto stride = (width * bits / 8 + 3) / 4 * 4;
+        std::vector<unsigned char> row(stride);
+        in.seekg(offset);
+        for (int y = 0; y < std::abs(height); y++) {
+            if (!in.read(reinterpret_cast<char*>(row.data()), stride))
+                throw std::runtime_error("Read failed");
+            auto dst = pixels + (height > 0 ? std::abs(height) - 1 - y : y) * width;
+            for (int x = 0; x < width; x++) {
+                auto p = row.data() + x * bits / 8;
+                dst[x] = (bits == 32 ? p[3] : 0xffu) << 24 | p[2] << 16 | p[1] << 8 | p[0];
+            }
+        }
+        return result;
+    }
+    /// @details 无窗口构建中从后端提供的屏幕复制
+    PixelMap PixelMap::loadFromWindow(const iRect& rect) {
+        auto screen = Backend::instance().screen();
+        if (!screen)
+            throw std::runtime_error("Read failed");
+        return screen->clip(rect);
     }
+#else
     void PixelMap::setAlpha(int alpha) {
+        detach();
         ege_setalpha(alpha, IMG(pixmap_));
     }
     void PixelMap::saveToFile(const std::wstring& filename, bool withAlpha) const {
@@ -90,4 +289,5 @@ namespace GFt {
             throw std::runtime_error("Unknown error");
         }
     }
-}
\ No newline at end of file
+#endif
+}
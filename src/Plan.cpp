@@ -1,72 +1,169 @@
 #include "GraceFt/Plan.h"
 #include <GraceFt/Application.h>
+#include <algorithm>
 
 namespace GFt {
     std::size_t PlanEvent::nextId_ = 0;
+    /// @details 同一帧内依次执行立即事件、到期的延时事件与满足条件的条件事件
+    /// @details 执行后若仍有待执行的事件或条件则请求下一帧，否则请求在最近的定时器到期时唤醒
     void PlanEvent::executePlanEvents() {
-        std::unordered_map<std::size_t, PlanFunc> calls;
-        calls.swap(planEvents_);
-        planEvents_.clear();
-        for (auto& [_, planEvent] : calls)
-            planEvent();
+        auto start = Clock::now();
+        executeQueued(start);
+        executeTimers(Clock::now());
+        executeConditions();
+        bool pending = !condEvents_.empty() || std::any_of(planEvents_.begin(), planEvents_.end(),
+            [](const auto& queue) { return !queue.empty(); });
+        if (pending)
+            Application::requestFrame();
+        else if (!timers_.empty())
+            Application::requestFrame(timers_.top().deadline);
+    }
+    /// @details 只执行帧开始时已在队列中的事件，执行期间新添加的事件留到下一帧；
+    ///          被移除的事件仅置空，在出队时跳过
+    void PlanEvent::executeQueued(Clock::time_point start) {
+        std::array<std::size_t, 4> counts;
+        for (std::size_t i = 0; i < counts.size(); ++i)
+            counts[i] = planEvents_[i].size();
+        auto limited = frameBudget_ > Clock::duration::zero();
+        auto exhausted = [&] { return limited && Clock::now() - start >= frameBudget_; };
+        bool executed = false;
+        auto runFront = [&](auto& queue) {
+            auto func = std::move(queue.front().second);
+            queue.pop_front();
+            if (!func)
+                return;
+            func();
+            executed = true;
+        };
+        auto& high = planEvents_[static_cast<std::size_t>(Priority::High)];
+        for (auto n = counts[0]; n > 0; --n)
+            runFront(high);
+        executed = false;
+        for (auto priority : { Priority::Normal, Priority::Low }) {
+            auto index = static_cast<std::size_t>(priority);
+            auto& queue = planEvents_[index];
+            // 每帧至少执行一个事件，避免预算过小时事件永远无法执行
+            for (; counts[index] > 0; --counts[index]) {
+                if (executed && exhausted())
+                    return;
+                runFront(queue);
+            }
+        }
+        auto& idle = planEvents_[static_cast<std::size_t>(Priority::Idle)];
+        for (auto n = counts[3]; n > 0 && !exhausted(); --n)
+            runFront(idle);
+    }
+    /// @details 已被移除的定时器不会从堆中立即删除，而是在到期时被跳过
+    void PlanEvent::executeTimers(Clock::time_point now) {
+        while (!timers_.empty() && timers_.top().deadline <= now) {
+            auto timer = timers_.top();
+            timers_.pop();
+            auto iter = timedEvents_.find(timer.id);
+            if (iter == timedEvents_.end())
+                continue;
+            PlanFunc func;
+            if (iter->second.interval == Clock::duration::zero()) {
+                func = std::move(iter->second.func);
+                timedEvents_.erase(iter);
+            }
+            else {
+                // 函数执行期间可能会移除自身，因此执行副本
+                func = iter->second.func;
+                auto next = timer.deadline + iter->second.interval;
+                timers_.push(Timer{ next > now ? next : now + iter->second.interval, timer.id });
+            }
+            func();
+        }
+    }
+    void PlanEvent::executeConditions() {
+        auto count = condEvents_.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            auto* event = condEvents_[i].get();
+            if (!event->func || !event->condition())
+                continue;
+            auto func = std::move(event->func);
+            event->func = nullptr;
+            func();
+        }
+        std::erase_if(condEvents_, [](const auto& event) { return !event->func; });
     }
 
     std::size_t PlanEvent::add(const PlanFunc& planEvent) {
-        return getInstance().addPlanEvent_(planEvent);
+        return getInstance().addPlanEvent_(planEvent, Priority::Normal);
+    }
+
+    std::size_t PlanEvent::add(const PlanFunc& planEvent, Priority priority) {
+        return getInstance().addPlanEvent_(planEvent, priority);
     }
 
-    std::size_t PlanEvent::addPlanEvent_(const PlanFunc& planEvent) {
-        planEvents_[nextId_] = planEvent;
+    std::size_t PlanEvent::addPlanEvent_(const PlanFunc& planEvent, Priority priority) {
+        planEvents_[static_cast<std::size_t>(priority)].emplace_back(nextId_, planEvent);
+        Application::requestFrame();
         return nextId_++;
     }
 
     std::size_t PlanEvent::addPlanEvent_(const std::function<bool()>& condition, const PlanFunc& planEvent) {
-        auto id = addPlanEvent_(planEvent);
-        remove(id);
-        std::function<void()>* func = new std::function<void()>();
-        *func = [=, this] {
-            condition()
-                ? planEvent(), delete func
-                : (void)getInstance().reAddPlanEvent_(id, *func);
-            };
-        return getInstance().reAddPlanEvent_(id, *func);
+        condEvents_.push_back(std::make_unique<CondEvent>(CondEvent{ nextId_, condition, planEvent }));
+        Application::requestFrame();
+        return nextId_++;
     }
 
-    std::size_t PlanEvent::reAddPlanEvent_(std::size_t id, const PlanFunc& planEvent) {
-        planEvents_[id] = planEvent;
-        return id;
+    std::size_t PlanEvent::addPlanEvent_(float after_ms, float interval_ms, const PlanFunc& planEvent) {
+        using namespace std::chrono;
+        auto delay = duration_cast<Clock::duration>(duration<float, std::milli>(after_ms));
+        auto interval = duration_cast<Clock::duration>(duration<float, std::milli>(interval_ms));
+        timedEvents_.emplace(nextId_, TimedEvent{ planEvent, interval });
+        timers_.push(Timer{ Clock::now() + delay, nextId_ });
+        Application::requestFrame(timers_.top().deadline);
+        return nextId_++;
     }
 
     void PlanEvent::removePlanEvent_(std::size_t id) {
-        planEvents_.erase(id);
-    }
-
-    std::size_t PlanEvent::addPlanEvent_(float after_ms, const PlanFunc& planEvent) {
-        auto delay = std::chrono::milliseconds(static_cast<int>(after_ms));
-        auto target = std::chrono::steady_clock::now() + delay;
-        std::size_t id = addPlanEvent_(planEvent);
-        remove(id);
-        std::function<void()>* func = new std::function<void()>();
-        *func = [=, this] {
-            std::chrono::steady_clock::now() >= target
-                ? planEvent(), delete func
-                : (void)getInstance().reAddPlanEvent_(id, *func);
-            };
-        return getInstance().reAddPlanEvent_(id, *func);
+        if (timedEvents_.erase(id))
+            return;
+        for (auto& queue : planEvents_) {
+            auto immediate = std::find_if(queue.begin(), queue.end(),
+                [id](const auto& event) { return event.first == id; });
+            if (immediate != queue.end()) {
+                immediate->second = nullptr;
+                return;
+            }
+        }
+        for (auto& event : condEvents_)
+            if (event->id == id)
+                event->func = nullptr;
     }
 
     std::size_t PlanEvent::add(float after, const PlanFunc& planEvent) {
-        return getInstance().addPlanEvent_(after, planEvent);
+        return getInstance().addPlanEvent_(after, 0.f, planEvent);
     }
 
     std::size_t PlanEvent::add(const std::function<bool()>& condition, const PlanFunc& planEvent) {
         return getInstance().addPlanEvent_(condition, planEvent);
     }
 
+    /// @note 间隔小于等于0时，事件会在每一帧执行一次
+    std::size_t PlanEvent::repeat(float interval, const PlanFunc& planEvent) {
+        // 零间隔用于表示一次性事件，这里以最小时长代替
+        constexpr float min_interval = 1e-6f;
+        return getInstance().addPlanEvent_(interval, std::max(interval, min_interval), planEvent);
+    }
+
     void PlanEvent::remove(std::size_t id) {
         getInstance().removePlanEvent_(id);
     }
 
+    void PlanEvent::setFrameBudget(float ms) {
+        using namespace std::chrono;
+        auto budget = duration_cast<Clock::duration>(duration<float, std::milli>(ms));
+        getInstance().frameBudget_ = std::max(budget, Clock::duration::zero());
+    }
+
+    float PlanEvent::getFrameBudget() {
+        using namespace std::chrono;
+        return duration<float, std::milli>(getInstance().frameBudget_).count();
+    }
+
     PlanEvent& PlanEvent::getInstance() {
         static PlanEvent instance;
         static bool initialized = false;
@@ -77,4 +174,4 @@ namespace GFt {
         return instance;
     }
 
-}
\ No newline at end of file
+}
@@ -63,13 +63,13 @@ namespace GFt {
             return manager_.getRadioBox() == this;
         }
 
-        std::wstring& RadioBox::text() { return text_; }
-        Font& RadioBox::hoverFont() { return hoverfont_; }
-        Font& RadioBox::normalFont() { return normalfont_; }
-        Font& RadioBox::selectedFont() { return selectedfont_; }
-        BrushSet& RadioBox::hoverBrush() { return hoverbs_; }
-        BrushSet& RadioBox::normalBrush() { return normalbs_; }
-        BrushSet& RadioBox::selectedBrush() { return selectedbs_; }
+        std::wstring& RadioBox::text() { markDirty(); return text_; }
+        Font& RadioBox::hoverFont() { markDirty(); return hoverfont_; }
+        Font& RadioBox::normalFont() { markDirty(); return normalfont_; }
+        Font& RadioBox::selectedFont() { markDirty(); return selectedfont_; }
+        BrushSet& RadioBox::hoverBrush() { markDirty(); return hoverbs_; }
+        BrushSet& RadioBox::normalBrush() { markDirty(); return normalbs_; }
+        BrushSet& RadioBox::selectedBrush() { markDirty(); return selectedbs_; }
 
         const std::wstring& RadioBox::text() const { return text_; }
         const Font& RadioBox::hoverFont() const { return hoverfont_; }
@@ -84,11 +84,13 @@ namespace GFt {
     void RadioManager::setRadioBox(Widget::RadioBox* radiobox) {
         if (radiobox_ == radiobox) return;
         if (radiobox_) {
+            radiobox_->markDirty();
             radiobox_->onUnchecked();
             radiobox_->onCheckChanged(false);
         }
         radiobox_ = radiobox;
         if (radiobox_) {
+            radiobox_->markDirty();
             radiobox_->onChecked();
             radiobox_->onCheckChanged(true);
         }
@@ -0,0 +1,300 @@
+#include "GraceFt/Rasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GFT_RASTER_SSE2
+#endif
+
+namespace GFt {
+    namespace {
+        /// @brief 覆盖率为 1、透明度为 255 时的混合系数
+        constexpr int opaque = 256;
+
+        /// @brief 以系数 a(0~256) 将颜色混合到单个像素上
+        /// @details 与 SSE2 版本逐位一致：(dst * (256 - a) + src * a) >> 8，透明度通道的 src 视为 255
+        inline void blendPixel(std::uint32_t& dst, std::uint32_t color, int a) {
+            auto src = color | 0xff000000u;
+            auto ia = opaque - a;
+            std::uint32_t result = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                auto d = (dst >> shift) & 0xff;
+                auto s = (src >> shift) & 0xff;
+                result |= ((d * ia + s * a) >> 8) << shift;
+            }
+            dst = result;
+        }
+        /// @brief 以恒定系数 a(0~256) 将颜色混合到一段像素上
+        void blendSpan(std::uint32_t* dst, int count, std::uint32_t color, int a) {
+            int i = 0;
+#ifdef GFT_RASTER_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color | 0xff000000u)), zero);
+            const __m128i sa = _mm_mullo_epi16(src, _mm_set1_epi16(static_cast<short>(a)));
+            const __m128i ia = _mm_set1_epi16(static_cast<short>(opaque - a));
+            // 每个通道的结果不超过 255 * 256，在 16 位无符号整数范围内
+            for (; i + 4 <= count; i += 4) {
+                auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+                auto lo = _mm_unpacklo_epi8(d, zero);
+                auto hi = _mm_unpackhi_epi8(d, zero);
+                lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, ia), sa), 8);
+                hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, ia), sa), 8);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+            }
+#endif
+            for (; i < count; i++)
+                blendPixel(dst[i], color, a);
+        }
+        /// @brief 以系数 a 绘制一段像素，完全不透明时直接填充
+        inline void paintSpan(std::uint32_t* dst, int count, std::uint32_t color, int a) {
+            if (count <= 0 || a <= 0)
+                return;
+            if (a >= opaque)
+                std::fill_n(dst, count, color | 0xff000000u);
+            else
+                blendSpan(dst, count, color, a);
+        }
+        /// @brief 由累加的有符号面积计算覆盖率
+        inline float coverage(float area, Rasterizer::FillRule rule) {
+            auto a = std::abs(area);
+            if (rule == Rasterizer::FillRule::NonZero)
+                return std::min(a, 1.0f);
+            a -= 2.0f * std::floor(a * 0.5f);
+            return a > 1.0f ? 2.0f - a : a;
+        }
+        /// @brief 将一行内的直线段扫过的有符号面积累加到该行的单元中
+        /// @details x 坐标已相对于填充区域的左边界并限制在 [0, width] 内；
+        ///          每个单元记录覆盖率相对于左侧单元的增量，从左到右累加即得到每个像素的覆盖率；
+        ///          被修改的单元记录在 touched 中
+        inline void accumulate(float* cells, std::vector<int>& touched, float xa, float xb, float d) {
+            auto x0 = std::min(xa, xb), x1 = std::max(xa, xb);
+            auto x0floor = std::floor(x0);
+            auto x0i = static_cast<int>(x0floor);
+            auto x1i = static_cast<int>(std::ceil(x1));
+            if (x1i <= x0i + 1) {
+                auto xmf = 0.5f * (xa + xb) - x0floor;
+                cells[x0i] += d - d * xmf;
+                cells[x0i + 1] += d * xmf;
+                touched.push_back(x0i);
+                touched.push_back(x0i + 1);
+                return;
+            }
+            auto s = 1.0f / (x1 - x0);
+            auto x0f = x0 - x0floor;
+            auto a0 = 0.5f * s * (1.0f - x0f) * (1.0f - x0f);
+            auto x1f = x1 - static_cast<float>(x1i) + 1.0f;
+            auto am = 0.5f * s * x1f * x1f;
+            cells[x0i] += d * a0;
+            if (x1i == x0i + 2)
+                cells[x0i + 1] += d * (1.0f - a0 - am);
+            else {
+                auto a1 = s * (1.5f - x0f);
+                cells[x0i + 1] += d * (a1 - a0);
+                for (int xi = x0i + 2; xi < x1i - 1; xi++)
+                    cells[xi] += d * s;
+                auto a2 = a1 + static_cast<float>(x1i - x0i - 3) * s;
+                cells[x1i - 1] += d * (1.0f - a2 - am);
+            }
+            cells[x1i] += d * am;
+            for (int xi = x0i; xi <= x1i; xi++)
+                touched.push_back(xi);
+        }
+        /// @brief 将直线段限制在 [0, width] 内后累加
+        /// @details 超出左右边界的部分按其在纵向上所占的比例变为位于边界上的竖直线段，
+        ///          不能直接限制端点的横坐标，否则线段的斜率改变，边界附近像素的覆盖率会出错
+        inline void accumulateClipped(float* cells, std::vector<int>& touched, float xa, float xb, float d, float width) {
+            auto lo = std::min(xa, xb), hi = std::max(xa, xb);
+            if (lo >= 0.0f && hi <= width)
+                return accumulate(cells, touched, xa, xb, d);
+            if (hi <= 0.0f || lo >= width || hi - lo <= 0.0f) {
+                auto x = std::clamp(xa, 0.0f, width);
+                return accumulate(cells, touched, x, x, d);
+            }
+            auto s = d / (hi - lo);
+            if (lo < 0.0f)
+                accumulate(cells, touched, 0.0f, 0.0f, -lo * s);
+            if (hi > width)
+                accumulate(cells, touched, width, width, (hi - width) * s);
+            accumulate(cells, touched, std::max(lo, 0.0f), std::min(hi, width), (std::min(hi, width) - std::max(lo, 0.0f)) * s);
+        }
+        inline std::uint32_t pack(const Color& color) {
+            return (static_cast<std::uint32_t>(color.alpha()) << 24) | (static_cast<std::uint32_t>(color.red()) << 16)
+                | (static_cast<std::uint32_t>(color.green()) << 8) | color.blue();
+        }
+    }
+
+    void Rasterizer::setTarget(std::uint32_t* pixels, int width, int height, int stride) {
+        pixels_ = pixels;
+        width_ = pixels ? width : 0;
+        height_ = pixels ? height : 0;
+        stride_ = stride;
+        clip_ = iRect(0, 0, width_, height_);
+    }
+    void Rasterizer::setClip(const iRect& clip) {
+        auto left = std::max(clip.left(), 0);
+        auto top = std::max(clip.top(), 0);
+        clip_ = iRect(left, top,
+            std::max(std::min(clip.right(), width_) - left, 0),
+            std::max(std::min(clip.bottom(), height_) - top, 0));
+    }
+    void Rasterizer::setAntiAliasing(bool enable) { antiAliasing_ = enable; }
+
+    void Rasterizer::reset() {
+        edges_.clear();
+        open_ = false;
+    }
+    void Rasterizer::moveTo(const fPoint& p) {
+        close();
+        start_ = current_ = p;
+        open_ = true;
+    }
+    void Rasterizer::lineTo(const fPoint& p) {
+        if (!open_)
+            return moveTo(p);
+        addEdge(current_, p);
+        current_ = p;
+    }
+    void Rasterizer::close() {
+        if (!open_)
+            return;
+        addEdge(current_, start_);
+        current_ = start_;
+        open_ = false;
+    }
+    void Rasterizer::addPolygon(const fPoint* points, std::size_t count) {
+        if (count < 3)
+            return;
+        moveTo(points[0]);
+        for (std::size_t i = 1; i < count; i++)
+            lineTo(points[i]);
+        close();
+    }
+    /// @details 水平的边不影响覆盖率，直接忽略
+    void Rasterizer::addEdge(const fPoint& from, const fPoint& to) {
+        if (!(from.y() != to.y()) || !std::isfinite(from.x() + from.y() + to.x() + to.y()))
+            return;
+        Edge edge;
+        if (from.y() < to.y())
+            edge = Edge{ from.x(), from.y(), to.x(), to.y(), 0.0f, 1.0f };
+        else
+            edge = Edge{ to.x(), to.y(), from.x(), from.y(), 0.0f, -1.0f };
+        edge.dxdy = (edge.x1 - edge.x0) / (edge.y1 - edge.y0);
+        edges_.push_back(edge);
+    }
+
+    /// @details 未闭合的子路径会被自动闭合
+    void Rasterizer::fill(const Color& color, FillRule rule) {
+        close();
+        if (edges_.empty() || color.alpha() == 0 || clip_.width() <= 0 || clip_.height() <= 0)
+            return;
+        // 按上端排序后逐行维护与该行相交的边
+        std::sort(edges_.begin(), edges_.end(), [](const Edge& a, const Edge& b) { return a.y0 < b.y0; });
+        auto minX = edges_[0].x0, maxX = minX, maxY = edges_[0].y1;
+        for (auto& e : edges_) {
+            minX = std::min({ minX, e.x0, e.x1 });
+            maxX = std::max({ maxX, e.x0, e.x1 });
+            maxY = std::max(maxY, e.y1);
+        }
+        auto left = std::max(clip_.left(), static_cast<int>(std::floor(minX)));
+        auto top = std::max(clip_.top(), static_cast<int>(std::floor(edges_[0].y0)));
+        auto right = std::min(clip_.right(), static_cast<int>(std::ceil(maxX)) + 1);
+        auto bottom = std::min(clip_.bottom(), static_cast<int>(std::ceil(maxY)));
+        if (right <= left || bottom <= top)
+            return;
+        iRect area(left, top, right - left, bottom - top);
+        if (antiAliasing_)
+            fillAntiAliased(area, pack(color), rule);
+        else
+            fillAliased(area, pack(color), rule);
+    }
+    /// @details 位于填充区域左侧的部分被压到第一个单元上，对右侧像素的覆盖率贡献不变；
+    ///          相邻的未被触及的单元覆盖率相同，整段绘制
+    void Rasterizer::fillAntiAliased(const iRect& area, std::uint32_t color, FillRule rule) {
+        auto width = area.width();
+        auto fleft = static_cast<float>(area.left()), fwidth = static_cast<float>(width);
+        cells_.assign(static_cast<std::size_t>(width) + 2, 0.0f);
+        auto cells = cells_.data();
+        auto alpha = static_cast<int>(color >> 24);
+        alpha += alpha >> 7;
+        active_.clear();
+        std::size_t next = 0;
+        for (int y = area.top(); y < area.bottom(); y++) {
+            auto fy0 = static_cast<float>(y), fy1 = fy0 + 1.0f;
+            while (next < edges_.size() && edges_[next].y0 < fy1) {
+                if (edges_[next].y1 > fy0)
+                    active_.push_back(&edges_[next]);
+                next++;
+            }
+            std::erase_if(active_, [fy0](const Edge* e) { return e->y1 <= fy0; });
+            if (active_.empty())
+                continue;
+            touched_.clear();
+            for (auto e : active_) {
+                auto ya = std::max(fy0, e->y0), yb = std::min(fy1, e->y1);
+                if (yb <= ya)
+                    continue;
+                auto xa = e->x0 + (ya - e->y0) * e->dxdy - fleft;
+                auto xb = e->x0 + (yb - e->y0) * e->dxdy - fleft;
+                accumulateClipped(cells, touched_, xa, xb, e->dir * (yb - ya), fwidth);
+            }
+            if (touched_.empty())
+                continue;
+            std::sort(touched_.begin(), touched_.end());
+            touched_.erase(std::unique(touched_.begin(), touched_.end()), touched_.end());
+            // 两个被修改的单元之间的像素覆盖率与左侧的单元相同
+            auto row = pixels_ + static_cast<std::ptrdiff_t>(y) * stride_ + area.left();
+            float acc = 0.0f;
+            int a = 0, prev = touched_.front() - 1;
+            for (auto x : touched_) {
+                // 被压到右边界上的单元之前的像素仍需绘制
+                auto end = std::min(x, width);
+                paintSpan(row + prev + 1, end - prev - 1, color, a);
+                prev = end;
+                acc += cells[x];
+                cells[x] = 0.0f;
+                if (x >= width)
+                    continue;
+                a = static_cast<int>(coverage(acc, rule) * alpha + 0.5f);
+                if (a >= opaque)
+                    row[x] = color | 0xff000000u;
+                else if (a > 0)
+                    blendPixel(row[x], color, a);
+            }
+        }
+    }
+    /// @details 像素中心位于区间 [xa, xb) 内时视为被覆盖
+    void Rasterizer::fillAliased(const iRect& area, std::uint32_t color, FillRule rule) {
+        auto alpha = static_cast<int>(color >> 24);
+        alpha += alpha >> 7;
+        active_.clear();
+        std::size_t next = 0;
+        for (int y = area.top(); y < area.bottom(); y++) {
+            auto yc = static_cast<float>(y) + 0.5f;
+            while (next < edges_.size() && edges_[next].y0 <= yc) {
+                if (edges_[next].y1 > yc)
+                    active_.push_back(&edges_[next]);
+                next++;
+            }
+            std::erase_if(active_, [yc](const Edge* e) { return e->y1 <= yc; });
+            if (active_.empty())
+                continue;
+            crossings_.clear();
+            for (auto e : active_)
+                crossings_.emplace_back(e->x0 + (yc - e->y0) * e->dxdy, e->dir);
+            std::sort(crossings_.begin(), crossings_.end());
+            auto row = pixels_ + static_cast<std::ptrdiff_t>(y) * stride_;
+            int winding = 0;
+            for (std::size_t i = 0; i + 1 < crossings_.size(); i++) {
+                winding += static_cast<int>(crossings_[i].second);
+                bool inside = rule == FillRule::NonZero ? winding != 0 : (winding & 1) != 0;
+                if (!inside)
+                    continue;
+                auto x0 = std::max(area.left(), static_cast<int>(std::ceil(crossings_[i].first - 0.5f)));
+                auto x1 = std::min(area.right(), static_cast<int>(std::ceil(crossings_[i + 1].first - 0.5f)));
+                paintSpan(row + x0, x1 - x0, color, alpha);
+            }
+        }
+    }
+}
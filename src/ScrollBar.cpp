@@ -35,8 +35,11 @@ namespace GFt {
                 ssid = Application::onEventCall.connect([&, k] {
                     auto y = Sys::getCursorPosition().y() - bPos_.y();
                     setPosition(y_ + y / k);
+                    // 拖动期间光标可能离开窗口而不产生输入消息，需要持续请求帧
                     if (!(Sys::getAsyncKeyState(Key::LeftMouse) & 0x8000))
                         Application::onEventCall.disconnect(ssid);
+                    else
+                        Application::requestFrame();
                     });
             }
             else {
@@ -74,6 +77,7 @@ namespace GFt {
             if (pos == currentPos_)
                 return;
             currentPos_ = pos;
+            markDirty();
             onCurrentPosChanged(currentPos_);
         }
         float VScrollBar::getPosition() const {
@@ -85,6 +89,7 @@ namespace GFt {
             if (size == completeSize_)
                 return;
             completeSize_ = size;
+            markDirty();
         }
         float VScrollBar::getCompleteSize() const {
             return completeSize_;
@@ -95,15 +100,16 @@ namespace GFt {
             if (size == visibleSize_)
                 return;
             visibleSize_ = size;
+            markDirty();
         }
         float VScrollBar::getVisibleSize() const {
             return visibleSize_;
         }
         void VScrollBar::setStep(float step) { step_ = step; }
         float VScrollBar::getStep() const { return step_; }
-        Color& VScrollBar::backgroundColor() { return backgroundColor_; }
-        Color& VScrollBar::barColor() { return barColor_; }
-        Color& VScrollBar::barBorderColor() { return barBorderColor_; }
+        Color& VScrollBar::backgroundColor() { markDirty(); return backgroundColor_; }
+        Color& VScrollBar::barColor() { markDirty(); return barColor_; }
+        Color& VScrollBar::barBorderColor() { markDirty(); return barBorderColor_; }
 
         const Color& VScrollBar::backgroundColor() const { return backgroundColor_; }
         const Color& VScrollBar::barColor() const { return barColor_; }
@@ -144,8 +150,11 @@ namespace GFt {
                 ssid = Application::onEventCall.connect([&, k] {
                     auto x = Sys::getCursorPosition().x() - bPos_.x();
                     setPosition(x_ + x / k);
+                    // 拖动期间光标可能离开窗口而不产生输入消息，需要持续请求帧
                     if (!(Sys::getAsyncKeyState(Key::LeftMouse) & 0x8000))
                         Application::onEventCall.disconnect(ssid);
+                    else
+                        Application::requestFrame();
                     });
             }
             else {
@@ -179,6 +188,7 @@ namespace GFt {
             if (pos == currentPos_)
                 return;
             currentPos_ = pos;
+            markDirty();
             onCurrentPosChanged(currentPos_);
         }
         float HScrollBar::getPosition() const {
@@ -190,6 +200,7 @@ namespace GFt {
             if (size == completeSize_)
                 return;
             completeSize_ = size;
+            markDirty();
         }
         float HScrollBar::getCompleteSize() const {
             return completeSize_;
@@ -200,15 +211,16 @@ namespace GFt {
             if (size == visibleSize_)
                 return;
             visibleSize_ = size;
+            markDirty();
         }
         float HScrollBar::getVisibleSize() const {
             return visibleSize_;
         }
         void HScrollBar::setStep(float step) { step_ = step; }
         float HScrollBar::getStep() const { return step_; }
-        Color& HScrollBar::backgroundColor() { return backgroundColor_; }
-        Color& HScrollBar::barColor() { return barColor_; }
-        Color& HScrollBar::barBorderColor() { return barBorderColor_; }
+        Color& HScrollBar::backgroundColor() { markDirty(); return backgroundColor_; }
+        Color& HScrollBar::barColor() { markDirty(); return barColor_; }
+        Color& HScrollBar::barBorderColor() { markDirty(); return barBorderColor_; }
 
         const Color& HScrollBar::backgroundColor() const { return backgroundColor_; }
         const Color& HScrollBar::barColor() const { return barColor_; }
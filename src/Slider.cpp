@@ -49,8 +49,11 @@ namespace GFt {
                     auto p2 = iPoint{ it.right() - xais, ypos };
                     auto newvalue = (rel.x() - p1.x()) * 1.f / (p2.x() - p1.x()) * (maxValue_ - minValue_) + minValue_;
                     setValue(newvalue);
+                    // 拖动期间光标可能离开窗口而不产生输入消息，需要持续请求帧
                     if (!(Sys::getAsyncKeyState(Key::LeftMouse) & 0x8000))
                         Application::onEventCall.disconnect(ssid);
+                    else
+                        Application::requestFrame();
                     });
             }
             else if (std::abs(rel.y() - handlePos_.y()) <= rect().size().height() / 2) {
@@ -72,6 +75,7 @@ namespace GFt {
             minValue_ = minValue;
             maxValue_ = maxValue;
             step_ = step;
+            markDirty();
         }
 
         void HSlider::setValue(float value) {
@@ -83,18 +87,19 @@ namespace GFt {
             if (std::abs(value - value_) < step_ / 2)
                 return;
             value_ = value;
+            markDirty();
             onValueChanged(value_);
         }
 
         float HSlider::getValue() const { return value_; }
 
-        Color& HSlider::backgroundColor() { return backgroundColor_; }
-        Color& HSlider::foregroundColor() { return foregroundColor_; }
-        Color& HSlider::handleColor() { return handleColor_; }
-        int& HSlider::handleRadius() { return handleRadius_; }
-        int& HSlider::handleThickness() { return handleThickness_; }
-        void HSlider::setShowDiff(bool showDiff) { showDiff_ = showDiff; }
-        void HSlider::setReverse(bool reverse) { reverse_ = reverse; }
+        Color& HSlider::backgroundColor() { markDirty(); return backgroundColor_; }
+        Color& HSlider::foregroundColor() { markDirty(); return foregroundColor_; }
+        Color& HSlider::handleColor() { markDirty(); return handleColor_; }
+        int& HSlider::handleRadius() { markDirty(); return handleRadius_; }
+        int& HSlider::handleThickness() { markDirty(); return handleThickness_; }
+        void HSlider::setShowDiff(bool showDiff) { showDiff_ = showDiff; markDirty(); }
+        void HSlider::setReverse(bool reverse) { reverse_ = reverse; markDirty(); }
 
         const Color& HSlider::backgroundColor() const { return backgroundColor_; }
         const Color& HSlider::foregroundColor() const { return foregroundColor_; }
@@ -149,8 +154,11 @@ namespace GFt {
                     auto p2 = iPoint{ xpos, it.bottom() - yais };
                     auto newvalue = (rel.y() - p1.y()) * 1.f / (p2.y() - p1.y()) * (maxValue_ - minValue_) + minValue_;
                     setValue(newvalue);
+                    // 拖动期间光标可能离开窗口而不产生输入消息，需要持续请求帧
                     if (!(Sys::getAsyncKeyState(Key::LeftMouse) & 0x8000))
                         Application::onEventCall.disconnect(ssid);
+                    else
+                        Application::requestFrame();
                     });
             }
             else if (std::abs(rel.x() - handlePos_.x()) <= rect().size().width() / 2) {
@@ -171,6 +179,7 @@ namespace GFt {
             minValue_ = minValue;
             maxValue_ = maxValue;
             step_ = step;
+            markDirty();
         }
         void VSlider::setValue(float value) {
             value = std::round((value - minValue_) / step_) * step_ + minValue_;
@@ -181,18 +190,19 @@ namespace GFt {
             if (std::abs(value - value_) < step_ / 2)
                 return;
             value_ = value;
+            markDirty();
             onValueChanged(value_);
         }
 
         float VSlider::getValue() const { return value_; }
 
-        Color& VSlider::backgroundColor() { return backgroundColor_; }
-        Color& VSlider::foregroundColor() { return foregroundColor_; }
-        Color& VSlider::handleColor() { return handleColor_; }
-        int& VSlider::handleRadius() { return handleRadius_; }
-        int& VSlider::handleThickness() { return handleThickness_; }
-        void VSlider::setShowDiff(bool showDiff) { showDiff_ = showDiff; }
-        void VSlider::setReverse(bool reverse) { reverse_ = reverse; }
+        Color& VSlider::backgroundColor() { markDirty(); return backgroundColor_; }
+        Color& VSlider::foregroundColor() { markDirty(); return foregroundColor_; }
+        Color& VSlider::handleColor() { markDirty(); return handleColor_; }
+        int& VSlider::handleRadius() { markDirty(); return handleRadius_; }
+        int& VSlider::handleThickness() { markDirty(); return handleThickness_; }
+        void VSlider::setShowDiff(bool showDiff) { showDiff_ = showDiff; markDirty(); }
+        void VSlider::setReverse(bool reverse) { reverse_ = reverse; markDirty(); }
 
         const Color& VSlider::backgroundColor() const { return backgroundColor_; }
         const Color& VSlider::foregroundColor() const { return foregroundColor_; }
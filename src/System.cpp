@@ -1,9 +1,40 @@
 #include "GraceFt/System.h"
+#ifdef GFT_HEADLESS
+#include <mutex>
+#else
 #include <ege.h>
 #include <windows.h>
+#endif
+
+#include <GraceFt/Backend.h>
+#include <cstdlib>
 
 namespace GFt {
     namespace Sys {
+#ifdef GFT_HEADLESS
+        namespace {
+            std::mutex clipboardMutex;
+            std::wstring clipboard;
+        }
+        /// @details 无窗口构建中没有键盘，总是返回 0
+        unsigned short getKeyState(Key) { return 0; }
+        /// @details 无窗口构建中没有键盘，总是返回 0
+        unsigned short getAsyncKeyState(Key) { return 0; }
+        iPoint getCursorPosition() {
+            return Backend::instance().cursorPosition();
+        }
+        /// @details 无窗口构建中鼠标位置由 HeadlessBackend 合成的输入决定，此函数无效果
+        void setCursorPosition(iPoint) {}
+        /// @details 无窗口构建中剪贴板只在进程内有效
+        std::wstring getCilpBoardText() {
+            std::lock_guard<std::mutex> lock(clipboardMutex);
+            return clipboard;
+        }
+        void setCilpBoardText(std::wstring text) {
+            std::lock_guard<std::mutex> lock(clipboardMutex);
+            clipboard = std::move(text);
+        }
+#else
         unsigned short getKeyState(Key key) {
             return GetKeyState(static_cast<int>(key));
         }
@@ -11,9 +42,7 @@ namespace GFt {
             return GetAsyncKeyState(static_cast<int>(key));
         }
         iPoint getCursorPosition() {
-            POINT p;
-            GetCursorPos(&p);
-            return iPoint(p.x, p.y);
+            return Backend::instance().cursorPosition();
         }
         void setCursorPosition(iPoint pos) {
             SetCursorPos(pos.x(), pos.y());
@@ -47,6 +76,7 @@ namespace GFt {
             ::SetClipboardData(CF_UNICODETEXT, hGlobalMemory);
             ::CloseClipboard();
         }
+#endif
         std::optional<std::string> getEnv(const std::string& name) {
             char* value = getenv(name.c_str());
             if (value == nullptr)
@@ -1,25 +1,28 @@
 #include "GraceFt/TextSet.h"
 
-#include <ege.h>
+#include <_private_draw.inl>
 
 namespace GFt {
-    using namespace ege;
     TextSet::TextSet(const Color& color, const Font& font) : font_(font) {
-        color_ = EGERGBA(color.red(), color.green(), color.blue(), color.alpha());
+        color_ = _GFt_private_::_pack_color(color);
+        version_ = _GFt_private_::_next_state_version();
+    }
+    Font& TextSet::font() {
+        version_ = _GFt_private_::_next_state_version();
+        return font_;
     }
-    Font& TextSet::font() { return font_; }
     const Font& TextSet::font() const { return font_; }
-void TextSet::setColor(const Color& color) {
-        color_ = EGERGBA(color.red(), color.green(), color.blue(), color.alpha());
+    void TextSet::setColor(const Color& color) {
+        color_ = _GFt_private_::_pack_color(color);
+        version_ = _GFt_private_::_next_state_version();
+    }
+    void TextSet::setTransparent(bool transparent) {
+        transparent_ = transparent;
+        version_ = _GFt_private_::_next_state_version();
     }
-    void TextSet::setTransparent(bool transparent) { transparent_ = transparent; }
     Color TextSet::getColor() const {
-        return Color(
-            EGEGET_R(color_),
-            EGEGET_G(color_),
-            EGEGET_B(color_),
-            EGEGET_A(color_)
-        );
+        return _GFt_private_::_unpack_color(color_);
     }
     bool TextSet::isTransparent() const { return transparent_; }
+    std::uint64_t TextSet::version() const { return version_; }
 }
\ No newline at end of file
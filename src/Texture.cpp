@@ -1,59 +1,107 @@
 #include "GraceFt/Texture.h"
 
+#include <_private.inl>
+#include <utility>
+#ifdef GFT_HEADLESS
+#include <stdexcept>
+#else
 #include <ege.h>
+#endif
 
+#define TEX(x) (static_cast<_GFt_private_::TexturePrivate*>(x))
+#ifdef GFT_HEADLESS
+#define IMG(x) (static_cast<PixelMap*>(x))
+#else
 #define IMG(x) (static_cast<ege::PIMAGE>(x))
+#endif
 
 namespace GFt {
-    using namespace ege;
+    using namespace _GFt_private_;
+    namespace {
+#ifdef GFT_HEADLESS
+        /// @details 无窗口构建中纹理只保存位图的副本，不能加载时与 EGE 一样得到空纹理
+        void* loadImage(const std::wstring& path) {
+            auto image = new PixelMap();
+            try {
+                *image = PixelMap::loadFromFile(path);
+            }
+            catch (const std::runtime_error&) {}
+            return image;
+        }
+        void* copyImage(void* source) { return new PixelMap(*IMG(source)); }
+        void assignImage(void* image, void* source) { *IMG(image) = *IMG(source); }
+        void deleteImage(void* image) { delete IMG(image); }
+#else
+        using namespace ege;
+        void* loadImage(const std::wstring& path) {
+            auto img = newimage();
+            getimage(img, path.c_str());
+            ege_gentexture(true, img);
+            return img;
+        }
+        void* copyImage(void* source) {
+            auto img = newimage();
+            resize(img, getwidth(IMG(source)), getheight(IMG(source)));
+            putimage(img, 0, 0, IMG(source));
+            ege_gentexture(true, img);
+            return img;
+        }
+        /// @details 纹理数据在复制像素前释放、复制后重新生成，使其与新的像素一致
+        void assignImage(void* image, void* source) {
+            ege_gentexture(false, IMG(image));
+            resize(IMG(image), getwidth(IMG(source)), getheight(IMG(source)));
+            putimage(IMG(image), 0, 0, IMG(source));
+            ege_gentexture(true, IMG(image));
+        }
+        void deleteImage(void* image) {
+            ege_gentexture(false, IMG(image));
+            delimage(IMG(image));
+        }
+#endif
+    }
+
     Texture::Texture(const std::wstring& path) {
-        auto img = newimage();
-        getimage(img, path.c_str());
-        texture_ = img;
-        ege_gentexture(true, IMG(texture_));
+        texture_ = new TexturePrivate{ loadImage(path), _next_state_version() };
     }
     Texture::Texture(const PixelMap& bitmap) {
-        auto img = newimage();
-        auto s = bitmap.size();
-        resize(img, s.width(), s.height());
-        putimage(img, 0, 0, IMG(bitmap.pixmap_));
-        texture_ = img;
-        ege_gentexture(true, IMG(texture_));
+#ifdef GFT_HEADLESS
+        texture_ = new TexturePrivate{ new PixelMap(bitmap), _next_state_version() };
+#else
+        texture_ = new TexturePrivate{ copyImage(bitmap.pixmap_), _next_state_version() };
+#endif
     }
     Texture::Texture(const Texture& other) {
-        auto img = newimage();
-        resize(img, getwidth(IMG(other.texture_)), getheight(IMG(other.texture_)));
-        putimage(img, 0, 0, IMG(other.texture_));
-        texture_ = img;
-        ege_gentexture(true, IMG(texture_));
+        texture_ = new TexturePrivate{ copyImage(TEX(other.texture_)->image), _next_state_version() };
     }
+    /// @details 在原有的图像上复制像素，引用此纹理的画刷随之使用新的图像
     Texture& Texture::operator=(const Texture& other) {
         if (this == &other)
             return *this;
-        auto img = newimage();
-        resize(img, getwidth(IMG(other.texture_)), getheight(IMG(other.texture_)));
-        putimage(img, 0, 0, IMG(other.texture_));
-        texture_ = img;
-        ege_gentexture(true, IMG(texture_));
+        assignImage(TEX(texture_)->image, TEX(other.texture_)->image);
+        TEX(texture_)->version = _next_state_version();
         return *this;
     }
     Texture::Texture(Texture&& other) {
-        texture_ = other.texture_;
-        other.texture_ = nullptr;
+        texture_ = std::exchange(other.texture_, nullptr);
     }
+    /// @details 与 other 交换图像而不交换 TexturePrivate，引用此纹理的画刷随之使用新的图像
     Texture& Texture::operator=(Texture&& other) {
         if (this == &other)
             return *this;
-        texture_ = other.texture_;
-        other.texture_ = nullptr;
+        if (!texture_ || !other.texture_) {
+            std::swap(texture_, other.texture_);
+            return *this;
+        }
+        std::swap(TEX(texture_)->image, TEX(other.texture_)->image);
+        TEX(texture_)->version = _next_state_version();
+        TEX(other.texture_)->version = _next_state_version();
         return *this;
     }
     Texture::~Texture() {
         if (texture_) {
-            ege_gentexture(false, IMG(texture_));
-            delimage(IMG(texture_));
+            deleteImage(TEX(texture_)->image);
+            delete TEX(texture_);
         }
         texture_ = nullptr;
     }
-
-}
\ No newline at end of file
+}
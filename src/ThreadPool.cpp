@@ -0,0 +1,92 @@
+#include "GraceFt/ThreadPool.h"
+#include <GraceFt/Application.h>
+
+namespace GFt {
+    namespace {
+        // 当前线程所属的线程池及其在池中的下标
+        thread_local const ThreadPool* tlsPool = nullptr;
+        thread_local std::size_t tlsIndex = 0;
+    }
+    ThreadPool::ThreadPool(std::size_t threads) {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t i = 0; i < threads; ++i)
+            workers_.push_back(std::make_unique<Worker>());
+        for (std::size_t i = 0; i < threads; ++i)
+            threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stop_ = true;
+        }
+        sleepCv_.notify_all();
+        for (auto& thread : threads_)
+            thread.join();
+    }
+    std::size_t ThreadPool::currentWorker() const {
+        return tlsPool == this ? tlsIndex : workers_.size();
+    }
+    void ThreadPool::enqueue(Job job) {
+        auto self = currentWorker();
+        auto index = self < workers_.size() ? self : next_++ % workers_.size();
+        {
+            std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+            workers_[index]->jobs.push_back(std::move(job));
+        }
+        pending_.fetch_add(1, std::memory_order_release);
+        // 加锁保证正在进入休眠的线程不会错过通知
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        sleepCv_.notify_one();
+    }
+    /// @details self 为调用线程在池中的下标，非工作线程传入 workers_.size()
+    ///          先从自身队列尾部取任务，再依次从其它队列头部窃取
+    bool ThreadPool::tryRunOne(std::size_t self) {
+        Job job;
+        auto count = workers_.size();
+        if (self < count) {
+            auto& own = *workers_[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.jobs.empty()) {
+                job = std::move(own.jobs.back());
+                own.jobs.pop_back();
+            }
+        }
+        for (std::size_t k = 1; !job && k <= count; ++k) {
+            auto& victim = *workers_[(self + k) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                job = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+            }
+        }
+        if (!job)
+            return false;
+        pending_.fetch_sub(1, std::memory_order_acq_rel);
+        job();
+        return true;
+    }
+    /// @details 停止时会先执行完所有剩余任务再退出
+    void ThreadPool::workerLoop(std::size_t index) {
+        tlsPool = this;
+        tlsIndex = index;
+        while (true) {
+            if (tryRunOne(index))
+                continue;
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleepCv_.wait(lock, [this] {
+                return stop_ || pending_.load(std::memory_order_acquire) > 0;
+                });
+            if (stop_ && pending_.load(std::memory_order_acquire) == 0)
+                return;
+        }
+    }
+    void ThreadPool::postToUI(std::function<void()> task) {
+        Application::post(std::move(task));
+    }
+    std::size_t ThreadPool::size() const { return workers_.size(); }
+    ThreadPool& ThreadPool::getInstance() {
+        static ThreadPool instance;
+        return instance;
+    }
+}
@@ -0,0 +1,141 @@
+#include "GraceFt/TileRenderer.h"
+
+#include <GraceFt/ThreadPool.h>
+#include <algorithm>
+#include <cmath>
+
+namespace GFt {
+    namespace {
+        iRect intersect(const iRect& a, const iRect& b) {
+            auto left = std::max(a.left(), b.left());
+            auto top = std::max(a.top(), b.top());
+            return iRect(left, top,
+                std::max(std::min(a.right(), b.right()) - left, 0),
+                std::max(std::min(a.bottom(), b.bottom()) - top, 0));
+        }
+        /// @brief 命令覆盖的分块不超过此数量时不值得分块并行
+        constexpr int minParallelTiles = 4;
+    }
+
+    void TileRenderer::setTarget(std::uint32_t* pixels, int width, int height, int stride) {
+        if (pixels == pixels_ && width == width_ && height == height_ && stride == stride_)
+            return;
+        flush();
+        pixels_ = pixels;
+        width_ = pixels ? width : 0;
+        height_ = pixels ? height : 0;
+        stride_ = stride;
+    }
+    void TileRenderer::setTileSize(int size) {
+        flush();
+        tileSize_ = std::max(size, 8);
+    }
+    int TileRenderer::tileSize() const { return tileSize_; }
+
+    /// @details 包围盒向右多取一列，抗锯齿时最右侧的边会影响其右侧相邻的像素
+    void TileRenderer::addFill(const fPoint* points, std::size_t count, const iRect& clip, const Color& color,
+        Rasterizer::FillRule rule, bool antiAliasing) {
+        if (count < 3 || color.alpha() == 0)
+            return;
+        auto minX = points[0].x(), maxX = minX, minY = points[0].y(), maxY = minY;
+        for (std::size_t i = 1; i < count; i++) {
+            minX = std::min(minX, points[i].x());
+            maxX = std::max(maxX, points[i].x());
+            minY = std::min(minY, points[i].y());
+            maxY = std::max(maxY, points[i].y());
+        }
+        if (!std::isfinite(minX + maxX + minY + maxY))
+            return;
+        auto target = intersect(clip, iRect(0, 0, width_, height_));
+        // 先在浮点数范围内限制，避免远离屏幕的坐标转换为整数时溢出
+        auto limit = [](float v, int lo, int hi) {
+            return static_cast<int>(std::clamp(v, static_cast<float>(lo), static_cast<float>(hi)));
+        };
+        auto left = limit(std::floor(minX), target.left(), target.right());
+        auto top = limit(std::floor(minY), target.top(), target.bottom());
+        auto right = limit(std::ceil(maxX) + 1, target.left(), target.right());
+        auto bottom = limit(std::ceil(maxY), target.top(), target.bottom());
+        if (right <= left || bottom <= top)
+            return;
+        commands_.push_back(Command{
+            static_cast<std::uint32_t>(points_.size()), static_cast<std::uint32_t>(count),
+            target, iRect(left, top, right - left, bottom - top), color, rule, antiAliasing });
+        points_.insert(points_.end(), points, points + count);
+    }
+    bool TileRenderer::empty() const { return commands_.empty(); }
+    std::size_t TileRenderer::size() const { return commands_.size(); }
+    std::size_t TileRenderer::lastTileCount() const { return lastTiles_; }
+
+    void TileRenderer::flush() {
+        if (!commands_.empty())
+            flush(ThreadPool::getInstance());
+    }
+    /// @details 每个工作线程使用各自的光栅化器，分块内逐个命令设置裁剪区域为命令的裁剪区域与分块的交集
+    /// @details 线程池只有一个工作线程，或所有命令的包围盒只覆盖少量分块时，按记录顺序直接绘制
+    void TileRenderer::flush(ThreadPool& pool) {
+        if (commands_.empty())
+            return;
+        auto tileOf = [&](int v) { return v / tileSize_; };
+        auto left = commands_[0].bounds.left(), top = commands_[0].bounds.top();
+        auto right = commands_[0].bounds.right(), bottom = commands_[0].bounds.bottom();
+        for (auto& command : commands_) {
+            left = std::min(left, command.bounds.left());
+            top = std::min(top, command.bounds.top());
+            right = std::max(right, command.bounds.right());
+            bottom = std::max(bottom, command.bounds.bottom());
+        }
+        auto covered = (tileOf(right - 1) - tileOf(left) + 1) * (tileOf(bottom - 1) - tileOf(top) + 1);
+        if (pool.size() <= 1 || covered <= minParallelTiles) {
+            thread_local Rasterizer rasterizer;
+            rasterizer.setTarget(pixels_, width_, height_, stride_);
+            for (auto& command : commands_) {
+                rasterizer.setClip(command.clip);
+                rasterizer.setAntiAliasing(command.antiAliasing);
+                rasterizer.reset();
+                rasterizer.addPolygon(points_.data() + command.first, command.count);
+                rasterizer.fill(command.color, command.rule);
+            }
+            lastTiles_ = 0;
+            clear();
+            return;
+        }
+        auto columns = (width_ + tileSize_ - 1) / tileSize_;
+        auto rows = (height_ + tileSize_ - 1) / tileSize_;
+        bins_.resize(static_cast<std::size_t>(columns) * rows);
+        occupied_.clear();
+        for (std::uint32_t i = 0; i < commands_.size(); i++) {
+            auto& bounds = commands_[i].bounds;
+            auto x1 = (bounds.right() - 1) / tileSize_, y1 = (bounds.bottom() - 1) / tileSize_;
+            for (auto y = bounds.top() / tileSize_; y <= y1; y++)
+                for (auto x = bounds.left() / tileSize_; x <= x1; x++) {
+                    auto tile = static_cast<std::uint32_t>(y * columns + x);
+                    if (bins_[tile].empty())
+                        occupied_.push_back(tile);
+                    bins_[tile].push_back(i);
+                }
+        }
+        pool.parallelFor(0, occupied_.size(), [&](std::size_t index) {
+            thread_local Rasterizer rasterizer;
+            auto tile = occupied_[index];
+            iRect area(static_cast<int>(tile % columns) * tileSize_, static_cast<int>(tile / columns) * tileSize_,
+                tileSize_, tileSize_);
+            rasterizer.setTarget(pixels_, width_, height_, stride_);
+            for (auto i : bins_[tile]) {
+                auto& command = commands_[i];
+                rasterizer.setClip(intersect(command.clip, area));
+                rasterizer.setAntiAliasing(command.antiAliasing);
+                rasterizer.reset();
+                rasterizer.addPolygon(points_.data() + command.first, command.count);
+                rasterizer.fill(command.color, command.rule);
+            }
+        }, 1);
+        for (auto tile : occupied_)
+            bins_[tile].clear();
+        lastTiles_ = occupied_.size();
+        clear();
+    }
+    void TileRenderer::clear() {
+        commands_.clear();
+        points_.clear();
+    }
+}
@@ -0,0 +1,196 @@
+#include "GraceFt/Timeline.hpp"
+#include <numeric>
+#include <stdexcept>
+
+namespace GFt {
+    /// @brief 播放中的动画组
+    /// @details 每个动画组下一个子动画的开始时刻连续存放，每帧只扫描该数组，
+    ///          仅在到达开始时刻时才访问动画组对象
+    class AnimationGroup::Pool : public AnimationPoolBase {
+        std::vector<AnimationGroup*> groups_;
+        std::vector<TimePoint> deadlines_;
+        bool updating_ = false;
+        bool dirty_ = false;
+
+        void removeAt(std::size_t i) {
+            if (i + 1 != groups_.size()) {
+                groups_[i] = groups_.back();
+                deadlines_[i] = deadlines_.back();
+                if (groups_[i])
+                    groups_[i]->slot_ = i;
+            }
+            groups_.pop_back();
+            deadlines_.pop_back();
+        }
+    public:
+        void attach(AnimationGroup* group) {
+            group->slot_ = groups_.size();
+            groups_.push_back(group);
+            deadlines_.push_back(TimePoint::max());
+        }
+        void detach(AnimationGroup* group) {
+            auto i = std::exchange(group->slot_, npos);
+            groups_[i] = nullptr;
+            if (updating_)
+                dirty_ = true;
+            else
+                removeAt(i);
+        }
+        void schedule(std::size_t i, const TimePoint& deadline) { deadlines_[i] = deadline; }
+        bool empty() const override { return groups_.empty(); }
+        void update(const TimePoint& now, const TimePoint*) override {
+            auto count = groups_.size();
+            updating_ = true;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (deadlines_[i] > now)
+                    continue;
+                // 启动子动画时可能向此数组中加入动画组，因此按下标重新访问
+                auto group = groups_[i];
+                if (!group)
+                    continue;
+                auto deadline = group->advance(now);
+                if (groups_[i] == group)
+                    deadlines_[i] = deadline;
+            }
+            updating_ = false;
+            if (!dirty_)
+                return;
+            for (std::size_t i = 0; i < groups_.size();)
+                groups_[i] ? void(++i) : removeAt(i);
+            dirty_ = false;
+        }
+    };
+
+    AnimationGroup::AnimationGroup(Mode mode)
+        : AnimationAbstract(TimePoint(), 0.f, {}), mode_(mode) {}
+    AnimationGroup::~AnimationGroup() {
+        releaseSelf();
+        detachChildren(AnimationStateType::Stop);
+        for (auto& child : children_)
+            child.animation->parent_ = nullptr;
+    }
+    AnimationGroup::Pool& AnimationGroup::pool() { return AnimationManager::getInstance().pool<Pool>(); }
+
+    /// @details 子动画的时长可能在添加后改变，因此每次开始或恢复播放时重新计算
+    void AnimationGroup::layout() {
+        float end = 0.f;
+        duration_ms_ = 0.f;
+        for (auto& child : children_) {
+            child.offset = child.delay + (mode_ == Mode::Sequence ? end : 0.f);
+            end = child.offset + child.animation->getDuration();
+            duration_ms_ = std::max(duration_ms_, end);
+        }
+        order_.resize(children_.size());
+        std::iota(order_.begin(), order_.end(), std::size_t(0));
+        std::stable_sort(order_.begin(), order_.end(), [this](auto a, auto b) {
+            return children_[a].offset < children_[b].offset;
+            });
+    }
+    TimePoint AnimationGroup::startTime(const Child& child) const {
+        using namespace std::chrono;
+        return start_time_ + duration_cast<steady_clock::duration>(duration<float, std::milli>(child.offset));
+    }
+    void AnimationGroup::start(Child& child, bool fresh) {
+        auto animation = child.animation;
+        animation->start_time_ = startTime(child);
+        animation->finished_ = {};
+        if (fresh)
+            animation->hadSetPlay();
+        if (animation->state_ != AnimationStateType::Play) {
+            animation->onStateChanged(animation->state_, AnimationStateType::Play);
+            animation->state_ = AnimationStateType::Play;
+        }
+        animation->slot_ == npos ? animation->attach() : animation->sync();
+    }
+    /// @details 按开始时刻的顺序启动已到时的子动画，已经启动过的子动画不会重复启动
+    /// @return 下一个子动画的开始时刻，没有待开始的子动画时为 TimePoint::max()
+    TimePoint AnimationGroup::advance(const TimePoint& now) {
+        while (next_ < order_.size()) {
+            auto& child = children_[order_[next_]];
+            if (startTime(child) > now)
+                return startTime(child);
+            ++next_;
+            if (child.state != ChildState::Pending)
+                continue;
+            child.state = ChildState::Started;
+            start(child, true);
+        }
+        return TimePoint::max();
+    }
+    void AnimationGroup::detachChildren(AnimationStateType state) {
+        for (auto& child : children_) {
+            if (child.state != ChildState::Started)
+                continue;
+            auto animation = child.animation;
+            if (animation->state_ != state) {
+                animation->onStateChanged(animation->state_, state);
+                animation->state_ = state;
+            }
+            if (animation->slot_ != npos)
+                animation->detach();
+        }
+    }
+    void AnimationGroup::hadSetPlay() { fresh_ = true; }
+    /// @details 从头开始播放时所有子动画回到未开始的状态；从暂停处恢复时重新加入已开始的子动画，
+    ///          随后启动已到开始时刻的子动画
+    void AnimationGroup::attach() {
+        layout();
+        if (std::exchange(fresh_, false))
+            for (auto& child : children_)
+                child.state = ChildState::Pending;
+        remaining_ = 0;
+        for (auto& child : children_)
+            remaining_ += child.state != ChildState::Finished;
+        if (remaining_ == 0)
+            return finish();
+        pool().attach(this);
+        for (auto& child : children_)
+            if (child.state == ChildState::Started)
+                start(child, false);
+        next_ = 0;
+        auto deadline = advance(std::chrono::steady_clock::now());
+        // 启动的子动画可能立即结束而使动画组随之结束
+        if (slot_ != npos)
+            pool().schedule(slot_, deadline);
+    }
+    void AnimationGroup::detach() {
+        if (slot_ == npos)
+            return;
+        pool().detach(this);
+        detachChildren(state_);
+    }
+    void AnimationGroup::sync() {
+        pool().detach(this);
+        detachChildren(AnimationStateType::Play);
+        attach();
+    }
+    void AnimationGroup::childFinished(AnimationAbstract* animation) {
+        auto child = std::find_if(children_.begin(), children_.end(),
+            [animation](const auto& child) { return child.animation == animation; });
+        if (child == children_.end() || child->state != ChildState::Started)
+            return;
+        child->state = ChildState::Finished;
+        if (--remaining_ == 0)
+            finish();
+    }
+
+    AnimationGroup& AnimationGroup::add(AnimationAbstract* animation, float delay) {
+        if (!animation || animation == this || animation->parent_)
+            throw std::invalid_argument("Animation is null or already belongs to a group");
+        animation->parent_ = this;
+        children_.push_back(Child{ animation, delay });
+        layout();
+        requestRefresh();
+        return *this;
+    }
+    void AnimationGroup::clear() {
+        detachChildren(AnimationStateType::Stop);
+        for (auto& child : children_)
+            child.animation->parent_ = nullptr;
+        children_.clear();
+        layout();
+        requestRefresh();
+    }
+    std::size_t AnimationGroup::size() const { return children_.size(); }
+    AnimationGroup::Mode AnimationGroup::mode() const { return mode_; }
+}
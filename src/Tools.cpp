@@ -1,62 +1,52 @@
 #include "GraceFt/Tools.h"
 
-#include <ege.h>
-
-static inline auto _ = SetProcessDPIAware();
+#include <GraceFt/Backend.h>
 
 namespace GFt {
     namespace literals {
         int operator""_px(unsigned long long n) {
-            return static_cast<int>(GetDpiForSystem() * n * 1.04166667E-2);
+            return static_cast<int>(Backend::instance().dpi() * n * 1.04166667E-2);
         }
         int operator""_px(long double n) {
-            return static_cast<int>(GetDpiForSystem() * n * 1.04166667E-2);
+            return static_cast<int>(Backend::instance().dpi() * n * 1.04166667E-2);
         }
         int operator""_em(unsigned long long n) {
-            return static_cast<int>(GetDpiForSystem() * n * 1.66666667E-1);
+            return static_cast<int>(Backend::instance().dpi() * n * 1.66666667E-1);
         }
         int operator""_em(long double n) {
-            return static_cast<int>(GetDpiForSystem() * n * 1.66666667E-1);
+            return static_cast<int>(Backend::instance().dpi() * n * 1.66666667E-1);
         }
         int operator""_sw(unsigned long long n) {
-            int screenWidth = GetSystemMetrics(SM_CXSCREEN);
+            int screenWidth = Backend::instance().screenSize().width();
             return static_cast<int>(screenWidth * n / 100);
         }
         int operator""_sw(long double n) {
-            int screenWidth = GetSystemMetrics(SM_CXSCREEN);
+            int screenWidth = Backend::instance().screenSize().width();
             return static_cast<int>(screenWidth * n / 100);
         }
         int operator""_sh(unsigned long long n) {
-            int screenHeight = GetSystemMetrics(SM_CYSCREEN);
+            int screenHeight = Backend::instance().screenSize().height();
             return static_cast<int>(screenHeight * n / 100);
         }
         int operator""_sh(long double n) {
-            int screenHeight = GetSystemMetrics(SM_CYSCREEN);
+            int screenHeight = Backend::instance().screenSize().height();
             return static_cast<int>(screenHeight * n / 100);
         }
         int operator""_vw(unsigned long long n) {
-            auto hwnd = ege::getHWnd();
-            RECT rect;
-            GetClientRect(hwnd, &rect);
-            return static_cast<int>((rect.right - rect.left) * n / 100);
+            auto width = Backend::instance().clientRect().width();
+            return static_cast<int>(width * n / 100);
         }
         int operator""_vw(long double n) {
-            auto hwnd = ege::getHWnd();
-            RECT rect;
-            GetClientRect(hwnd, &rect);
-            return static_cast<int>((rect.right - rect.left) * n / 100);
+            auto width = Backend::instance().clientRect().width();
+            return static_cast<int>(width * n / 100);
         }
         int operator""_vh(unsigned long long n) {
-            auto hwnd = ege::getHWnd();
-            RECT rect;
-            GetClientRect(hwnd, &rect);
-            return static_cast<int>((rect.bottom - rect.top) * n / 100);
+            auto height = Backend::instance().clientRect().height();
+            return static_cast<int>(height * n / 100);
         }
         int operator""_vh(long double n) {
-            auto hwnd = ege::getHWnd();
-            RECT rect;
-            GetClientRect(hwnd, &rect);
-            return static_cast<int>((rect.bottom - rect.top) * n / 100);
+            auto height = Backend::instance().clientRect().height();
+            return static_cast<int>(height * n / 100);
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "GraceFt/Animation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <bit>
+
+namespace GFt {
+    namespace {
+        // 以下近似函数只使用四则运算、位运算与整数转换，循环中调用时可以被编译器自动向量化；
+        // 默认的 -ftrapping-math 下编译器不会为浮点比较与条件运算生成无分支的选择指令，
+        // 因此比较在整数位模式上进行，并以位掩码混合代替条件运算符
+        constexpr float pi = 3.14159265358979323846f;
+        constexpr float half_pi = pi / 2;
+        constexpr float inv_two_pi = 1 / (2 * pi);
+        // 2π 拆分为高低两部分，减小范围规约时的舍入误差
+        constexpr float two_pi_hi = 6.28125f;
+        constexpr float two_pi_lo = 1.9353071795864769e-3f;
+        constexpr float log2e = 1.44269504088896341f;
+        constexpr float ln2_hi = 0.693359375f;
+        constexpr float ln2_lo = -2.12194440e-4f;
+        constexpr float ln2 = 0.69314718055994531f;
+        constexpr float sqrt2 = 1.41421356237309505f;
+
+        inline std::int32_t bits(float x) { return std::bit_cast<std::int32_t>(x); }
+        inline float select(bool cond, float a, float b) {
+            auto mask = -static_cast<std::int32_t>(cond);
+            return std::bit_cast<float>((bits(a) & mask) | (bits(b) & ~mask));
+        }
+        inline float roundToInt(float x) {
+            return static_cast<float>(static_cast<std::int32_t>(x + std::copysign(0.5f, x)));
+        }
+        /// @details 先规约到 [-π, π]，再利用 sin(π - x) = sin(x) 折叠到 [-π/2, π/2]，
+        ///          最后以 11 阶泰勒多项式计算，截断误差小于 6e-8
+        inline float fastSin(float x) {
+            auto n = roundToInt(x * inv_two_pi);
+            auto r = (x - n * two_pi_hi) - n * two_pi_lo;
+            auto folded = std::copysign(pi, r) - r;
+            r = select((bits(r) & 0x7fffffff) > bits(half_pi), folded, r);
+            auto r2 = r * r;
+            return r * (1.f + r2 * (-1.f / 6 + r2 * (1.f / 120 + r2 * (-1.f / 5040
+                + r2 * (1.f / 362880 + r2 * (-1.f / 39916800))))));
+        }
+        inline float fastCos(float x) { return fastSin(x + half_pi); }
+        /// @details 规约为 x = n·ln2 + r，|r| <= ln2/2，e^r 以 6 阶多项式计算，2^n 直接构造指数位
+        inline float fastExp(float x) {
+            auto ix = bits(x);
+            x = select(ix > bits(88.f), 88.f, x);
+            x = select(((ix & 0x7fffffff) > bits(87.f)) & (ix < 0), -87.f, x);
+            auto n = roundToInt(x * log2e);
+            auto r = (x - n * ln2_hi) - n * ln2_lo;
+            auto p = 1.f + r * (1.f + r * (1.f / 2 + r * (1.f / 6 + r * (1.f / 24
+                + r * (1.f / 120 + r * (1.f / 720))))));
+            auto scale = std::bit_cast<float>((static_cast<std::int32_t>(n) + 127) << 23);
+            return p * scale;
+        }
+        /// @details 取出指数位，尾数规约到 [√2/2, √2)，再以 atanh 级数计算 ln(m)
+        /// @note 要求 x > 0
+        inline float fastLog(float x) {
+            auto ix = bits(x);
+            auto e = static_cast<float>((ix >> 23) - 127);
+            auto m = std::bit_cast<float>((ix & 0x7fffff) | 0x3f800000);
+            auto big = bits(m) > bits(sqrt2);
+            auto half = m * 0.5f;
+            auto next = e + 1.f;
+            m = select(big, half, m);
+            e = select(big, next, e);
+            auto s = (m - 1.f) / (m + 1.f);
+            auto s2 = s * s;
+            auto lnm = 2.f * s * (1.f + s2 * (1.f / 3 + s2 * (1.f / 5 + s2 * (1.f / 7 + s2 * (1.f / 9)))));
+            return e * ln2 + lnm;
+        }
+        /// @param zero x <= 0 时的结果
+        inline float fastPow(float x, float p, float zero) {
+            auto positive = bits(x) > 0;
+            auto v = fastExp(p * fastLog(select(positive, x, 1.f)));
+            return select(positive, v, zero);
+        }
+    }
+
+    EaseKernel EaseKernel::of(const TransFunc& func) {
+        using Kind = EaseKernel::Kind;
+        if (!func)
+            return {};
+        if (auto f = func.target<float(*)(float)>()) {
+            if (*f == &TransFuncs::linear)
+                return { Kind::Linear, 0.f, nullptr };
+            if (*f == &TransFuncs::bezier)
+                return { Kind::Bezier, 0.f, nullptr };
+            if (*f == &TransFuncs::smoothInOut)
+                return { Kind::SmoothInOut, 0.f, nullptr };
+            return {};
+        }
+        if (auto f = func.target<TransFuncs::Power>())
+            return { Kind::Power, f->power, nullptr };
+        if (auto f = func.target<TransFuncs::OverDamped>())
+            return { Kind::OverDamped, f->damping, nullptr };
+        if (auto f = func.target<TransFuncs::UnderDamped>())
+            return { Kind::UnderDamped, f->damping, nullptr };
+        if (auto f = func.target<TransFuncs::LookupTable>())
+            return { Kind::Table, 0.f, f->samples_ };
+        return {};
+    }
+
+    void EaseKernel::evaluate(const float* x, float* y, std::size_t count) const {
+        // 复制到局部变量，否则编译器需考虑 y 与 param 重叠而在每次迭代中重新读取
+        auto p = param;
+        switch (kind) {
+        case Kind::Linear:
+            std::copy_n(x, count, y);
+            break;
+        case Kind::Bezier:
+            for (std::size_t i = 0; i < count; ++i)
+                y[i] = x[i] * x[i] * (3.f - 2.f * x[i]);
+            break;
+        case Kind::SmoothInOut:
+            for (std::size_t i = 0; i < count; ++i) {
+                auto v = x[i] * (2 * pi);
+                y[i] = (v - fastSin(v)) * inv_two_pi;
+            }
+            break;
+        case Kind::Power:
+        {
+            auto zero = p == 0.f ? 1.f : 0.f;
+            for (std::size_t i = 0; i < count; ++i)
+                y[i] = fastPow(x[i], p, zero);
+        }
+            break;
+        case Kind::OverDamped:
+        {
+            auto norm = 1 / (1 - std::exp(-p));
+            for (std::size_t i = 0; i < count; ++i)
+                y[i] = (1.f - fastExp(-p * x[i] * x[i])) * norm;
+        }
+        break;
+        case Kind::UnderDamped:
+            for (std::size_t i = 0; i < count; ++i)
+                y[i] = 1.f - (1.f - x[i]) * fastCos(x[i] * p);
+            break;
+        case Kind::Table:
+            for (std::size_t i = 0; i < count; ++i)
+                y[i] = TransFuncs::LookupTable::lookup(*table, x[i]);
+            break;
+        case Kind::Custom:
+            break;
+        }
+    }
+
+    namespace TransFuncs {
+        LookupTable::LookupTable(const TransFunc& func, float max_error, std::size_t max_size) {
+            constexpr float probes[] = { 0.25f, 0.5f, 0.75f };
+            for (std::size_t n = 16;; n *= 2) {
+                std::vector<float> samples(n + 1);
+                for (std::size_t i = 0; i <= n; ++i)
+                    samples[i] = func(static_cast<float>(i) / n);
+                float error = 0.f;
+                for (std::size_t i = 0; i < n; ++i)
+                    for (auto q : probes) {
+                        auto approx = samples[i] + (samples[i + 1] - samples[i]) * q;
+                        error = std::max(error, std::abs(func((i + q) / n) - approx));
+                    }
+                if (error <= max_error || n >= max_size) {
+                    samples_ = std::make_shared<const std::vector<float>>(std::move(samples));
+                    maxError_ = error;
+                    return;
+                }
+            }
+        }
+        void LookupTable::operator()(const float* x, float* y, std::size_t count) const {
+            for (std::size_t i = 0; i < count; ++i)
+                y[i] = lookup(*samples_, x[i]);
+        }
+        float LookupTable::maxError() const { return maxError_; }
+        std::size_t LookupTable::size() const { return samples_->size() - 1; }
+
+        void batch(const TransFunc& func, const float* x, float* y, std::size_t count) {
+            auto kernel = EaseKernel::of(func);
+            if (kernel.kind != EaseKernel::Kind::Custom)
+                return kernel.evaluate(x, y, count);
+            for (std::size_t i = 0; i < count; ++i)
+                y[i] = func(x[i]);
+        }
+    }
+}
@@ -1,9 +1,10 @@
 #include "GraceFt/Window.h"
 #include <GraceFt/Application.h>
 #include <GraceFt/Tools.h>
-#include <ege.h>
+#include <GraceFt/Backend.h>
+#include <iostream>
 
-#define H(hide) (hide? ege::INIT_HIDE : 0)
+#define H(hide) (hide? Backend::Hidden : 0)
 
 namespace GFt {
     Signal<Window*> Window::onWindowCreated;
@@ -16,90 +17,70 @@ namespace GFt {
     Signal<Window*> Window::onWindowFullscreened;
     Signal<Window*> Window::onWindowSizeChanged;
 
-    using namespace ege;
     using namespace literals;
     Window* Window::pInstance_ = nullptr;
     Window::Window(int width, int height, int flags)
         : Block(iRect(0, 0, width, height)), store_(width, height) {
-        initgraph(width, height, flags | INIT_UNICODE | INIT_ANIMATION | INIT_NOFORCEEXIT | INIT_HIDE);
-        if (getHWnd() == (HWND)0) {
+        if (!Backend::instance().createWindow(iSize(width, height), flags)) {
             std::cerr << "Failed to create window." << std::endl;
             Application::exit();
         }
-        setcaption(L"GraceFt v2.0.0");
-        setbkcolor(WHITE);
-        setcolor(BLACK);
-        setfillcolor(EGERGBA(195, 198, 220, 230));
-        cleardevice();
         Window::onWindowCreated(this);
     }
     Window::~Window() {
-        closegraph();
+        Backend::instance().closeWindow();
         Window::onWindowDestroyed(this);
     }
-    void Window::show() { showwindow(); }
-    void Window::hide() { hidewindow(); }
+    void Window::show() { Backend::instance().showWindow(true); }
+    void Window::hide() { Backend::instance().showWindow(false); }
     void Window::resize(const iSize& size) {
-        resizewindow(size.width(), size.height());
+        Backend::instance().resizeWindow(size);
         this->setSize(size);
         if (root_)
             root_->setSize(size);
         onWindowResized(this);
     }
     void Window::move(const iPoint& dpos) {
-        RECT rect;
-        ::GetWindowRect(getHWnd(), &rect);
-        movewindow(dpos.x() + rect.left, dpos.y() + rect.top);
+        auto& backend = Backend::instance();
+        backend.moveWindow(backend.windowRect().position() + dpos);
+        Block::invalidateWindowOrigin();
         onWindowMoved(this);
     }
     void Window::moveTo(const iPoint& pos) {
-        movewindow(pos.x(), pos.y());
+        Backend::instance().moveWindow(pos);
+        Block::invalidateWindowOrigin();
         onWindowMoved(this);
     }
-    void Window::setTitle(const std::wstring& title) { setcaption(title.c_str()); }
+    void Window::setTitle(const std::wstring& title) { Backend::instance().setWindowTitle(title); }
     void Window::setTopMost(bool topMost) {
         if (isMaximized_)
             return;
-        ::SetWindowPos(getHWnd(), topMost ? HWND_TOPMOST : HWND_NOTOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE);
+        Backend::instance().setWindowTopMost(topMost);
         isTopMost_ = topMost;
     }
     void Window::setFrameless(bool frameless) {
         if (isMaximized_)
             return;
-        auto style = ::GetWindowLong(getHWnd(), GWL_STYLE);
-        frameless ? style &= ~WS_CAPTION : style |= WS_CAPTION;
-        ::SetWindowLong(getHWnd(), GWL_STYLE, style);
+        Backend::instance().setWindowFrameless(frameless);
         isFrameless_ = frameless;
     }
     void Window::setAlpha(float alpha) {
-        auto style = ::GetWindowLong(getHWnd(), GWL_EXSTYLE);
         if (alpha >= 1.0f) alpha = 1.0f;
         if (alpha <= 0.0f) alpha = 0.0f;
-        style |= WS_EX_LAYERED;
-        ::SetWindowLong(getHWnd(), GWL_EXSTYLE, style);
-        ::SetLayeredWindowAttributes(getHWnd(), 0, alpha * 255, LWA_ALPHA);
+        Backend::instance().setWindowAlpha(alpha);
     }
     void Window::setAlpha(const std::optional<Color>& color) {
-        auto style = ::GetWindowLong(getHWnd(), GWL_EXSTYLE);
-        color ? style |= WS_EX_LAYERED : style &= ~WS_EX_LAYERED;
-        ::SetWindowLong(getHWnd(), GWL_EXSTYLE, style);
-        if (!color) return;
-        ::SetLayeredWindowAttributes(getHWnd(),
-            RGB(color->red(), color->green(), color->blue()), 0, LWA_COLORKEY);
+        Backend::instance().setWindowColorKey(color);
     }
     void Window::minimize() {
-        RECT rect;
-        GetWindowRect(getHWnd(), &rect);
-        pos_ = iPoint{ rect.left, rect.top };
-        ::ShowWindow(getHWnd(), SW_MINIMIZE);
+        pos_ = Backend::instance().windowRect().position();
+        Backend::instance().minimizeWindow();
         isMinimized_ = true;
         isMaximized_ = false;
         onWindowMinimized(this);
     }
     void Window::fullscreen() {
-        RECT rect;
-        GetWindowRect(getHWnd(), &rect);
-        pos_ = iPoint{ rect.left, rect.top };
+        pos_ = Backend::instance().windowRect().position();
         this->moveTo(iPoint{ 0,0 });
         this->resize(iSize{ 100_sw, 100_sh });
         bool t = isTopMost_, f = isFrameless_;
@@ -112,22 +93,19 @@ namespace GFt {
         onWindowSizeChanged(this);
     }
     void Window::maximize() {
+        auto& backend = Backend::instance();
         // 保存当前窗口位置
-        RECT rect;
-        GetWindowRect(getHWnd(), &rect);
-        pos_ = iPoint{ rect.left, rect.top };
+        auto rectWindow = backend.windowRect();
+        pos_ = rectWindow.position();
         // 计算最大化窗口大小
-        RECT rectDesktop, rectWindow, rectClient;
-        SystemParametersInfoW(SPI_GETWORKAREA, 0, &rectDesktop, 0);
-        GetWindowRect(getHWnd(), &rectWindow);
-        GetClientRect(getHWnd(), &rectClient);
+        auto rectDesktop = backend.workArea();
+        auto rectClient = backend.clientRect();
         iSize ms;
-        ms.width() = rectDesktop.right - rectDesktop.left;
-        ms.height() = rectDesktop.bottom - rectDesktop.top -
-            ((rectWindow.bottom - rectWindow.top) - (rectClient.bottom - rectClient.top));
+        ms.width() = rectDesktop.width();
+        ms.height() = rectDesktop.height() - (rectWindow.height() - rectClient.height());
         // 最大化窗口
         this->resize(ms);
-        this->moveTo(iPoint{ rectDesktop.left, rectDesktop.top });
+        this->moveTo(rectDesktop.position());
         isMinimized_ = false;
         isMaximized_ = true;
         onWindowMaximized(this);
@@ -155,8 +133,9 @@ namespace GFt {
         auto rect = block->rect();
         static Window window(rect.width(), rect.height(), H(hide));
         window.addChild(block);
-        movewindow(rect.x(), rect.y());
-        flushwindow();
+        Backend::instance().moveWindow(rect.position());
+        Block::invalidateWindowOrigin();
+        Backend::instance().present();
         block->setPosition(iPoint());
         Window::pInstance_ = &window;
         window.root_ = block;
@@ -167,10 +146,11 @@ namespace GFt {
             return Window::pInstance_;
         if (!block) return nullptr;
         block->setRect(iRect(0, 0, 100_sw, 100_sh));
-        static Window window(100_sw, 100_sh, H(hide) | INIT_NOBORDER | INIT_TOPMOST);
+        static Window window(100_sw, 100_sh, H(hide) | Backend::NoBorder | Backend::TopMost);
         window.addChild(block);
-        movewindow(0, 0);
-        flushwindow();
+        Backend::instance().moveWindow(iPoint());
+        Block::invalidateWindowOrigin();
+        Backend::instance().present();
         block->setPosition(iPoint());
         Window::pInstance_ = &window;
         window.root_ = block;
@@ -181,10 +161,11 @@ namespace GFt {
             return Window::pInstance_;
         if (!block) return nullptr;
         auto rect = block->rect();
-        static Window window(rect.width(), rect.height(), H(hide) | INIT_TOPMOST);
+        static Window window(rect.width(), rect.height(), H(hide) | Backend::TopMost);
         window.addChild(block);
-        movewindow(rect.x(), rect.y());
-        flushwindow();
+        Backend::instance().moveWindow(rect.position());
+        Block::invalidateWindowOrigin();
+        Backend::instance().present();
         block->setPosition(iPoint());
         Window::pInstance_ = &window;
         window.root_ = block;
@@ -195,10 +176,11 @@ namespace GFt {
             return Window::pInstance_;
         if (!block) return nullptr;
         auto rect = block->rect();
-        static Window window(rect.width(), rect.height(), H(hide) | INIT_NOBORDER);
+        static Window window(rect.width(), rect.height(), H(hide) | Backend::NoBorder);
         window.addChild(block);
-        movewindow(rect.x(), rect.y());
-        flushwindow();
+        Backend::instance().moveWindow(rect.position());
+        Block::invalidateWindowOrigin();
+        Backend::instance().present();
         block->setPosition(iPoint());
         Window::pInstance_ = &window;
         window.root_ = block;
@@ -209,10 +191,11 @@ namespace GFt {
             return Window::pInstance_;
         if (!block) return nullptr;
         auto rect = block->rect();
-        static Window window(rect.width(), rect.height(), H(hide) | INIT_NOBORDER | INIT_TOPMOST);
+        static Window window(rect.width(), rect.height(), H(hide) | Backend::NoBorder | Backend::TopMost);
         window.addChild(block);
-        movewindow(rect.x(), rect.y());
-        flushwindow();
+        Backend::instance().moveWindow(rect.position());
+        Block::invalidateWindowOrigin();
+        Backend::instance().present();
         block->setPosition(iPoint());
         Window::pInstance_ = &window;
         window.root_ = block;
@@ -0,0 +1,123 @@
+#include <GraceFt/Animation.hpp>
+#include <GraceFt/Point.hpp>
+#include <iostream>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+using namespace GFt;
+using namespace std;
+using Clock = chrono::steady_clock;
+
+constexpr int frames = 100;
+
+// 创建 count 个时长为 1 秒的动画，模拟 frames 帧的更新并统计每个动画的平均更新耗时
+template<typename Type>
+void bench(const char* name, int count, const Type& from, const Type& to, TransFunc trans = {}) {
+    vector<Type> values(count, from);
+    vector<unique_ptr<Animation<Type>>> animations;
+    animations.reserve(count);
+    float duration = 1000.f;
+    for (int i = 0; i < count; i++) {
+        Setter<Type> setter = [&values, i](const Type& v) { values[i] = v; };
+        Initial<Type> initial = from;
+        animations.push_back(make_unique<Animation<Type>>(AnimationParams<Type>{
+            setter, initial, to, duration, trans }));
+        AnimationManager::getInstance().registerAnimation(animations.back().get());
+        animations.back()->setPlay();
+    }
+    auto& manager = AnimationManager::getInstance();
+    auto now = Clock::now();
+    auto start = Clock::now();
+    for (int f = 0; f < frames; f++) {
+        now += chrono::milliseconds(5);
+        manager.updateAll(now);
+    }
+    auto elapsed = chrono::duration<double, nano>(Clock::now() - start).count();
+    cout << name << " x" << count << ": " << elapsed / frames / 1e3 << " us/frame, "
+        << elapsed / frames / count << " ns/animation" << endl;
+
+    // 推进到动画结束，所有动画都应停在目标值
+    manager.updateAll(now + chrono::seconds(2));
+    int stopped = 0;
+    for (auto& animation : animations)
+        stopped += animation->isStopped();
+    cout << "  stopped " << stopped << "/" << count << endl;
+}
+
+// 工作线程注册动画、修改参数并播放，同时 UI 线程持续更新
+// 新的参数随请求传给 UI 线程，工作线程不直接写入正在更新的动画
+void threaded(int count) {
+    vector<float> values(count);
+    vector<unique_ptr<Animation<float>>> animations;
+    for (int i = 0; i < count; i++) {
+        Setter<float> setter = [&values, i](const float& v) { values[i] = v; };
+        Initial<float> initial = 0.f;
+        float target = 1.f, duration = 1000.f;
+        animations.push_back(make_unique<Animation<float>>(AnimationParams<float>{
+            setter, initial, target, duration }));
+    }
+    auto& manager = AnimationManager::getInstance();
+    atomic<bool> done = false;
+    thread worker([&] {
+        for (auto& animation : animations) {
+            manager.registerAnimation(animation.get());
+            animation->setDuration(20.f);
+            animation->setTarget(2.f);
+            animation->setPlay();
+        }
+        done = true;
+        });
+    int frames = 0;
+    while (true) {
+        // 先读取 done，保证本次更新已经应用了工作线程的全部请求
+        bool requested = done;
+        manager.updateAll(Clock::now());
+        frames++;
+        if (requested && none_of(animations.begin(), animations.end(), [](auto& a) { return a->isPlaying(); }))
+            break;
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    worker.join();
+    int finished = 0;
+    for (auto v : values)
+        finished += v == 2.f;
+    cout << "registered from worker x" << count << ": " << frames << " frames, "
+        << finished << "/" << count << " reached target" << endl;
+}
+
+int main() {
+    threaded(10'000);
+    for (bool async : { false, true }) {
+        AnimationManager::getInstance().setAsyncEvaluation(async);
+        cout << (async ? "async evaluation" : "sync evaluation") << endl;
+        bench<float>("Animation<float> overDamped(5)", 100'000, 0.f, 100.f, TransFuncs::overDamped(5.f));
+    }
+    AnimationManager::getInstance().setAsyncEvaluation(false);
+    for (int count : { 10'000, 100'000 }) {
+        bench<float>("Animation<float> linear", count, 0.f, 100.f);
+        bench<float>("Animation<float> bezier", count, 0.f, 100.f, TransFuncs::bezier);
+        bench<float>("Animation<float> power(2)", count, 0.f, 100.f, TransFuncs::power(2.f));
+        bench<fPoint>("Animation<fPoint> linear", count, fPoint(0, 0), fPoint(100, 50));
+    }
+
+    // 暂停与恢复
+    float value = 0;
+    Setter<float> setter = [&](const float& v) { value = v; };
+    Initial<float> initial = 0.f;
+    float target = 1.f, duration = 50.f;
+    Animation<float> animation({ setter, initial, target, duration });
+    AnimationManager::getInstance().registerAnimation(&animation);
+    animation.onFinished.connect([] { cout << "finished" << endl; });
+    animation.setPlay();
+    animation.setPause();
+    cout << "paused: " << animation.isPaused() << endl;
+    animation.setPlay();
+    while (animation.isPlaying())
+        AnimationManager::getInstance().updateAll(Clock::now());
+    cout << "value: " << value << endl;
+    return 0;
+}
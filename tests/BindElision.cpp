@@ -0,0 +1,62 @@
+#include <GraceFt/Graphics.h>
+#include <GraceFt/PixelMap.h>
+#include <iostream>
+
+using namespace GFt;
+using namespace GFt::literals;
+using namespace std;
+
+int main() {
+    BrushSet panel(0xeeeeee_rgb), bar(0x3080f0_rgb);
+    PenSet border(0x808080_rgb);
+
+    PixelMap target(iSize(320, 620));
+    Graphics g, other;
+    g.setTarget(&target);
+    other.setTarget(&target);
+    g.resetBindStatistics();
+    for (int i = 0; i < 20; i++) {
+        g.bindBrushSet(&panel);
+        g.bindPenSet(&border);
+        g.drawFillRect(fRect(10, 10 + i * 30.f, 300, 24));
+    }
+    auto stats = g.getBindStatistics();
+    cout << "same state: pen " << stats.penBinds << "/" << stats.penElided
+        << ", brush " << stats.brushBinds << "/" << stats.brushElided << endl;
+    bool ok = stats.penBinds == 1 && stats.penElided == 19 && stats.brushBinds == 1 && stats.brushElided == 19;
+
+    // 修改配置后版本号改变，必须重新绑定
+    g.resetBindStatistics();
+    panel.setFillStyle(0xdddddd_rgb);
+    g.bindBrushSet(&panel);
+    g.bindBrushSet(&panel);
+    stats = g.getBindStatistics();
+    cout << "after change: brush " << stats.brushBinds << "/" << stats.brushElided << endl;
+    ok = ok && stats.brushBinds == 1 && stats.brushElided == 1;
+
+    // 另一个绘图设备在同一目标上绑定了其他画刷，状态记录在目标上，原绘图设备需要重新绑定
+    g.resetBindStatistics();
+    other.bindBrushSet(&bar);
+    g.bindBrushSet(&panel);
+    stats = g.getBindStatistics();
+    cout << "shared target: brush " << stats.brushBinds << "/" << stats.brushElided << endl;
+    ok = ok && stats.brushBinds == 1 && stats.brushElided == 0;
+
+    // 纹理被重新赋值后纹理画刷的版本号改变，必须重新绑定
+    Texture texture{ PixelMap(iSize(8, 8)) }, replacement{ PixelMap(iSize(4, 4)) };
+    BrushSet pattern(0x0_rgb);
+    pattern.setTexture(texture, fRect(0, 0, 8, 8));
+    g.bindBrushSet(&pattern);
+    g.resetBindStatistics();
+    g.bindBrushSet(&pattern);
+    auto before = pattern.version();
+    texture = replacement;
+    g.bindBrushSet(&pattern);
+    g.bindBrushSet(&pattern);
+    stats = g.getBindStatistics();
+    cout << "texture change: brush " << stats.brushBinds << "/" << stats.brushElided << endl;
+    ok = ok && pattern.version() != before && stats.brushBinds == 1 && stats.brushElided == 2;
+
+    cout << (ok ? "passed" : "failed") << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+#include <GraceFt/Application.h>
+#include <iostream>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace GFt;
+using namespace std;
+using Clock = chrono::steady_clock;
+
+constexpr int block_count = 10'000;
+
+template<typename Func>
+double measure(Func&& func) {
+    auto start = Clock::now();
+    func();
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// 以 width 个分支、每个分支深 block_count / width 层的形状构建对象树，
+// 统计加入、随机修改层级、绘制一帧与逐个移除的耗时
+void bench(Block& root, int width) {
+    mt19937 rng(42);
+    uniform_int_distribution<int> zIndex(-8, 8);
+    vector<unique_ptr<Block>> blocks;
+    blocks.reserve(block_count);
+    auto depth = block_count / width;
+    auto add = measure([&] {
+        for (int i = 0; i < block_count; i++) {
+            Block* parent = i % depth == 0 ? &root : blocks.back().get();
+            blocks.push_back(make_unique<Block>(iRect(1, 1, 16, 16), parent, zIndex(rng)));
+        }
+        });
+    auto reorder = measure([&] {
+        for (int i = 0; i < block_count; i++)
+            blocks[rng() % blocks.size()]->setZIndex(zIndex(rng));
+        });
+    Application::renderFrame(true);
+    auto draw = measure([&] { Application::renderFrame(true); });
+    auto remove = measure([&] {
+        for (auto& block : blocks)
+            block->setParent(nullptr);
+        });
+    cout << width << " branches x " << depth << " levels: add " << add << " ms, setZIndex " << reorder
+        << " ms, full frame " << draw << " ms, remove " << remove << " ms" << endl;
+}
+
+int main() {
+    // 窗口不显示，绘制只发生在 EGE 的后台缓冲区中
+    Block root(iRect(0, 0, 640, 480));
+    Window* window = Window::createWindow(&root, true);
+    Application app(window);
+    bench(root, block_count);
+    bench(root, 100);
+    bench(root, 10);
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <GraceFt/Application.h>
+#include <GraceFt/HeadlessBackend.h>
+#include <GraceFt/Graphics.h>
+#include <iostream>
+#include <memory>
+
+using namespace GFt;
+using namespace std;
+
+// 以当前颜色填充自身；changeOnDraw 为 true 时在下一次绘制中切换颜色并请求重绘，模拟绘制期间改变状态的控件
+class Swatch : public Block {
+public:
+    Color color;
+    bool changeOnDraw = false;
+
+    Swatch(const iRect& rect, Block* parent, const Color& color) : Block(rect, parent), color(color) {}
+
+protected:
+    void onDraw(Graphics& g) override {
+        BrushSet brush(color);
+        g.bindBrushSet(&brush);
+        g.drawFillRect(fRect(fPoint(), fSize(rect().size())));
+        if (changeOnDraw) {
+            changeOnDraw = false;
+            color = Color(0, 0, 255);
+            update();
+        }
+    }
+};
+
+int main() {
+    int failures = 0;
+    auto check = [&](bool ok, const char* what) {
+        cout << (ok ? "  ok    " : "  FAIL  ") << what << endl;
+        failures += !ok;
+    };
+
+    auto backend = make_unique<HeadlessBackend>();
+    auto headless = backend.get();
+    Backend::install(std::move(backend));
+
+    Block root(iRect(0, 0, 64, 64));
+    Window* window = Window::createWindow(&root, true);
+    Application app(window);
+    Block parent(iRect(8, 8, 48, 48), &root);
+    parent.setCacheMode(Block::CacheMode::Cached);
+    Swatch child(iRect(8, 8, 16, 16), &parent, Color(255, 0, 0));
+    auto pixel = [&] { return headless->framebuffer().view().pixels(20)[20] & 0xffffff; };
+
+    Application::renderFrame(true);
+    check(pixel() == 0xff0000, "cached child drawn");
+
+    // 父对象本身没有改变，只有子对象被标记重绘
+    child.color = Color(0, 255, 0);
+    child.update();
+    check(parent.isDirty(), "dirty child marks the cached parent");
+    Application::renderFrame();
+    check(pixel() == 0x00ff00, "dirty child under a clean cached parent redrawn");
+
+    // 子对象在绘制缓存期间再次改变，缓存不应被当作有效
+    child.changeOnDraw = true;
+    child.update();
+    Application::renderFrame();
+    check(parent.isDirty(), "change during the cache redraw keeps the parent dirty");
+    Application::renderFrame();
+    check(pixel() == 0x0000ff, "change during the cache redraw shown next frame");
+
+    cout << (failures ? "failed" : "passed") << endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,121 @@
+#include <GraceFt/Channel.hpp>
+#include <GraceFt/SpscChannel.hpp>
+#include <GraceFt/MpscChannel.hpp>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+
+using namespace GFt;
+using namespace std;
+using Clock = chrono::steady_clock;
+
+constexpr int total_msgs = 1'000'000;
+
+// 吞吐量测试：producers 个生产者共发送 total_msgs 条消息，consumers 个消费者接收
+// 每个消费者收到 -1 时退出
+template<typename Chan>
+void throughput(const char* name, Chan& channel, int producers, int consumers) {
+    atomic<int> received = 0;
+    vector<thread> threads;
+    auto start = Clock::now();
+    for (int i = 0; i < consumers; i++)
+        threads.emplace_back([&] {
+        while (channel.recv() >= 0)
+            received++;
+            });
+    vector<thread> senders;
+    for (int i = 0; i < producers; i++)
+        senders.emplace_back([&, i] {
+        for (int j = i; j < total_msgs; j += producers)
+            channel.send(j);
+            });
+    for (auto& t : senders)
+        t.join();
+    for (int i = 0; i < consumers; i++)
+        channel.send(-1);
+    for (auto& t : threads)
+        t.join();
+    auto ms = chrono::duration<double, milli>(Clock::now() - start).count();
+    cout << name << " " << producers << ":" << consumers
+        << "  " << received << " msgs in " << ms << " ms, "
+        << received / ms * 1e-3 << " M msg/s" << endl;
+}
+
+// 批量吞吐量测试：以 batch 个元素为单位收发
+void batchThroughput(size_t capacity, size_t batch) {
+    Channel<int> channel(capacity);
+    auto start = Clock::now();
+    thread sender([&] {
+        vector<int> items(batch);
+        for (int i = 0; i < total_msgs; i += batch) {
+            iota(items.begin(), items.end(), i);
+            channel.send_n(items.begin(), min<size_t>(batch, total_msgs - i));
+        }
+        channel.close();
+        });
+    vector<int> items(batch);
+    size_t received = 0;
+    try {
+        while (true)
+            received += channel.recv_n(items.begin(), batch);
+    }
+    catch (const ChannelClosed&) {}
+    sender.join();
+    auto ms = chrono::duration<double, milli>(Clock::now() - start).count();
+    cout << "Channel batch=" << batch << " 1:1  " << received << " msgs in " << ms
+        << " ms, " << received / ms * 1e-3 << " M msg/s" << endl;
+}
+
+// 延迟测试：一来一回的往返时间
+void latency(int rounds) {
+    Channel<Clock::time_point> ping, pong;
+    thread echo([&] {
+        for (int i = 0; i < rounds; i++)
+            pong.send(ping.recv());
+        });
+    vector<double> samples;
+    samples.reserve(rounds);
+    for (int i = 0; i < rounds; i++) {
+        ping.send(Clock::now());
+        auto sent = pong.recv();
+        samples.push_back(chrono::duration<double, micro>(Clock::now() - sent).count());
+    }
+    echo.join();
+    sort(samples.begin(), samples.end());
+    cout << "round trip: p50=" << samples[rounds / 2] << " us, p99="
+        << samples[rounds * 99 / 100] << " us" << endl;
+}
+
+int main() {
+    // 每一侧至少 2 个线程，核心较少的机器上也能测到多生产者与多消费者的竞争
+    int side = max(2, static_cast<int>(thread::hardware_concurrency()) / 2);
+    cout << "hardware threads: " << thread::hardware_concurrency() << endl;
+    for (size_t capacity : { 1ull, 64ull, 1024ull }) {
+        cout << "capacity " << capacity << endl;
+        Channel<int> c1(capacity), c2(capacity), c3(capacity);
+        throughput("Channel", c1, 1, 1);
+        throughput("Channel", c2, side, 1);
+        throughput("Channel", c3, side, side);
+    }
+    for (size_t batch : { 1ull, 16ull, 256ull })
+        batchThroughput(1024, batch);
+    auto spsc = make_unique<SpscChannel<int, 1024>>();
+    throughput("SpscChannel", *spsc, 1, 1);
+    MpscChannel<int> mpsc1(1024), mpsc2(1024);
+    throughput("MpscChannel", mpsc1, 1, 1);
+    throughput("MpscChannel", mpsc2, side, 1);
+    latency(10000);
+
+    // 仅可移动类型
+    Channel<unique_ptr<int>> moveOnly(4);
+    moveOnly.send(make_unique<int>(42));
+    cout << "move-only: " << *moveOnly.recv() << endl;
+    unique_ptr<int> out;
+    cout << "recv_for on empty channel: "
+        << moveOnly.recv_for(out, 10ms) << endl;
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include <GraceFt/Channel.hpp>
+#include <thread>
+#include <vector>
+#include <string>
+#include <iostream>
+#include <chrono>
+
+using namespace GFt;
+using namespace std::chrono_literals;
+using namespace std;
+
+int main() {
+    Channel<int> numbers(16);
+    Channel<std::string> texts(16);
+
+    std::thread producer([&] {
+        std::vector<int> batch{ 1, 2, 3, 4, 5 };
+        numbers.send_n(batch.begin(), batch.size());
+        std::this_thread::sleep_for(50ms);
+        texts.send("hello");
+        std::this_thread::sleep_for(50ms);
+        numbers.close();
+        texts.close();
+        });
+
+    // 批量接收
+    std::vector<int> buffer(8);
+    auto n = numbers.recv_n(buffer.begin(), buffer.size());
+    std::cout << "recv_n got " << n << " items:";
+    for (std::size_t i = 0; i < n; i++)
+        std::cout << " " << buffer[i];
+    std::cout << std::endl;
+
+    // 同时等待两个通道
+    try {
+        while (true) {
+            int index = select_for(20ms,
+                onRecv(numbers, [](int v) { std::cout << "number " << v << std::endl; }),
+                onRecv(texts, [](std::string s) { std::cout << "text " << s << std::endl; }));
+            if (index < 0)
+                std::cout << "timeout" << std::endl;
+        }
+    }
+    catch (const ChannelClosed&) {
+        std::cout << "all channels closed" << std::endl;
+    }
+    producer.join();
+    return 0;
+}
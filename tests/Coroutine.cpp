@@ -0,0 +1,99 @@
+#include <GraceFt/Application.h>
+#include <GraceFt/Coroutine.hpp>
+#include <GraceFt/HeadlessBackend.h>
+#include <thread>
+#include <iostream>
+#include <memory>
+
+using namespace GFt;
+using namespace std;
+
+Channel<int> values(8);
+Signal<int> clicked;
+Signal<void> released;
+HeadlessBackend* headless = nullptr;
+bool ok = true;
+bool finished = false;
+
+void check(bool condition, const char* what) {
+    cout << what << ": " << (condition ? "ok" : "FAILED") << endl;
+    ok = ok && condition;
+}
+
+Task<int> countdown(int from) {
+    for (int i = from; i > 0; --i)
+        co_await delay(10);
+    co_return from;
+}
+
+Task<> script() {
+    int n = co_await countdown(3);
+    check(n == 3, "countdown");
+    co_await nextFrame();
+    // 从工作线程接收数据，等待期间不阻塞 UI 线程
+    std::thread([] {
+        for (int i = 0; i < 3; ++i)
+            values.send(i * 10);
+        }).detach();
+    int sum = 0;
+    for (int i = 0; i < 3; ++i)
+        sum += co_await recvAsync(values);
+    check(sum == 30, "received from channel");
+    // 点击在下一帧才被处理，此时协程已在等待信号
+    headless->click(iPoint(42, 7));
+    int value = co_await clicked;
+    check(value == 42, "resumed with signal value");
+    headless->click(iPoint(10, 10));
+    co_await released;
+    check(clicked.empty() && released.empty(), "slots disconnected after resuming");
+    finished = true;
+    Application::exit();
+}
+
+class Clickable : public Block {
+protected:
+    void onMouseButtonPress(MouseButtonPressEvent* event) override {
+        clicked(event->position().x());
+        Block::onMouseButtonPress(event);
+    }
+    void onMouseButtonRelease(MouseButtonReleaseEvent* event) override {
+        released();
+        Block::onMouseButtonRelease(event);
+    }
+public:
+    Clickable(iRect rect) : Block(rect) {}
+};
+
+int main() {
+    auto backend = make_unique<HeadlessBackend>();
+    headless = backend.get();
+    Backend::install(std::move(backend));
+
+    // 等待体在恢复前被销毁(如协程帧被销毁)时断开槽函数，信号再发出时不会恢复已销毁的协程
+    {
+        auto awaiter = operator co_await(clicked);
+        awaiter.await_suspend(std::noop_coroutine());
+    }
+    {
+        auto awaiter = operator co_await(released);
+        awaiter.await_suspend(std::noop_coroutine());
+    }
+    check(clicked.empty() && released.empty(), "destroyed awaiters disconnect");
+
+    Clickable root(iRect{ 0, 0, 400, 300 });
+    auto window = Window::createWindow(&root);
+    Application app(window);
+    Application::setFps(120);
+    // 防止等待的事件没有到来时测试永不结束
+    int frames = 0;
+    Application::onEventCall.connect([&] {
+        if (++frames == 1200)
+            Application::exit();
+        });
+    auto task = script();
+    window->show();
+    app.exec();
+    check(finished, "script finished");
+    cout << (ok ? "passed" : "failed") << endl;
+    return ok ? 0 : 1;
+}
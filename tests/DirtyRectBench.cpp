@@ -0,0 +1,48 @@
+#include <GraceFt/Application.h>
+#include <GraceFt/widget/Label.h>
+#include <iostream>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace GFt;
+using namespace GFt::Widget;
+using namespace std;
+using Clock = chrono::steady_clock;
+
+constexpr int columns = 40, rows = 25;
+constexpr int cellWidth = 25, cellHeight = 32;
+constexpr int frames = 200;
+
+// 每帧移动一个标签并修改另一个标签的文本，返回每帧的平均绘制耗时(微秒)
+double run(vector<unique_ptr<Label>>& labels, Label& moving, bool full) {
+    Application::renderFrame(true);
+    auto start = Clock::now();
+    for (int f = 0; f < frames; f++) {
+        moving.setX(f * 4 % (columns * cellWidth));
+        labels[f % labels.size()]->text() = to_wstring(f % 100);
+        Application::renderFrame(full);
+    }
+    return chrono::duration<double, micro>(Clock::now() - start).count() / frames;
+}
+
+int main() {
+    // 窗口不显示，绘制只发生在 EGE 的后台缓冲区中
+    Block root(iRect(0, 0, columns * cellWidth, rows * cellHeight));
+    Window* window = Window::createWindow(&root, true);
+    Application app(window);
+
+    vector<unique_ptr<Label>> labels;
+    for (int i = 0; i < columns * rows; i++)
+        labels.push_back(make_unique<Label>(to_wstring(i % 100),
+            iRect((i % columns) * cellWidth, (i / columns) * cellHeight, cellWidth, cellHeight), &root));
+    Label moving(L"*", iRect(0, rows * cellHeight / 2, cellWidth, cellHeight), &root, 1);
+
+    auto full = run(labels, moving, true);
+    auto partial = run(labels, moving, false);
+    cout << labels.size() << " labels, 1 moving, 1 changing text per frame" << endl;
+    cout << "  full redraw:    " << full << " us/frame" << endl;
+    cout << "  partial redraw: " << partial << " us/frame (" << full / partial << "x)" << endl;
+    return 0;
+}
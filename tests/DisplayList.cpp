@@ -0,0 +1,90 @@
+#include <GraceFt/DisplayList.h>
+#include <GraceFt/Graphics.h>
+#include <GraceFt/PixelMap.h>
+#include <iostream>
+
+using namespace GFt;
+using namespace GFt::literals;
+using namespace std;
+
+// 与控件的绘制函数相同，每个图元之前都绑定一次画刷与画笔
+void drawWidgets(Graphics& g, BrushSet& panel, BrushSet& bar, PenSet& border, TextSet& text) {
+    for (int i = 0; i < 20; i++) {
+        g.bindBrushSet(&panel);
+        g.bindPenSet(&border);
+        g.drawFillRect(fRect(10, 10 + i * 30.f, 300, 24));
+        g.bindBrushSet(&bar);
+        g.bindPenSet(&border);
+        g.drawFillRoundRect(fRoundRect(fRect(14, 14 + i * 30.f, 10.f * i, 16), 4));
+        g.bindTextSet(&text);
+        g.drawText(L"item", fPoint(240, 12 + i * 30.f));
+    }
+}
+
+// 与 HSlider::onDraw() 相同，在两次绘制之间修改同一个画刷与画笔再重新绑定
+void drawSlider(Graphics& g, BrushSet& brush, PenSet& pen) {
+    brush.setFillStyle(0xdddddd_rgb);
+    g.bindBrushSet(&brush);
+    g.drawFillRect(fRect(0, 0, 200, 20));
+    pen.setLineWidth(6);
+    pen.setColor(0x3080f0_rgb);
+    g.bindPenSet(&pen);
+    g.drawLine(fLine(fPoint(10, 10), fPoint(120, 10)));
+    pen.setColor(0xa0a0a0_rgb);
+    g.bindPenSet(&pen);
+    g.drawLine(fLine(fPoint(120, 10), fPoint(190, 10)));
+    brush.setFillStyle(0xf04030_rgb);
+    g.bindBrushSet(&brush);
+    g.drawFillCircle(fCircle(fPoint(120, 10), 8));
+}
+
+// 回放的结果应与直接绘制逐像素相同
+bool replayMatchesDirect() {
+    BrushSet brush(0x0_rgb);
+    PenSet pen(0x0_rgb);
+    PixelMap direct(iSize(200, 20)), replayed(iSize(200, 20));
+    Graphics g;
+    g.setBackgroundColor(0xffffff_rgb);
+    g.setTarget(&direct);
+    g.clear();
+    drawSlider(g, brush, pen);
+    g.setTarget(&replayed);
+    g.clear();
+    DisplayList list;
+    g.beginRecording(&list);
+    drawSlider(g, brush, pen);
+    g.endRecording();
+    list.replay(g);
+    g.setTarget(nullptr);
+
+    int mismatches = 0;
+    for (int y = 0; y < 20; y++)
+        for (int x = 0; x < 200; x++)
+            mismatches += direct.view().pixels(y)[x] != replayed.view().pixels(y)[x];
+    cout << "replay vs direct: " << mismatches << " mismatched pixels" << endl;
+    return mismatches == 0;
+}
+
+int main() {
+    BrushSet panel(0xeeeeee_rgb), bar(0x3080f0_rgb);
+    PenSet border(0x808080_rgb);
+    TextSet text(0x202020_rgb);
+
+    PixelMap target(iSize(320, 620));
+    Graphics g;
+    g.setTarget(&target);
+    DisplayList list;
+    g.beginRecording(&list);
+    drawWidgets(g, panel, bar, border, text);
+    g.endRecording();
+    auto stats = list.replay(g);
+
+    cout << "commands " << stats.commands << ", draw calls " << stats.drawCalls
+        << ", state changes " << stats.stateChanges << ", elided " << stats.elided
+        << ", " << list.bytes() << " bytes" << endl;
+    bool ok = list.size() == 160 && stats.drawCalls == 60 && stats.stateChanges + stats.elided == stats.commands - stats.drawCalls
+        && stats.elided > stats.stateChanges;
+    ok = replayMatchesDirect() && ok;
+    cout << (ok ? "passed" : "failed") << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,71 @@
+#include <GraceFt/Application.h>
+#include <GraceFt/HeadlessBackend.h>
+#include <GraceFt/BlockFocus.h>
+#include <iostream>
+#include <memory>
+
+using namespace GFt;
+using namespace std;
+
+// 统计收到的输入事件
+class Probe : public Block {
+public:
+    int moves = 0, samples = 0, presses = 0, releases = 0, keys = 0;
+    wstring text;
+    iPoint lastMove;
+
+    Probe(const iRect& rect) : Block(rect) {}
+
+protected:
+    void onMouseMove(MouseMoveEvent* event) override {
+        moves++;
+        samples += static_cast<int>(event->history().size());
+        lastMove = event->position();
+    }
+    void onMouseButtonPress(MouseButtonPressEvent* event) override {
+        presses++;
+        Block::onMouseButtonPress(event);   // 保留默认行为：获取焦点并阻止窗口抢走焦点
+    }
+    void onMouseButtonRelease(MouseButtonReleaseEvent* event) override { releases++; }
+    void onKeyPress(KeyPressEvent* event) override { keys++; }
+    void onTextInput(TextInputEvent* event) override { text += static_cast<wchar_t>(event->character()); }
+};
+
+int main() {
+    auto backend = make_unique<HeadlessBackend>();
+    auto headless = backend.get();
+    Backend::install(std::move(backend));
+
+    Probe root(iRect(0, 0, 320, 240));
+    Window* window = Window::createWindow(&root);
+    Application app(window);
+    Application::setLoopMode(Application::LoopMode::OnDemand);
+    BlockFocusManager::setFocusOn(&root);
+
+    // 连续的移动应合并为一个事件，按键前后的移动分属两个事件
+    for (int i = 0; i < 100; i++)
+        headless->moveMouse(iPoint(i, i));
+    headless->click(iPoint(100, 100));
+    headless->moveMouse(iPoint(50, 60));
+    headless->pressKey(Key::A);
+    headless->typeText(L"GraceFt");
+
+    // 第一帧处理输入，之后没有待处理的工作，主循环会休眠，因此在下一帧开始时退出
+    int frames = 0;
+    Application::onEventCall.connect([&] {
+        if (++frames == 2)
+            Application::exit();
+        });
+    Application::post([] { Application::requestFrame(); });
+    app.exec();
+
+    bool ok = root.moves == 2 && root.samples == 101 && root.lastMove == iPoint(50, 60)
+        && root.presses == 1 && root.releases == 1 && root.keys == 1 && root.text == L"GraceFt"
+        && Application::getAbsoluteMousePosition() == iPoint(50, 60)
+        && headless->presentedFrames() > 0;
+    cout << "moves " << root.moves << ", samples " << root.samples << ", presses " << root.presses
+        << ", releases " << root.releases << ", keys " << root.keys
+        << ", frames presented " << headless->presentedFrames() << endl;
+    cout << (ok ? "passed" : "failed") << endl;
+    return ok ? 0 : 1;
+}
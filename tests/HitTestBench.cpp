@@ -0,0 +1,68 @@
+#include <GraceFt/Application.h>
+#include <GraceFt/Geometry.hpp>
+#include <iostream>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace GFt;
+using namespace std;
+using Clock = chrono::steady_clock;
+
+constexpr int queries = 100'000;
+
+// 原先的命中测试：按顺序逐个比较子对象的区域
+Block* linearChildAt(const vector<unique_ptr<Block>>& children, const iPoint& pos) {
+    for (auto& child : children)
+        if (contains(iRect{ child->absolutePosition(), child->rect().size() }, pos))
+            return child.get();
+    return nullptr;
+}
+
+// 在 side x side 的网格中放置 count 个 cell 像素见方、彼此部分重叠的子对象，比较两种命中测试
+void bench(Block& root, int count, int cell) {
+    vector<unique_ptr<Block>> children;
+    int side = 1;
+    while (side * side < count)
+        side++;
+    for (int i = 0; i < count; i++)
+        children.push_back(make_unique<Block>(
+            iRect((i % side) * cell, (i / side) * cell, cell + cell / 2, cell + cell / 2), &root, i % 3));
+    // 同层级时先加入的对象优先，结果应与按排列顺序扫描一致，因此按排列顺序重排后再比较
+    stable_sort(children.begin(), children.end(),
+        [](const auto& a, const auto& b) { return a->getZIndex() > b->getZIndex(); });
+
+    mt19937 rng(42);
+    uniform_int_distribution<int> coord(0, side * cell);
+    vector<iPoint> points;
+    auto origin = root.absolutePosition();
+    for (int i = 0; i < queries; i++)
+        points.push_back(origin + iPoint(coord(rng), coord(rng)));
+
+    int mismatches = 0;
+    for (int i = 0; i < 1000; i++)
+        mismatches += root.childAt(points[i]) != linearChildAt(children, points[i]);
+
+    size_t hits = 0;
+    auto start = Clock::now();
+    for (auto& p : points)
+        hits += linearChildAt(children, p) != nullptr;
+    auto linear = chrono::duration<double, nano>(Clock::now() - start).count() / queries;
+    start = Clock::now();
+    for (auto& p : points)
+        hits += root.childAt(p) != nullptr;
+    auto grid = chrono::duration<double, nano>(Clock::now() - start).count() / queries;
+    cout << count << " children: linear " << linear << " ns/query, childAt " << grid
+        << " ns/query, " << mismatches << " mismatches" << endl;
+}
+
+int main() {
+    // 窗口不显示，只用于确定客户区在屏幕上的位置
+    Block root(iRect(0, 0, 800, 800));
+    Window* window = Window::createWindow(&root, true);
+    Application app(window);
+    for (int count : { 16, 256, 1'000, 10'000 })
+        bench(root, count, 800 / 100);
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include <GraceFt/ImageOps.h>
+#include <GraceFt/ThreadPool.h>
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace GFt;
+using namespace std;
+using Clock = chrono::steady_clock;
+
+constexpr int width = 3840, height = 2160;
+
+struct Image {
+    int w, h;
+    PixelFormat format;
+    vector<uint8_t> bytes;
+    Image(int w, int h, PixelFormat format = PixelFormat::BGRA8)
+        : w(w), h(h), format(format), bytes(size_t(w) * h * bytesPerPixel(format)) {}
+    PixelView view() { return PixelView(bytes.data(), w, h, ptrdiff_t(w) * bytesPerPixel(format), format); }
+    ConstPixelView view() const { return ConstPixelView(bytes.data(), w, h, ptrdiff_t(w) * bytesPerPixel(format), format); }
+};
+
+// 模拟界面截图：渐变背景上的半透明色块
+Image screenshot(int w, int h, unsigned seed) {
+    Image image(w, h);
+    mt19937 rng(seed);
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+            image.view().setPixel(x, y, Color(x * 255 / w, y * 255 / h, 128, static_cast<GFt::byte>(rng() % 256)));
+    return image;
+}
+
+int maxDifference(const vector<uint8_t>& a, const vector<uint8_t>& b) {
+    int diff = 0;
+    for (size_t i = 0; i < a.size(); i++)
+        diff = max(diff, abs(int(a[i]) - int(b[i])));
+    return diff;
+}
+
+double bestOf(int repeat, const function<void()>& run) {
+    double best = 1e9;
+    for (int i = 0; i < repeat; i++) {
+        auto begin = Clock::now();
+        run();
+        best = min(best, chrono::duration<double, milli>(Clock::now() - begin).count());
+    }
+    return best;
+}
+
+// 逐像素的参考实现
+int checkCorrectness() {
+    int failures = 0;
+    auto report = [&](const char* name, int diff, int allowed) {
+        cout << "  " << name << ": max difference " << diff << (diff > allowed ? "  FAILED" : "") << endl;
+        failures += diff > allowed;
+    };
+    auto src = screenshot(253, 131, 1), dst = screenshot(253, 131, 2);
+
+    auto expected = src;
+    for (size_t i = 0; i < expected.bytes.size(); i += 4)
+        for (int c = 0; c < 3; c++)
+            expected.bytes[i + c] = uint8_t(lround(expected.bytes[i + c] * expected.bytes[i + 3] / 255.0));
+    auto premultiplied = src;
+    ImageOps::premultiply(premultiplied.view());
+    report("premultiply", maxDifference(premultiplied.bytes, expected.bytes), 0);
+
+    auto restored = premultiplied;
+    ImageOps::unpremultiply(restored.view());
+    int roundTrip = 0;
+    for (size_t i = 0; i < src.bytes.size(); i += 4)
+        if (src.bytes[i + 3] >= 128)
+            for (int c = 0; c < 3; c++)
+                roundTrip = max(roundTrip, abs(int(restored.bytes[i + c]) - int(src.bytes[i + c])));
+    report("unpremultiply (alpha >= 128)", roundTrip, 1);
+
+    expected = dst;
+    for (size_t i = 0; i < expected.bytes.size(); i += 4) {
+        double k = 180 / 255.0, a = premultiplied.bytes[i + 3] * k / 255;
+        for (int c = 0; c < 4; c++)
+            expected.bytes[i + c] = uint8_t(min(255.0, lround(premultiplied.bytes[i + c] * k) + expected.bytes[i + c] * (1 - a) + 0.5));
+    }
+    auto blended = dst;
+    ImageOps::blend(blended.view(), premultiplied.view(), 180);
+    report("blend", maxDifference(blended.bytes, expected.bytes), 1);
+
+    Image rgba(src.w, src.h, PixelFormat::RGBA8), back(src.w, src.h), gray(src.w, src.h, PixelFormat::Gray8);
+    ImageOps::convert(src.view(), rgba.view());
+    ImageOps::convert(rgba.view(), back.view());
+    int swapped = maxDifference(back.bytes, src.bytes);
+    for (size_t i = 0; i < src.bytes.size(); i += 4)
+        swapped = max(swapped, abs(int(rgba.bytes[i]) - int(src.bytes[i + 2])));
+    report("BGRA <-> RGBA", swapped, 0);
+    ImageOps::convert(src.view(), gray.view());
+    int grayDiff = 0;
+    for (int y = 0; y < src.h; y++)
+        for (int x = 0; x < src.w; x++) {
+            auto c = src.view().pixel(x, y);
+            grayDiff = max(grayDiff, abs(int(gray.view().pixel(x, y).red()) - (c.red() * 77 + c.green() * 150 + c.blue() * 29) / 256));
+        }
+    report("gray", grayDiff, 0);
+
+    auto keyed = src;
+    keyed.view().setPixel(3, 3, Color(10, 20, 30, 200));
+    ImageOps::removeColorKey(keyed.view(), Color(12, 18, 30), 2);
+    report("color key", keyed.view().pixels(3)[3] == 0 ? 0 : 255, 0);
+
+    // 缩小一半时面积平均等于 2x2 像素的平均值
+    Image half(src.w / 2, src.h / 2);
+    ImageOps::resize(src.view().sub(iRect(0, 0, half.w * 2, half.h * 2)), half.view(), ImageOps::Filter::Box);
+    int boxDiff = 0;
+    for (int y = 0; y < half.h; y++)
+        for (int x = 0; x < half.w; x++)
+            for (int c = 0; c < 4; c++) {
+                auto p = [&](int dx, int dy) { return int(src.view().row(y * 2 + dy)[(x * 2 + dx) * 4 + c]); };
+                boxDiff = max(boxDiff, abs(int(half.view().row(y)[x * 4 + c]) - int(lround((p(0, 0) + p(1, 0) + p(0, 1) + p(1, 1)) / 4.0))));
+            }
+    report("box resize", boxDiff, 1);
+
+    // 放大两倍时双线性插值的内部像素位于两个源像素的 1/4 与 3/4 处
+    Image twice(src.w * 2, src.h * 2);
+    ImageOps::resize(src.view(), twice.view(), ImageOps::Filter::Bilinear);
+    int bilinearDiff = 0;
+    for (int y = 1; y < twice.h - 1; y++)
+        for (int x = 1; x < twice.w - 1; x++)
+            for (int c = 0; c < 4; c++) {
+                auto sx = (x - 1) / 2, sy = (y - 1) / 2;
+                double fx = x % 2 ? 0.25 : 0.75, fy = y % 2 ? 0.25 : 0.75;
+                auto p = [&](int dx, int dy) { return double(src.view().row(sy + dy)[(sx + dx) * 4 + c]); };
+                double v = (p(0, 0) * (1 - fx) + p(1, 0) * fx) * (1 - fy) + (p(0, 1) * (1 - fx) + p(1, 1) * fx) * fy;
+                bilinearDiff = max(bilinearDiff, abs(int(twice.view().row(y)[x * 4 + c]) - int(lround(v))));
+            }
+    report("bilinear resize", bilinearDiff, 1);
+
+    Image blurred(src.w, src.h);
+    float sigma = 2.5f;
+    ImageOps::gaussianBlur(premultiplied.view(), blurred.view(), sigma);
+    int radius = int(ceil(sigma * 3)), blurDiff = 0;
+    vector<double> kernel;
+    double sum = 0;
+    for (int t = -radius; t <= radius; t++)
+        kernel.push_back(exp(-0.5 * t * t / (sigma * sigma))), sum += kernel.back();
+    for (int y = 0; y < src.h; y += 7)
+        for (int x = 0; x < src.w; x += 5)
+            for (int c = 0; c < 4; c++) {
+                double v = 0;
+                for (int j = -radius; j <= radius; j++)
+                    for (int i = -radius; i <= radius; i++) {
+                        int sx = clamp(x + i, 0, src.w - 1), sy = clamp(y + j, 0, src.h - 1);
+                        v += premultiplied.view().row(sy)[sx * 4 + c] * kernel[i + radius] * kernel[j + radius];
+                    }
+                blurDiff = max(blurDiff, abs(int(blurred.view().row(y)[x * 4 + c]) - int(lround(v / sum / sum))));
+            }
+    report("gaussian blur", blurDiff, 1);
+    return failures;
+}
+
+int main() {
+    cout << "correctness" << endl;
+    int failures = checkCorrectness();
+
+    auto src = screenshot(width, height, 3), dst = screenshot(width, height, 4);
+    Image work(width, height), rgba(width, height, PixelFormat::RGBA8), gray(width, height, PixelFormat::Gray8);
+    Image thumb(width / 8, height / 8), big(width, height);
+    ImageOps::premultiply(src.view());
+
+    vector<size_t> counts{ 1, 2, 4 };
+    if (thread::hardware_concurrency() > 4)
+        counts.push_back(thread::hardware_concurrency());
+    cout << width << "x" << height << ", best of 5 (ms)" << endl;
+    for (auto threads : counts) {
+        ThreadPool pool(threads);
+        cout << "  " << threads << " threads:" << endl;
+        auto print = [](const char* name, double ms) {
+            cout << "    " << name << ": " << ms << " ms, " << width * double(height) / ms / 1000 << " Mpx/s" << endl;
+        };
+        work = dst;
+        print("premultiply", bestOf(5, [&] { ImageOps::premultiply(work.view(), pool); }));
+        print("blend", bestOf(5, [&] { ImageOps::blend(work.view(), src.view(), 200, pool); }));
+        print("BGRA -> RGBA", bestOf(5, [&] { ImageOps::convert(src.view(), rgba.view(), pool); }));
+        print("BGRA -> gray", bestOf(5, [&] { ImageOps::convert(src.view(), gray.view(), pool); }));
+        print("box 1/8", bestOf(5, [&] { ImageOps::resize(src.view(), thumb.view(), ImageOps::Filter::Box, pool); }));
+        print("bilinear x8", bestOf(5, [&] { ImageOps::resize(thumb.view(), big.view(), ImageOps::Filter::Bilinear, pool); }));
+        print("gaussian sigma 4", bestOf(3, [&] { ImageOps::gaussianBlur(src.view(), work.view(), 4, pool); }));
+    }
+    cout << (failures ? "failed" : "passed") << endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,65 @@
+#include <GraceFt/PixelMap.h>
+#include <GraceFt/Graphics.h>
+#include <iostream>
+
+using namespace GFt;
+using namespace std;
+
+int main() {
+    int failures = 0;
+    auto check = [&](bool ok, const char* what) {
+        cout << (ok ? "  ok    " : "  FAIL  ") << what << endl;
+        failures += !ok;
+    };
+
+    PixelMap image(iSize(64, 32));
+    auto view = image.view();
+    for (int y = 0; y < view.height(); y++)
+        for (int x = 0; x < view.width(); x++)
+            view.setPixel(x, y, Color(x * 4, y * 8, 0));
+    check(view.format() == PixelFormat::BGRA8 && view.stride() == 64 * 4, "view layout");
+    check(view.pixels(3)[5] == 0xff141800u, "pixel value as 0xAARRGGBB");
+
+    // 子视图与位图共享像素
+    auto part = image.view(iRect(60, 30, 10, 10));
+    check(part.width() == 4 && part.height() == 2, "sub view clipped to bounds");
+    part.setPixel(0, 0, Color(1, 2, 3));
+    check(image.view().pixel(60, 30).blue() == 3, "sub view writes through");
+
+    // 交出过可写视图的位图在复制时复制像素，此后通过视图写入不影响副本
+    auto early = image.view();
+    PixelMap later = image;
+    const PixelMap& constLater = later;
+    early.setPixel(1, 1, Color(9, 9, 9));
+    check(!later.isShared() && constLater.view().pixel(1, 1).red() != 9, "view taken before a copy does not alias it");
+    check(static_cast<const PixelMap&>(image).view().pixel(1, 1).red() == 9, "view still writes the original");
+
+    // 未交出可写视图的副本共享像素，写入时才复制
+    PixelMap source = image;
+    const PixelMap& constSource = source;
+    PixelMap copy = source;
+    const PixelMap& constCopy = copy;
+    check(copy.isShared() && constCopy.view().data() == constSource.view().data(), "copy shares pixels");
+    copy.view().setPixel(0, 0, Color(255, 255, 255));
+    check(!copy.isShared() && !source.isShared(), "write detaches");
+    check(constSource.view().pixel(0, 0).red() == 0 && constCopy.view().pixel(0, 0).red() == 255,
+        "original unchanged");
+    check(constCopy.view().pixels(31)[63] == constSource.view().pixels(31)[63], "detached copy keeps content");
+
+    // 作为绘图目标的位图不与副本共享像素
+    Graphics g;
+    g.setTarget(&source);
+    PixelMap snapshot = source;
+    check(!snapshot.isShared(), "copy of a drawing target is deep");
+    g.setTarget(nullptr);
+    PixelMap shared = source;
+    check(shared.isShared(), "copy shares again after the target is released");
+
+    // 像素被替换后不再视为交出过视图
+    image = PixelMap(iSize(8, 8));
+    PixelMap fresh = image;
+    check(fresh.isShared(), "replaced pixels are shared again");
+
+    cout << (failures ? "failed" : "passed") << endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+#include <GraceFt/Application.h>
+#include <GraceFt/Plan.h>
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <vector>
+
+using namespace GFt;
+using namespace std;
+using Clock = chrono::steady_clock;
+
+constexpr int timer_count = 10'000;
+
+// 手动触发一帧，返回该帧计划事件的处理耗时(微秒)
+double frame() {
+    auto start = Clock::now();
+    Application::onEventCall();
+    return chrono::duration<double, micro>(Clock::now() - start).count();
+}
+
+// 运行 ms 毫秒，统计每帧平均耗时
+void run(const char* name, int ms) {
+    auto end = Clock::now() + chrono::milliseconds(ms);
+    double total = 0, worst = 0;
+    int frames = 0;
+    while (Clock::now() < end) {
+        auto cost = frame();
+        total += cost;
+        worst = max(worst, cost);
+        frames++;
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    cout << name << ": " << frames << " frames, avg " << total / frames
+        << " us/frame, worst " << worst << " us" << endl;
+}
+
+int main() {
+    mt19937 rng(42);
+    uniform_real_distribution<float> delay(500.f, 5000.f);
+    int fired = 0;
+
+    // 10k 个均未到期的定时器：每帧只检查堆顶
+    vector<size_t> ids;
+    for (int i = 0; i < timer_count; i++)
+        ids.push_back(PlanEvent::add(delay(rng), [&] { fired++; }));
+    run("10k pending timers", 300);
+
+    // 取消全部定时器后，堆中残留的条目会在到期时被跳过
+    for (auto id : ids)
+        PlanEvent::remove(id);
+
+    // 10k 个会在 1 秒内陆续到期的定时器
+    uniform_real_distribution<float> soon(0.f, 1000.f);
+    for (int i = 0; i < timer_count; i++)
+        PlanEvent::add(soon(rng), [&] { fired++; });
+    run("10k timers firing within 1s", 1100);
+    cout << "fired: " << fired << " (expected " << timer_count << ")" << endl;
+
+    // 重复定时器与在回调中取消
+    int ticks = 0;
+    size_t repeating = 0;
+    repeating = PlanEvent::repeat(10.f, [&] {
+        if (++ticks == 20)
+            PlanEvent::remove(repeating);
+        });
+    run("repeating timer", 400);
+    cout << "ticks: " << ticks << " (expected 20)" << endl;
+
+    // 在回调中取消同一帧内即将执行的其它事件，三种事件各一组
+    int cancelled = 0;
+    size_t victims[3]{};
+    PlanEvent::add([&] { PlanEvent::remove(victims[0]); });
+    victims[0] = PlanEvent::add([&] { cancelled++; });
+    PlanEvent::add(0.f, [&] { PlanEvent::remove(victims[1]); });
+    victims[1] = PlanEvent::add(0.f, [&] { cancelled++; });
+    PlanEvent::add([] { return true; }, [&] { PlanEvent::remove(victims[2]); });
+    victims[2] = PlanEvent::add([] { return true; }, [&] { cancelled++; });
+    frame();
+    frame();
+    cout << "cancelled events fired: " << cancelled << " (expected 0)" << endl;
+
+    // 帧预算：2000 个各耗时约 20us 的事件，不限预算时集中在一帧执行
+    auto busy = [] {
+        auto until = Clock::now() + chrono::microseconds(20);
+        while (Clock::now() < until);
+        };
+    int idles = 0;
+    for (float budget : { 0.f, 4.f }) {
+        PlanEvent::setFrameBudget(budget);
+        for (int i = 0; i < 2000; i++)
+            PlanEvent::add(busy, i % 4 ? PlanEvent::Priority::Normal : PlanEvent::Priority::Low);
+        PlanEvent::add([&] { idles++; }, PlanEvent::Priority::Idle);
+        cout << "budget " << budget << " ms: ";
+        run("2000 queued tasks", 200);
+    }
+    cout << "idle tasks: " << idles << " (expected 2)" << endl;
+    PlanEvent::setFrameBudget(0);
+
+    // 对照：以条件事件逐帧轮询实现的 10k 个延时事件
+    for (int i = 0; i < timer_count; i++) {
+        auto target = Clock::now() + chrono::milliseconds(5000);
+        PlanEvent::add([=] { return Clock::now() >= target; }, [] {});
+    }
+    run("10k polled conditions", 300);
+    return cancelled == 0 ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+#include <GraceFt/Rasterizer.h>
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace GFt;
+using namespace std;
+using Clock = chrono::steady_clock;
+
+constexpr int width = 1920, height = 1080;
+constexpr float pi = 3.14159265f;
+
+void circle(Rasterizer& r, fPoint c, float radius, int segments = 64) {
+    r.moveTo(c + fPoint(radius, 0));
+    for (int i = 1; i < segments; i++)
+        r.lineTo(c + fPoint(radius * cos(2 * pi * i / segments), radius * sin(2 * pi * i / segments)));
+    r.close();
+}
+void star(Rasterizer& r, fPoint c, float radius) {
+    // 五角星的顶点按每次跳过一个的顺序相连，中心区域的环绕数为 2
+    r.moveTo(c + fPoint(0, -radius));
+    for (int i = 1; i < 5; i++) {
+        auto angle = -pi / 2 + 4 * pi * i / 5;
+        r.lineTo(c + fPoint(radius * cos(angle), radius * sin(angle)));
+    }
+    r.close();
+}
+int red(uint32_t p) { return (p >> 16) & 0xff; }
+
+// 检查覆盖率与填充规则
+int check(vector<uint32_t>& pixels, Rasterizer& r) {
+    int failures = 0;
+    auto expect = [&](bool ok, const char* what) {
+        if (!ok) {
+            failures++;
+            cout << "  failed: " << what << endl;
+        }
+    };
+    auto clear = [&] { fill(pixels.begin(), pixels.end(), 0xffffffffu); };
+    auto at = [&](int x, int y) { return pixels[y * width + x]; };
+
+    clear();
+    r.reset();
+    r.addPolygon(vector<fPoint>{ fPoint(10, 10), fPoint(110, 10), fPoint(110, 60), fPoint(10, 60) }.data(), 4);
+    r.fill(Color(0, 0, 0));
+    int black = 0, partial = 0;
+    for (auto p : pixels)
+        black += p == 0xff000000u, partial += p != 0xff000000u && p != 0xffffffffu;
+    expect(black == 100 * 50 && partial == 0, "pixel aligned rect covers exactly its pixels");
+
+    clear();
+    r.reset();
+    r.addPolygon(vector<fPoint>{ fPoint(10.5f, 10), fPoint(20.5f, 10), fPoint(20.5f, 20), fPoint(10.5f, 20) }.data(), 4);
+    r.fill(Color(0, 0, 0));
+    expect(abs(red(at(10, 15)) - 128) <= 1 && red(at(15, 15)) == 0 && abs(red(at(20, 15)) - 128) <= 1,
+        "half covered pixels are blended by half");
+
+    clear();
+    r.reset();
+    star(r, fPoint(200, 200), 100);
+    r.fill(Color(0, 0, 0), Rasterizer::FillRule::NonZero);
+    expect(red(at(200, 200)) == 0, "non-zero fills the center of a star");
+    clear();
+    r.fill(Color(0, 0, 0), Rasterizer::FillRule::EvenOdd);
+    expect(red(at(200, 200)) == 255 && red(at(200, 120)) == 0, "even-odd leaves the center of a star empty");
+
+    for (bool aa : { true, false }) {
+        clear();
+        r.setAntiAliasing(aa);
+        r.reset();
+        circle(r, fPoint(500, 500), 100, 256);
+        r.fill(Color(0, 0, 0));
+        double area = 0;
+        for (auto p : pixels)
+            area += (255 - red(p)) / 255.0;
+        expect(abs(area - pi * 100 * 100) < pi * 100 * 100 * 0.002, aa ? "anti-aliased circle area" : "aliased circle area");
+    }
+    r.setAntiAliasing(true);
+
+    clear();
+    r.setClip(iRect(0, 0, 50, 50));
+    r.reset();
+    circle(r, fPoint(50, 50), 40);
+    r.fill(Color(0, 0, 0));
+    expect(red(at(45, 45)) == 0 && red(at(55, 55)) == 255, "fill is clipped");
+
+    // 斜边穿过裁剪边界时，裁剪区域内的像素应与不裁剪时完全相同
+    vector<fPoint> wedge{ fPoint(20.3f, 300), fPoint(90.7f, 310.2f), fPoint(35.1f, 380.6f) };
+    vector<uint32_t> unclipped;
+    for (int clipped = 0; clipped < 2; clipped++) {
+        clear();
+        r.setClip(clipped ? iRect(41, 0, 30, height) : iRect(0, 0, width, height));
+        r.reset();
+        r.addPolygon(wedge.data(), wedge.size());
+        r.fill(Color(0, 0, 0));
+        if (!clipped)
+            unclipped = pixels;
+    }
+    int edgeDiff = 0;
+    for (int y = 290; y < 390; y++)
+        for (int x = 41; x < 71; x++)
+            edgeDiff = max(edgeDiff, abs(red(at(x, y)) - red(unclipped[y * width + x])));
+    expect(edgeDiff == 0 && red(at(40, 340)) == 255 && red(at(71, 310)) == 255,
+        "anti-aliased edges crossing the clip keep their coverage");
+    r.setClip(iRect(0, 0, width, height));
+    return failures;
+}
+
+template<typename Func>
+double measure(int repeat, Func&& func) {
+    auto start = Clock::now();
+    for (int i = 0; i < repeat; i++)
+        func();
+    return chrono::duration<double, milli>(Clock::now() - start).count() / repeat;
+}
+
+int main() {
+    vector<uint32_t> pixels(width * height, 0xffffffffu);
+    Rasterizer r;
+    r.setTarget(pixels.data(), width, height, width);
+    auto failures = check(pixels, r);
+    cout << (failures ? "checks failed" : "checks passed") << endl;
+
+    auto report = [](const char* name, double ms, double pixelsPerCall) {
+        cout << "  " << name << ": " << ms << " ms, " << pixelsPerCall / ms / 1000 << " Mpixel/s" << endl;
+    };
+    for (bool aa : { true, false }) {
+        r.setAntiAliasing(aa);
+        cout << (aa ? "anti-aliased" : "aliased") << " " << width << "x" << height << endl;
+        r.reset();
+        r.addPolygon(vector<fPoint>{ fPoint(0, 0), fPoint(width, 0), fPoint(width, height), fPoint(0, height) }.data(), 4);
+        report("opaque full screen", measure(50, [&] { r.fill(Color(20, 40, 60)); }), double(width) * height);
+        report("translucent full screen", measure(50, [&] { r.fill(Color(20, 40, 60, 128)); }), double(width) * height);
+
+        mt19937 rng(42);
+        uniform_real_distribution<float> x(0, width), y(0, height);
+        r.reset();
+        for (int i = 0; i < 1000; i++)
+            circle(r, fPoint(x(rng), y(rng)), 20, 32);
+        report("1000 overlapping circles", measure(20, [&] { r.fill(Color(200, 40, 60, 200)); }), 1000 * pi * 400);
+        r.reset();
+        for (int i = 0; i < 1000; i++)
+            star(r, fPoint(x(rng), y(rng)), 30);
+        report("1000 even-odd stars", measure(20, [&] { r.fill(Color(60, 40, 200), Rasterizer::FillRule::EvenOdd); }), 1000 * 1100.0);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,45 @@
+#include <GraceFt/ThreadPool.h>
+#include <iostream>
+#include <numeric>
+#include <vector>
+#include <chrono>
+
+using namespace GFt;
+using namespace std;
+
+int main() {
+    auto& pool = ThreadPool::getInstance();
+    cout << "workers: " << pool.size() << endl;
+
+    auto answer = pool.submit([](int a, int b) { return a * b; }, 6, 7);
+    cout << "6 * 7 = " << answer.get() << endl;
+
+    auto failed = pool.submit([] { throw std::runtime_error("task failed"); });
+    try {
+        failed.get();
+    }
+    catch (const std::exception& e) {
+        cout << "exception: " << e.what() << endl;
+    }
+
+    // 并行计算平方和，并与串行结果比较
+    vector<long long> values(1 << 20);
+    auto t1 = chrono::steady_clock::now();
+    pool.parallelFor(0, values.size(), [&](size_t i) { values[i] = 1ll * i * i; });
+    auto t2 = chrono::steady_clock::now();
+    long long expect = 0;
+    for (size_t i = 0; i < values.size(); i++)
+        expect += 1ll * i * i;
+    cout << "parallelFor: " << (accumulate(values.begin(), values.end(), 0ll) == expect)
+        << " in " << chrono::duration<double, milli>(t2 - t1).count() << " ms" << endl;
+
+    // 嵌套并行
+    vector<int> rows(64, 0);
+    pool.parallelFor(0, rows.size(), [&](size_t r) {
+        atomic<int> sum = 0;
+        pool.parallelFor(0, 1000, [&](size_t) { sum++; });
+        rows[r] = sum;
+        });
+    cout << "nested: " << (accumulate(rows.begin(), rows.end(), 0) == 64000) << endl;
+    return 0;
+}
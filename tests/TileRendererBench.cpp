@@ -0,0 +1,92 @@
+#include <GraceFt/TileRenderer.h>
+#include <GraceFt/ThreadPool.h>
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace GFt;
+using namespace std;
+using Clock = chrono::steady_clock;
+
+constexpr int width = 3840, height = 2160;
+constexpr float pi = 3.14159265f;
+
+struct Shape {
+    vector<fPoint> points;
+    Color color;
+};
+
+// 模拟仪表盘：大面积的半透明面板、进度条与大量小圆点
+vector<Shape> dashboard() {
+    vector<Shape> shapes;
+    mt19937 rng(7);
+    uniform_real_distribution<float> x(0, width), y(0, height), unit(0, 1);
+    auto rect = [](float l, float t, float w, float h) {
+        return vector<fPoint>{ fPoint(l, t), fPoint(l + w, t), fPoint(l + w, t + h), fPoint(l, t + h) };
+    };
+    for (int row = 0; row < 6; row++)
+        for (int col = 0; col < 8; col++)
+            shapes.push_back({ rect(col * 480.f + 10, row * 360.f + 10, 460, 340), Color(30, 40, 50, 220) });
+    for (int i = 0; i < 2000; i++)
+        shapes.push_back({ rect(x(rng), y(rng), 20 + unit(rng) * 200, 8.5f), Color(60, 160, 220, 180) });
+    for (int i = 0; i < 5000; i++) {
+        vector<fPoint> circle;
+        fPoint c(x(rng), y(rng));
+        float r = 3 + unit(rng) * 12;
+        for (int k = 0; k < 24; k++)
+            circle.push_back(c + fPoint(r * cos(2 * pi * k / 24), r * sin(2 * pi * k / 24)));
+        shapes.push_back({ circle, Color(240, 120, 40, 200) });
+    }
+    return shapes;
+}
+
+int main() {
+    auto shapes = dashboard();
+    vector<uint32_t> expected(size_t(width) * height, 0xffffffffu), pixels(expected.size());
+
+    Rasterizer r;
+    r.setTarget(expected.data(), width, height, width);
+    auto start = Clock::now();
+    for (auto& s : shapes) {
+        r.reset();
+        r.addPolygon(s.points.data(), s.points.size());
+        r.fill(s.color);
+    }
+    auto serial = chrono::duration<double, milli>(Clock::now() - start).count();
+    cout << width << "x" << height << ", " << shapes.size() << " fills" << endl;
+    cout << "  sequential: " << serial << " ms" << endl;
+
+    int failures = 0;
+    vector<size_t> counts{ 1, 2, 4 };
+    if (thread::hardware_concurrency() > 4)
+        counts.push_back(thread::hardware_concurrency());
+    for (auto threads : counts) {
+        ThreadPool pool(threads);
+        TileRenderer tiles;
+        tiles.setTarget(pixels.data(), width, height, width);
+        double best = 1e9;
+        for (int repeat = 0; repeat < 5; repeat++) {
+            fill(pixels.begin(), pixels.end(), 0xffffffffu);
+            auto begin = Clock::now();
+            for (auto& s : shapes)
+                tiles.addFill(s.points.data(), s.points.size(), iRect(0, 0, width, height), s.color);
+            tiles.flush(pool);
+            best = min(best, chrono::duration<double, milli>(Clock::now() - begin).count());
+        }
+        // 分块裁剪只改变计算的起点，允许浮点误差导致的 1 级差异
+        int maxDiff = 0;
+        for (size_t i = 0; i < pixels.size(); i++)
+            for (int shift = 0; shift < 32; shift += 8)
+                maxDiff = max(maxDiff, abs(int((pixels[i] >> shift) & 0xff) - int((expected[i] >> shift) & 0xff)));
+        failures += maxDiff > 1;
+        // 多个工作线程时应当分块并行绘制
+        failures += threads > 1 && tiles.lastTileCount() == 0;
+        cout << "  tiled, " << threads << " threads: " << best << " ms (" << tiles.lastTileCount() << " tiles, x"
+            << serial / best << "), max difference " << maxDiff << endl;
+    }
+    cout << (failures ? "failed" : "passed") << endl;
+    return failures ? 1 : 0;
+}
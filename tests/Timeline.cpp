@@ -0,0 +1,214 @@
+#include <GraceFt/Timeline.hpp>
+#include <GraceFt/Point.hpp>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cmath>
+#include <thread>
+#include <algorithm>
+
+using namespace GFt;
+using namespace std;
+using Clock = chrono::steady_clock;
+
+AnimationManager& manager() { return AnimationManager::getInstance(); }
+
+// 以 step 毫秒为间隔推进帧，直到动画停止，返回推进的帧数
+int runUntilStopped(AnimationAbstract& animation, TimePoint& now, int step = 5) {
+    int frames = 0;
+    while (animation.isPlaying() && frames < 100'000) {
+        now += chrono::milliseconds(step);
+        manager().updateAll(now);
+        frames++;
+    }
+    return frames;
+}
+
+void keyframes() {
+    float value = -1;
+    KeyframeAnimation<float> track([&](const float& v) { value = v; });
+    // 200ms 处的两个关键帧构成跳变
+    track.at(100, 10.f).at(0, 0.f).at(200, 10.f).at(200, 0.f).at(300, 5.f, TransFuncs::bezier);
+    manager().registerAnimation(&track);
+    cout << "keyframes: " << track.size() << ", duration " << track.getDuration() << " ms" << endl;
+    auto start = Clock::now();
+    track.setPlay();
+    cout << fixed << setprecision(2);
+    for (int ms : { 1, 50, 100, 150, 199, 201, 250, 299, 350 }) {
+        manager().updateAll(start + chrono::milliseconds(ms));
+        cout << "  t=" << ms << " value " << value << (track.isStopped() ? " (stopped)" : "") << endl;
+    }
+}
+
+// 持续时间不大于 0 的动画在首帧直接到达目标值
+bool zeroDuration() {
+    bool ok = true;
+    for (float duration : { 0.f, -10.f }) {
+        float value = -1;
+        Setter<float> setter = [&](const float& v) { value = v; };
+        Initial<float> initial = 0.f;
+        float target = 1.f;
+        Animation<float> animation({ setter, initial, target, duration, TransFuncs::linear });
+        manager().registerAnimation(&animation);
+        animation.setPlay();
+        manager().updateAll(Clock::now());
+        cout << "duration " << duration << " ms: value " << value
+            << (animation.isStopped() ? " (stopped)" : " (still playing)") << endl;
+        ok = ok && value == target && animation.isStopped();
+    }
+    return ok;
+}
+
+void spring() {
+    float value = 0;
+    Setter<float> setter = [&](const float& v) { value = v; };
+    Initial<float> initial = 0.f;
+    float target = 100.f;
+    SpringAnimation<float> spring({ setter, initial, target, 20.f });
+    manager().registerAnimation(&spring);
+    cout << "spring settle time: " << spring.getDuration() << " ms" << endl;
+    auto now = Clock::now();
+    spring.setPlay();
+    float previous = 0, max_jump = 0, peak = 0;
+    for (int frame = 0; frame < 20; frame++) {
+        now += chrono::milliseconds(5);
+        manager().updateAll(now);
+        max_jump = max(max_jump, abs(value - previous));
+        peak = max(peak, value);
+        previous = value;
+    }
+    cout << "  after 100ms: " << value << endl;
+    // 飞行中转向：位置与速度连续，不会从头开始
+    spring.setTarget(-50.f);
+    float overshoot = value;
+    int frames = 0;
+    while (spring.isPlaying()) {
+        now += chrono::milliseconds(5);
+        manager().updateAll(now);
+        max_jump = max(max_jump, abs(value - previous));
+        overshoot = max(overshoot, value);
+        previous = value;
+        frames++;
+    }
+    cout << "  retargeted to -50: settled at " << value << " after " << frames
+        << " frames, peak " << max(peak, overshoot) << ", largest step per frame " << max_jump << endl;
+
+    // 暂停后从暂停处继续
+    spring.setTarget(0.f);
+    now = Clock::now();
+    spring.setPlay();
+    for (int frame = 0; frame < 5; frame++)
+        manager().updateAll(now += chrono::milliseconds(5));
+    spring.setPause();
+    auto paused = value;
+    spring.setPlay();
+    manager().updateAll(Clock::now() + chrono::milliseconds(5));
+    cout << "  resume after pause continues from " << paused << " to " << value << endl;
+    spring.setStop();
+}
+
+void groups() {
+    float a = 0, b = 0, c = 0;
+    Setter<float> setA = [&](const float& v) { a = v; };
+    Setter<float> setB = [&](const float& v) { b = v; };
+    // 以 getter 作为初始值，在子动画实际开始时读取
+    Initial<float> fromA = Getter<float>([&] { return a; });
+    Initial<float> zero = 0.f;
+    float one = 1.f, duration = 100.f;
+    Animation<float> first({ setA, zero, one, duration });
+    Animation<float> second({ setB, fromA, one, duration });
+    KeyframeAnimation<float> third([&](const float& v) { c = v; });
+    third.at(0, 0.f).at(50, 2.f).at(100, 3.f);
+
+    AnimationGroup inner(AnimationGroup::Mode::Parallel);
+    inner.add(&second).add(&third, 20.f);
+    AnimationGroup sequence(AnimationGroup::Mode::Sequence);
+    sequence.add(&first).add(&inner, 50.f);
+    manager().registerAnimation(&sequence);
+    for (auto [name, animation] : { pair<const char*, AnimationAbstract*>
+        { "first", &first }, { "second", &second }, { "third", &third },
+        { "inner", &inner }, { "sequence", &sequence } })
+        animation->onFinished.connect([name] { cout << "  finished: " << name << endl; });
+    cout << "sequence duration " << sequence.getDuration() << " ms" << endl;
+
+    auto now = Clock::now();
+    sequence.setPlay();
+    for (int i = 0; i < 30; i++)
+        manager().updateAll(now += chrono::milliseconds(5));
+    // 暂停期间时间流逝不影响进度
+    sequence.setPause();
+    cout << "  paused at a=" << a << ", second " << (second.isPaused() ? "paused" : "not started") << endl;
+    sequence.setPlay();
+    now = Clock::now();
+    auto frames = runUntilStopped(sequence, now);
+    cout << "  a=" << a << " b=" << b << " c=" << c << " after " << frames << " more frames" << endl;
+
+    try {
+        AnimationGroup other;
+        other.add(&first);
+    }
+    catch (const invalid_argument& e) {
+        cout << "add to second group: " << e.what() << endl;
+    }
+}
+
+// 10k 条由三个动画组成的动画链：以 onFinished 信号逐个串联 vs 动画组
+void bench(bool grouped) {
+    constexpr int chains = 10'000;
+    vector<float> values(chains);
+    vector<unique_ptr<Animation<float>>> animations;
+    vector<unique_ptr<AnimationGroup>> sequences;
+    Initial<float> zero = 0.f;
+    float one = 1.f, duration = 100.f;
+    for (int i = 0; i < chains; i++) {
+        Setter<float> setter = [&values, i](const float& v) { values[i] = v; };
+        Animation<float>* links[3];
+        for (auto& link : links) {
+            animations.push_back(make_unique<Animation<float>>(AnimationParams<float>{
+                setter, zero, one, duration }));
+            link = animations.back().get();
+        }
+        if (grouped) {
+            sequences.push_back(make_unique<AnimationGroup>());
+            for (auto link : links)
+                sequences.back()->add(link);
+            manager().registerAnimation(sequences.back().get());
+            sequences.back()->setPlay();
+        }
+        else {
+            for (auto link : links)
+                manager().registerAnimation(link);
+            links[0]->onFinished.connect([next = links[1]] { next->setPlay(); });
+            links[1]->onFinished.connect([next = links[2]] { next->setPlay(); });
+            links[0]->setPlay();
+        }
+    }
+    // 以真实时间推进，使以 setPlay() 串联的动画与动画组使用相同的时间基准
+    int frames = 0;
+    double elapsed = 0;
+    while (any_of(animations.begin(), animations.end(), [](auto& a) { return a->isPlaying(); })) {
+        this_thread::sleep_for(chrono::milliseconds(5));
+        auto start = Clock::now();
+        manager().updateAll(start);
+        elapsed += chrono::duration<double, micro>(Clock::now() - start).count();
+        frames++;
+    }
+    int finished = 0;
+    for (auto v : values)
+        finished += v == 1.f;
+    cout << (grouped ? "AnimationGroup" : "onFinished chain") << " x" << chains << ": "
+        << frames << " frames, " << elapsed / frames << " us/frame, "
+        << finished << "/" << chains << " reached target" << endl;
+}
+
+int main() {
+    keyframes();
+    bool ok = zeroDuration();
+    spring();
+    groups();
+    bench(false);
+    bench(true);
+    return ok ? 0 : 1;
+}
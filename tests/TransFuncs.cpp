@@ -0,0 +1,53 @@
+#include <GraceFt/Animation.hpp>
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cmath>
+
+using namespace GFt;
+using namespace std;
+using Clock = chrono::steady_clock;
+
+constexpr size_t sample_count = 1'000'000;
+
+// 对比逐个调用与批量计算的耗时及最大误差
+void compare(const char* name, const TransFunc& func) {
+    vector<float> x(sample_count), scalar(sample_count), batched(sample_count);
+    for (size_t i = 0; i < sample_count; i++)
+        x[i] = static_cast<float>(i) / (sample_count - 1);
+
+    auto t0 = Clock::now();
+    for (size_t i = 0; i < sample_count; i++)
+        scalar[i] = func(x[i]);
+    auto t1 = Clock::now();
+    TransFuncs::batch(func, x.data(), batched.data(), sample_count);
+    auto t2 = Clock::now();
+
+    float error = 0.f;
+    for (size_t i = 0; i < sample_count; i++)
+        error = max(error, abs(scalar[i] - batched[i]));
+    cout << name << ": scalar " << chrono::duration<double, nano>(t1 - t0).count() / sample_count
+        << " ns, batch " << chrono::duration<double, nano>(t2 - t1).count() / sample_count
+        << " ns, max error " << error << endl;
+}
+
+int main() {
+    compare("linear", TransFuncs::linear);
+    compare("bezier", TransFuncs::bezier);
+    compare("smoothInOut", TransFuncs::smoothInOut);
+    compare("power(2.5)", TransFuncs::power(2.5f));
+    compare("power(0.5)", TransFuncs::power(0.5f));
+    compare("overDamped(5)", TransFuncs::overDamped(5.f));
+    compare("underDamped(20)", TransFuncs::underDamped(20.f));
+    compare("underDamped(100)", TransFuncs::underDamped(100.f));
+
+    // 查找表近似
+    auto custom = [](float x) { return sin(x * 3.1415926f / 2) * exp(1 - x) / exp(1.f) + x * x * 0.1f; };
+    for (float bound : { 1e-2f, 1e-4f, 1e-6f }) {
+        TransFuncs::LookupTable table(custom, bound);
+        cout << "lookup table bound " << bound << ": " << table.size()
+            << " intervals, measured error " << table.maxError() << endl;
+        compare("  table", table);
+    }
+    return 0;
+}